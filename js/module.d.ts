@@ -131,6 +131,22 @@ export declare const enum ESourceType {
     Transition = 2,
     Scene = 3
 }
+export declare const enum EIconType {
+    Unknown = 0,
+    Image = 1,
+    Color = 2,
+    Slideshow = 3,
+    AudioInput = 4,
+    AudioOutput = 5,
+    DesktopCapture = 6,
+    WindowCapture = 7,
+    GameCapture = 8,
+    Camera = 9,
+    Text = 10,
+    Media = 11,
+    Browser = 12,
+    Custom = 13
+}
 export declare const enum EEncoderType {
     Audio = 0,
     Video = 1
@@ -247,8 +263,14 @@ export declare const enum ERenderingMode {
 	OBS_STREAMING_RENDERING = 1,
 	OBS_RECORDING_RENDERING = 2
 }
+export declare const enum ETransitionReadiness {
+    Ready = 1,
+    TimedOut = 2,
+    Cancelled = 3
+}
 export declare const Global: IGlobal;
 export declare const Video: IVideo;
+export declare const Collection: ICollection;
 export declare const OutputFactory: IOutputFactory;
 export declare const AudioEncoderFactory: IAudioEncoderFactory;
 export declare const VideoEncoderFactory: IVideoEncoderFactory;
@@ -270,6 +292,12 @@ export interface IVec2 {
     readonly x: number;
     readonly y: number;
 }
+export interface IRect {
+    readonly x: number;
+    readonly y: number;
+    readonly width: number;
+    readonly height: number;
+}
 export interface ITimeSpec {
     readonly sec: number;
     readonly nsec: number;
@@ -282,6 +310,23 @@ export interface ITransformInfo {
     readonly boundsType: EBoundsType;
     readonly boundsAlignment: number;
     readonly bounds: IVec2;
+    readonly crop: ICropInfo;
+    readonly scaleFilter: EScaleType;
+}
+export interface ISceneItemTransform {
+    position?: IVec2;
+    rotation?: number;
+    scale?: IVec2;
+    alignment?: EAlignment;
+    bounds?: IVec2;
+    boundsType?: EBoundsType;
+    boundsAlignment?: number;
+    crop?: ICropInfo;
+    scaleFilter?: EScaleType;
+}
+export interface ISceneItemEdit extends ISceneItemTransform {
+    visible?: boolean;
+    order?: number;
 }
 export interface ICropInfo {
     readonly left: number;
@@ -346,9 +391,19 @@ export interface IFontProperty extends IProperty {
 }
 export interface IListProperty extends IProperty {
     readonly details: IListDetails;
+    listItems(offset: number, count: number, filter?: string): IListItemPage;
+}
+export interface IListItemPage {
+    readonly total: number;
+    readonly items: {
+        name: string;
+        value: string | number;
+        enabled: boolean;
+    }[];
 }
 export interface IListDetails {
     readonly format: EListFormat;
+    readonly itemCount: number;
     readonly items: {
         name: string;
         value: string | number;
@@ -395,7 +450,7 @@ export interface IProperty {
     readonly type: EPropertyType;
     readonly value: any;
     next(): IProperty;
-    modified(): boolean;
+    modified(settings: ISettings): boolean;
 }
 export interface IProperties {
     readonly status: number;
@@ -405,6 +460,13 @@ export interface IProperties {
 }
 export interface IFactoryTypes {
     types(): string[];
+    typeCatalog(): ISourceTypeInfo[];
+}
+export interface ISourceTypeInfo {
+    readonly id: string;
+    readonly name: string;
+    readonly outputFlags: ESourceOutputFlags;
+    readonly iconType: EIconType;
 }
 export interface IReleasable {
     release(): void;
@@ -496,6 +558,30 @@ export interface IInputFactory extends IFactoryTypes {
     createPrivate(id: string, name: string, settings?: ISettings): IInput;
     fromName(name: string): IInput;
     getPublicSources(): IInput[];
+    createBulk(definitions: IInputDefinition[]): IInputImportResult[];
+}
+export interface IFilterDefinition {
+    id: string;
+    name: string;
+    settings?: ISettings;
+    enabled?: boolean;
+}
+export interface IInputPlacement extends ISceneItemTransform {
+    scene: IScene;
+    visible?: boolean;
+}
+export interface IInputDefinition {
+    id: string;
+    name: string;
+    settings?: ISettings;
+    hotkeys?: ISettings;
+    filters?: IFilterDefinition[];
+    placements?: IInputPlacement[];
+}
+export interface IInputImportResult {
+    input: IInput;
+    filters: IFilter[];
+    items: ISceneItem[];
 }
 export const enum EInteractionFlags {
     None         = 0,
@@ -529,6 +615,10 @@ export interface IKeyEvent {
     nativeScancode: number;
     nativeVkey: number;
 }
+export interface IFilterChainEntry {
+    filter: IFilter;
+    enabled?: boolean;
+}
 export interface IInput extends ISource {
     volume: number;
     syncOffset: ITimeSpec;
@@ -548,6 +638,7 @@ export interface IInput extends ISource {
     sendKeyClick(eventData: IKeyEvent, keyUp: boolean): void;
     setFilterOrder(filter: IFilter, movement: EOrderMovement): void;
     setFilterOrder(filter: IFilter, movement: EOrderMovement): void;
+    setFilterChain(chain: IFilterChainEntry[]): IFilter[];
     readonly filters: IFilter[];
     readonly width: number;
     readonly height: number;
@@ -559,6 +650,7 @@ export interface ISceneFactory {
 }
 export interface IScene extends ISource {
     duplicate(name: string, type: ESceneDupType): IScene;
+    readonly duplicationTime: number;
     add(source: IInput): ISceneItem;
     readonly source: IInput;
     moveItem(oldIndex: number, newIndex: number): void;
@@ -566,6 +658,13 @@ export interface IScene extends ISource {
     findItem(id: string | number): ISceneItem;
     getItemAtIdx(idx: number): ISceneItem;
     getItems(): ISceneItem[];
+    getItemIds(): Float64Array;
+    beginEdit(): void;
+    editItem(item: ISceneItem, edit: ISceneItemEdit): void;
+    commitEdit(): void;
+    hitTest(x: number, y: number): ISceneItem;
+    selectItems(rect: IRect): ISceneItem[];
+    snap(rect: IRect, threshold: number, exclude?: ISceneItem): IVec2;
     connect(sigType: ESceneSignalType, cb: (info: ISettings) => void): ICallbackData;
     disconnect(data: ICallbackData): void;
 }
@@ -595,6 +694,7 @@ export interface ISceneItem {
     remove(): void;
     deferUpdateBegin(): void;
     deferUpdateEnd(): void;
+    setTransform(transform: ISceneItemTransform): void;
 }
 export interface ITransitionFactory extends IFactoryTypes {
     create(id: string, name: string, settings?: ISettings, hotkeys?: ISettings): ITransition;
@@ -606,6 +706,12 @@ export interface ITransition extends ISource {
     clear(): void;
     set(input: ISource): void;
     start(ms: number, input: ISource): void;
+    prepare(input: ISource, timeoutMs: number, callback: (readiness: ITransitionReadiness) => void): void;
+}
+export interface ITransitionReadiness {
+    state: ETransitionReadiness;
+    ready: number;
+    total: number;
 }
 export interface IConfigurable {
     update(settings: ISettings): void;
@@ -615,6 +721,8 @@ export interface IConfigurable {
 }
 export interface ISource extends IConfigurable, IReleasable {
     remove(): void;
+    openPropertySession(maxInlineListItems?: number): void;
+    closePropertySession(): void;
     save(): void;
     readonly status: number;
     readonly type: ESourceType;
@@ -674,6 +782,44 @@ export interface IDisplay {
 export interface IVideo {
     readonly skippedFrames: number;
     readonly encodedFrames: number;	
+    readonly frameStats: IFrameStats;
+    getRenderTiming(reset?: boolean): IRenderTiming;
+    getRenderTimingWindow(seconds: number): IRenderTiming;
+}
+export interface IFrameStats {
+    readonly renderedFrames: number;
+    readonly laggedFrames: number;
+    readonly encodedFrames: number;
+    readonly skippedFrames: number;
+    readonly outputFrames: number;
+    readonly outputDroppedFrames: number;
+    readonly outputCongestion: number;
+    readonly activeFps: number;
+    readonly averageFrameTime: number;
+}
+export interface IRenderTiming {
+    readonly frames: number;
+    readonly overBudgetFrames: number;
+    readonly overTwiceBudgetFrames: number;
+    readonly budget: number;
+    readonly mean: number;
+    readonly p50: number;
+    readonly p95: number;
+    readonly p99: number;
+    readonly max: number;
+    readonly duration: number;
+}
+export interface ICollectionContent {
+    inputs: IInput[];
+    scenes: IScene[];
+    transitions: ITransition[];
+}
+export interface ICollection {
+    load(path: string): ICollectionContent;
+    save(path: string): void;
+    flush(): void;
+    setSnapshot(path: string, intervalMs: number): void;
+    restoreSnapshot(path: string): ICollectionContent;
 }
 
 export interface IAudio {
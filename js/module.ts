@@ -198,6 +198,26 @@ export const enum ESourceType {
     Scene,
 }
 
+/**
+ * Describes the icon a source type suggests for itself
+ */
+export const enum EIconType {
+    Unknown,
+    Image,
+    Color,
+    Slideshow,
+    AudioInput,
+    AudioOutput,
+    DesktopCapture,
+    WindowCapture,
+    GameCapture,
+    Camera,
+    Text,
+    Media,
+    Browser,
+    Custom,
+}
+
 /**
  * Describes the type of encoder
  */
@@ -336,8 +356,15 @@ export const enum ERenderingMode {
 	OBS_RECORDING_RENDERING = 2
 }
 
+export const enum ETransitionReadiness {
+    Ready = 1,
+    TimedOut = 2,
+    Cancelled = 3
+}
+
 export const Global: IGlobal = obs.Global;
 export const Video: IVideo = obs.Video;
+export const Collection: ICollection = obs.Collection;
 export const OutputFactory: IOutputFactory = obs.Output;
 export const AudioEncoderFactory: IAudioEncoderFactory = obs.AudioEncoder;
 export const VideoEncoderFactory: IVideoEncoderFactory = obs.VideoEncoder;
@@ -368,6 +395,16 @@ export interface IVec2 {
     readonly y: number;
 }
 
+/**
+ * Axis aligned rectangle in canvas coordinates
+ */
+export interface IRect {
+    readonly x: number;
+    readonly y: number;
+    readonly width: number;
+    readonly height: number;
+}
+
 /**
  * Used to represented a time in nanoseconds
  * JS can't hold 64-bit integers thus can
@@ -389,6 +426,34 @@ export interface ITransformInfo {
     readonly boundsType: EBoundsType;
     readonly boundsAlignment: number;
     readonly bounds: IVec2;
+    readonly crop: ICropInfo;
+    readonly scaleFilter: EScaleType;
+}
+
+/**
+ * Partial transform applied to an item in a single update.
+ * Only the fields present are changed.
+ */
+export interface ISceneItemTransform {
+    position?: IVec2;
+    rotation?: number;
+    scale?: IVec2;
+    alignment?: EAlignment;
+    bounds?: IVec2;
+    boundsType?: EBoundsType;
+    boundsAlignment?: number;
+    crop?: ICropInfo;
+    scaleFilter?: EScaleType;
+}
+
+/**
+ * Change queued for an item with {@link IScene.editItem}
+ */
+export interface ISceneItemEdit extends ISceneItemTransform {
+    visible?: boolean;
+
+    /** Position relative to the bottom-most item */
+    order?: number;
 }
 
 /**
@@ -571,11 +636,32 @@ export interface IFontProperty extends IProperty {
 
 export interface IListProperty extends IProperty {
     readonly details: IListDetails;
+
+    /**
+     * Fetches a page of the list's items without loading the rest.
+     * Long lists read through a property session are sent without their
+     * items, so paging through them is cheaper than reading
+     * {@link IListDetails#items}. Throws once the session is closed.
+     * @param offset - Index of the first matching item to return
+     * @param count - Maximum number of items to return
+     * @param filter - Case-insensitive substring the item names must contain
+     */
+    listItems(offset: number, count: number, filter?: string): IListItemPage;
+}
+
+export interface IListItemPage {
+    /** Number of items matching the filter, in total */
+    readonly total: number;
+
+    readonly items: { name: string, value: string | number, enabled: boolean }[];
 }
 
 export interface IListDetails {
     readonly format: EListFormat;
 
+    /** Number of items in the list, known even before they are loaded */
+    readonly itemCount: number;
+
     /**
      * A list of options to be made available within the list.
      * You can determine if it's a string or number by testing
@@ -668,7 +754,16 @@ export interface IProperty {
      * Otherwise or if end of the list, returns false. 
      */
     next(): IProperty;
-    modified(): boolean;
+
+    /**
+     * Notifies the source that this property was edited. The first call
+     * opens a property session for the source, after which only the
+     * properties that changed are fetched again.
+     *
+     * @param settings The settings the property was edited against
+     * @returns Whether the properties list should be refreshed
+     */
+    modified(settings: ISettings): boolean;
 }
 
 /**
@@ -697,6 +792,19 @@ export interface IProperties {
 
 export interface IFactoryTypes {
     types(): string[];
+
+    /**
+     * Registered types with their display names, output flags and icons.
+     * Fetched once per session and only again after a module is initialized.
+     */
+    typeCatalog(): ISourceTypeInfo[];
+}
+
+export interface ISourceTypeInfo {
+    readonly id: string;
+    readonly name: string;
+    readonly outputFlags: ESourceOutputFlags;
+    readonly iconType: EIconType;
 }
 
 export interface IReleasable {
@@ -925,6 +1033,54 @@ export interface IInputFactory extends IFactoryTypes {
      * Fetches a list of all public input sources available.
      */
     getPublicSources(): IInput[];
+
+    /**
+     * Create many inputs in a single call, along with their filters and
+     * scene items. Settings are parsed on the server in parallel.
+     * @param definitions - Inputs to create
+     * @returns - One result per definition, in the same order
+     */
+    createBulk(definitions: IInputDefinition[]): IInputImportResult[];
+}
+
+/**
+ * Filter created and attached by {@link IInputFactory.createBulk}
+ */
+export interface IFilterDefinition {
+    id: string;
+    name: string;
+    settings?: ISettings;
+    enabled?: boolean;
+}
+
+/**
+ * Scene item created by {@link IInputFactory.createBulk}
+ */
+export interface IInputPlacement extends ISceneItemTransform {
+    scene: IScene;
+    visible?: boolean;
+}
+
+/**
+ * Input created by {@link IInputFactory.createBulk}
+ */
+export interface IInputDefinition {
+    id: string;
+    name: string;
+    settings?: ISettings;
+    hotkeys?: ISettings;
+    filters?: IFilterDefinition[];
+    placements?: IInputPlacement[];
+}
+
+/**
+ * Objects created for one {@link IInputDefinition}. `input` is null if the
+ * input could not be created, failed filters and items are null as well.
+ */
+export interface IInputImportResult {
+    input: IInput;
+    filters: IFilter[];
+    items: ISceneItem[];
 }
 
 
@@ -975,6 +1131,12 @@ export interface ISceneItemInfo {
     rotation: number
 }
 
+export interface IFilterChainEntry {
+    filter: IFilter;
+    /** Defaults to true */
+    enabled?: boolean;
+}
+
 /**
  * Class representing a source
  * 
@@ -1039,6 +1201,14 @@ export interface IInput extends ISource {
      */
     setFilterOrder(filter: IFilter, movement: EOrderMovement): void;
 
+    /**
+     * Replace the whole filter chain of this input in one call. Filters not
+     * listed are detached, listed ones are attached, ordered and enabled or
+     * disabled as given.
+     * @param chain - The complete chain, from top to bottom.
+     * @returns The resulting filter order.
+     */
+    setFilterChain(chain: IFilterChainEntry[]): IFilter[];
 
     /**
      * Obtain a list of all filters associated with the input source
@@ -1090,6 +1260,12 @@ export interface IScene extends ISource {
      */
     duplicate(name: string, type: ESceneDupType): IScene;
 
+    /**
+     * Time in milliseconds the server spent creating this scene with
+     * {@link IScene#duplicate}, 0 for scenes created otherwise
+     */
+    readonly duplicationTime: number;
+
     /**
      * Add an input source to the scene, creating a scene item.
      * @param source - Input source to add to the scene
@@ -1142,6 +1318,59 @@ export interface IScene extends ISource {
      */
     getItems(): ISceneItem[];
 
+    /**
+     * Fetch the ids of all items within the scene without creating
+     * an object per item. The list is only sent again by the server
+     * when items were added, removed or reordered.
+     * @returns - The item ids, in scene order
+     */
+    getItemIds(): Float64Array;
+
+    /**
+     * Start queuing item changes, nothing is sent to the
+     * server until {@link commitEdit} is called
+     */
+    beginEdit(): void;
+
+    /**
+     * Queue a change for an item of this scene
+     * @param item - Item to change
+     * @param edit - Transform, visibility and order changes to apply
+     */
+    editItem(item: ISceneItem, edit: ISceneItemEdit): void;
+
+    /**
+     * Apply every queued change in a single scene update
+     */
+    commitEdit(): void;
+
+    /**
+     * Find the topmost visible item under a point of the canvas.
+     * Item bounds are indexed on the server, the cost does not grow
+     * with the number of items in the scene.
+     * @param x - Horizontal canvas position
+     * @param y - Vertical canvas position
+     * @returns - The item or undefined if there is none
+     */
+    hitTest(x: number, y: number): ISceneItem;
+
+    /**
+     * Fetch the visible items overlapping a rectangle of the canvas
+     * @param rect - Selection rectangle
+     * @returns - The items, from bottom to top
+     */
+    selectItems(rect: IRect): ISceneItem[];
+
+    /**
+     * Compute the offset aligning a rectangle with the closest item
+     * or canvas edge, each axis being snapped independently
+     * @param rect - Rectangle being moved, usually the box of the dragged item
+     * @param threshold - Maximum snapping distance
+     * @param exclude - Item whose edges are ignored, usually the dragged item
+     * @returns - Offset to add to the position, 0 on axes that did not snap
+     */
+    snap(rect: IRect, threshold: number, exclude?: ISceneItem): IVec2;
+
     /**
      * Connect a callback to a particular signal 
      * associated with this scene. 
@@ -1244,6 +1473,13 @@ export interface ISceneItem {
 
     /** Allow updating of the item after calling {@link deferUpdateBegin} */
     deferUpdateEnd(): void;
+
+    /**
+     * Apply several transform fields at once, the output never
+     * renders a partially applied transform.
+     * @param transform Fields to change, absent fields are left as is
+     */
+    setTransform(transform: ISceneItemTransform): void;
 }
 
 export interface ITransitionFactory extends IFactoryTypes {
@@ -1301,6 +1537,34 @@ export interface ITransition extends ISource {
      * @param input - Source to transition to
      */
     start(ms: number, input: ISource): void;
+
+    /**
+     * Shows the sources of a scene in the background so they have their
+     * first frame ready when {@link start} switches to it. The callback
+     * fires once, through the global callback poll, when every video source
+     * rendered, the timeout expired, or another scene was prepared or the
+     * transition started before that.
+     * A prepared scene that is not started within 10 seconds after that is
+     * hidden again.
+     * @param input - Source that will be transitioned to
+     * @param timeoutMs - How long to wait for the sources at most
+     * @param callback - Receives the outcome of the preparation
+     */
+    prepare(input: ISource, timeoutMs: number, callback: (readiness: ITransitionReadiness) => void): void;
+}
+
+export interface ITransitionReadiness {
+    state: ETransitionReadiness;
+
+    /**
+     * Video sources of the prepared scene that had a frame ready
+     */
+    ready: number;
+
+    /**
+     * Video sources of the prepared scene
+     */
+    total: number;
 }
 
 export interface IConfigurable { 
@@ -1336,6 +1600,20 @@ export interface ISource extends IConfigurable, IReleasable {
      */
     remove(): void;
 
+    /**
+     * Open a property session, later reads of `properties` only fetch what
+     * changed. Lists longer than `maxInlineListItems` (default 32) leave their
+     * items on the server, page through them with `IListProperty.listItems`.
+     * The session is closed by `closePropertySession` or when the source is
+     * released.
+     */
+    openPropertySession(maxInlineListItems?: number): void;
+
+    /**
+     * Close the property session opened by `openPropertySession`.
+     */
+    closePropertySession(): void;
+
     /**
      * Send a save signal to sources themselves. 
      * This should always be called before saving to disk 
@@ -1548,6 +1826,164 @@ export interface IVideo {
      * Number of total encoded frames
      */
     readonly encodedFrames: number;
+
+    /**
+     * Video and output counters, read from memory the server shares with
+     * this process instead of over IPC. Refreshed about once per frame.
+     * Undefined if the server does not publish them.
+     */
+    readonly frameStats: IFrameStats;
+
+    /**
+     * Render time distribution of the frames since the previous reset,
+     * or since startup.
+     * @param reset - Start a new period once this one is returned
+     */
+    getRenderTiming(reset?: boolean): IRenderTiming;
+
+    /**
+     * Render time distribution of the frames of the last seconds, up to
+     * five minutes. Does not touch the period {@link getRenderTiming} resets.
+     * @param seconds - Length of the window
+     */
+    getRenderTimingWindow(seconds: number): IRenderTiming;
+}
+
+export interface IFrameStats {
+    /**
+     * Frames rendered since startup
+     */
+    readonly renderedFrames: number;
+
+    /**
+     * Rendered frames that missed their deadline
+     */
+    readonly laggedFrames: number;
+
+    /**
+     * Frames handed to the video output
+     */
+    readonly encodedFrames: number;
+
+    /**
+     * Frames the video output skipped
+     */
+    readonly skippedFrames: number;
+
+    /**
+     * Frames of the streaming output, 0 while not streaming
+     */
+    readonly outputFrames: number;
+
+    /**
+     * Frames the streaming output dropped
+     */
+    readonly outputDroppedFrames: number;
+
+    /**
+     * Congestion of the streaming output, from 0 to 1
+     */
+    readonly outputCongestion: number;
+
+    /**
+     * Current render frame rate
+     */
+    readonly activeFps: number;
+
+    /**
+     * Average render time of a frame in milliseconds
+     */
+    readonly averageFrameTime: number;
+}
+
+/**
+ * Time the graphics thread spent on each frame. Times are in milliseconds,
+ * percentiles are accurate to about 3%.
+ */
+export interface IRenderTiming {
+    /**
+     * Frames measured
+     */
+    readonly frames: number;
+
+    /**
+     * Frames that took longer than the frame interval
+     */
+    readonly overBudgetFrames: number;
+
+    /**
+     * Frames that took longer than twice the frame interval
+     */
+    readonly overTwiceBudgetFrames: number;
+
+    /**
+     * Current frame interval
+     */
+    readonly budget: number;
+
+    readonly mean: number;
+    readonly p50: number;
+    readonly p95: number;
+    readonly p99: number;
+    readonly max: number;
+
+    /**
+     * Time covered by the measurement
+     */
+    readonly duration: number;
+}
+
+/**
+ * Sources created by {@link ICollection.load} or {@link ICollection.restoreSnapshot}
+ */
+export interface ICollectionContent {
+    inputs: IInput[];
+    scenes: IScene[];
+    transitions: ITransition[];
+}
+
+/**
+ * Server side loading and saving of whole scene collections
+ */
+export interface ICollection {
+    /**
+     * Load a collection file written by {@link save}. Sources are created
+     * in parallel where their type allows it, scene items are resolved
+     * once every source exists. Existing sources are left untouched.
+     * @param path - Path of the collection file
+     * @returns - The created sources, each holding a reference to release
+     */
+    load(path: string): ICollectionContent;
+
+    /**
+     * Save all inputs and scenes to a file. Returns immediately, the file
+     * is written in the background and atomically replaced.
+     * @param path - Path of the collection file
+     */
+    save(path: string): void;
+
+    /**
+     * Wait for a pending save to be written. Throws if a save failed.
+     */
+    flush(): void;
+
+    /**
+     * Write a binary snapshot of all sources right away, then after changes
+     * at most once per interval, and once more when the server shuts down
+     * cleanly. An empty path disables snapshots.
+     * @param path - Path of the snapshot file
+     * @param intervalMs - Time between two snapshots in milliseconds
+     */
+    setSnapshot(path: string, intervalMs: number): void;
+
+    /**
+     * Recreate the sources of a snapshot written by {@link setSnapshot},
+     * typically after the server was restarted. Much faster than
+     * {@link load} as no JSON has to be parsed.
+     * @param path - Path of the snapshot file
+     * @returns - The created sources, each holding a reference to release
+     */
+    restoreSnapshot(path: string): ICollectionContent;
 }
 
 /**
@@ -0,0 +1,91 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "callback-manager.hpp"
+#include "volmeter.hpp"
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <memory>
+
+// Built into the addon only with OSN_CLIENT_BENCHMARKS, for test builds.
+
+Napi::Value globalCallback::BenchmarkPayloads(const Napi::CallbackInfo& info)
+{
+	Napi::Env env        = info.Env();
+	uint32_t  iterations = 10000;
+	if (info.Length() > 0 && info[0].IsNumber())
+		iterations = std::max(info[0].ToNumber().Uint32Value(), uint32_t(1));
+
+	// A scene collection of average size and a stereo source.
+	SourceSizeInfoData                           sources;
+	std::vector<std::unique_ptr<SourceSizeInfo>> storage;
+	for (uint32_t i = 0; i < 32; i++) {
+		storage.emplace_back(new SourceSizeInfo{"Source " + std::to_string(i), 1920, 1080, 0x1});
+		sources.items.push_back(storage.back().get());
+	}
+	VolmeterData volmeter{{-20.f, -21.f}, {-12.f, -13.f}, {-11.f, -12.f}};
+
+	auto measure = [&](size_t objects_per_iteration, const std::function<void()>& convert) {
+		auto start = std::chrono::high_resolution_clock::now();
+		for (uint32_t i = 0; i < iterations; i++) {
+			Napi::HandleScope scope(env);
+			convert();
+		}
+		std::chrono::duration<double> elapsed = std::chrono::high_resolution_clock::now() - start;
+		return double(objects_per_iteration) * iterations / std::max(elapsed.count(), 1e-9);
+	};
+
+	// Each sources payload is the array plus one object per source, each
+	// volmeter payload three arrays.
+	double sources_shaped = measure(sources.items.size() + 1, [&]() { SourceSizesToValue(env, sources); });
+	double sources_plain  = measure(sources.items.size() + 1, [&]() {
+		Napi::Array result = Napi::Array::New(env);
+		for (size_t i = 0; i < sources.items.size(); i++) {
+			Napi::Object obj = Napi::Object::New(env);
+			obj.Set("name", Napi::String::New(env, sources.items[i]->name));
+			obj.Set("width", Napi::Number::New(env, sources.items[i]->width));
+			obj.Set("height", Napi::Number::New(env, sources.items[i]->height));
+			obj.Set("flags", Napi::Number::New(env, sources.items[i]->flags));
+			result.Set(uint32_t(i), obj);
+		}
+	});
+	double volmeter_shaped = measure(3, [&]() {
+		LevelsToValue(env, volmeter.magnitude);
+		LevelsToValue(env, volmeter.peak);
+		LevelsToValue(env, volmeter.input_peak);
+	});
+	double volmeter_plain = measure(3, [&]() {
+		for (const std::vector<float>* levels : {&volmeter.magnitude, &volmeter.peak, &volmeter.input_peak}) {
+			Napi::Array result = Napi::Array::New(env);
+			for (size_t i = 0; i < levels->size(); i++)
+				result.Set(uint32_t(i), Napi::Number::New(env, (*levels)[i]));
+		}
+	});
+
+	Napi::Object result = Napi::Object::New(env);
+	Napi::Object sources_result = Napi::Object::New(env);
+	sources_result.Set("current", Napi::Number::New(env, sources_shaped));
+	sources_result.Set("baseline", Napi::Number::New(env, sources_plain));
+	result.Set("sources", sources_result);
+	Napi::Object volmeter_result = Napi::Object::New(env);
+	volmeter_result.Set("current", Napi::Number::New(env, volmeter_shaped));
+	volmeter_result.Set("baseline", Napi::Number::New(env, volmeter_plain));
+	result.Set("volmeter", volmeter_result);
+	return result;
+}
@@ -24,7 +24,11 @@ struct SceneInfo
 	uint64_t                                  id;
 	std::vector<std::pair<int64_t, uint64_t>> items;
 	bool                                      itemsOrderCached = false;
+	// Server revision of `items`, see Scene.GetItems.
+	uint64_t                                  itemsRevision = UINT64_MAX;
 	std::string                               name;
+	// Milliseconds the server took to create the scene with Scene.Duplicate.
+	double                                    duplicationTime = 0;
 };
 
 struct SourceDataInfo
@@ -39,8 +43,12 @@ struct SourceDataInfo
 	std::string setting         = "";
 	bool        settingsChanged = true;
 
-	osn::property_map_t properties;
+	osn::property_set_t properties;
 	bool                propertiesChanged = true;
+	// Server property session, 0 while none is open. Lists longer than
+	// maxInlineListItems are sent without their items in a session.
+	uint64_t            propertySession    = 0;
+	uint32_t            maxInlineListItems = 32;
 
 	uint32_t audioMixers        = UINT32_MAX;
 	bool     audioMixersChanged = true;
@@ -19,6 +19,7 @@
 #include "callback-manager.hpp"
 #include "controller.hpp"
 #include "error.hpp"
+#include "object-shapes.hpp"
 #include "utility-v8.hpp"
 
 #include <node.h>
@@ -36,6 +37,16 @@ Napi::ThreadSafeFunction globalCallback::js_thread;
 bool globalCallback::m_all_workers_stop = false;
 std::mutex globalCallback::mtx_volmeters;
 std::map<uint64_t, Napi::ThreadSafeFunction> globalCallback::volmeters;
+std::mutex globalCallback::mtx_media;
+std::map<uint64_t, MediaClockSample> globalCallback::media_clocks;
+std::mutex globalCallback::mtx_transitions;
+std::map<std::pair<uint64_t, uint64_t>, Napi::ThreadSafeFunction> globalCallback::transition_callbacks;
+
+// OBS_MEDIA_STATE_PLAYING
+static const int32_t media_state_playing = 1;
+
+static const utilv8::ObjectShape source_size_shape({"name", "width", "height", "flags"});
+static const utilv8::ObjectShape readiness_shape({"state", "ready", "total"});
 
 void globalCallback::Init(Napi::Env env, Napi::Object exports)
 {
@@ -45,6 +56,37 @@ void globalCallback::Init(Napi::Env env, Napi::Object exports)
 	exports.Set(
 		Napi::String::New(env, "RemoveSourceCallback"),
 		Napi::Function::New(env, globalCallback::RemoveGlobalCallback));
+#ifdef OSN_CLIENT_BENCHMARKS
+	exports.Set(
+		Napi::String::New(env, "BenchmarkCallbackPayloads"),
+		Napi::Function::New(env, globalCallback::BenchmarkPayloads));
+#endif
+}
+
+Napi::Array globalCallback::SourceSizesToValue(Napi::Env env, const SourceSizeInfoData& data)
+{
+	Napi::Array result = Napi::Array::New(env, data.items.size());
+
+	for (size_t i = 0; i < data.items.size(); i++) {
+		const SourceSizeInfo* item = data.items[i];
+		result.Set(
+		    uint32_t(i),
+		    source_size_shape.New(
+		        env,
+		        {Napi::String::New(env, item->name),
+		         Napi::Number::New(env, item->width),
+		         Napi::Number::New(env, item->height),
+		         Napi::Number::New(env, item->flags)}));
+	}
+	return result;
+}
+
+Napi::Array globalCallback::LevelsToValue(Napi::Env env, const std::vector<float>& levels)
+{
+	Napi::Array result = Napi::Array::New(env, levels.size());
+	for (size_t i = 0; i < levels.size(); i++)
+		result.Set(uint32_t(i), Napi::Number::New(env, levels[i]));
+	return result;
 }
 
 Napi::Value globalCallback::RegisterGlobalCallback(const Napi::CallbackInfo& info)
@@ -55,6 +97,8 @@ Napi::Value globalCallback::RegisterGlobalCallback(const Napi::CallbackInfo& inf
 	isWorkerRunning = true;
 	worker_stop = false;
 
+	// Subscribe before polling so no event raised in between is missed.
+	Controller::GetInstance().GetEventSubscriber();
 	worker_thread = new std::thread(&globalCallback::worker);
 
 	return Napi::Boolean::New(info.Env(), true);
@@ -92,6 +136,18 @@ void globalCallback::stop_worker(void)
 		worker_thread->join();
 	}
 	js_thread.Release();
+
+	// Clocks are only kept current while the worker polls.
+	{
+		std::unique_lock<std::mutex> ulock(mtx_media);
+		media_clocks.clear();
+	}
+
+	// Nothing delivers readiness any more, let go of the callbacks.
+	std::unique_lock<std::mutex> ulock(mtx_transitions);
+	for (auto& callback : transition_callbacks)
+		callback.second.Release();
+	transition_callbacks.clear();
 }
 
 void globalCallback::worker()
@@ -99,37 +155,14 @@ void globalCallback::worker()
 	auto sources_callback = []( Napi::Env env, 
 			Napi::Function jsCallback,
 			SourceSizeInfoData* data ) {
-		Napi::Array result = Napi::Array::New(env, data->items.size());
-
-		for (size_t i = 0; i < data->items.size(); i++) {
-			Napi::Object obj = Napi::Object::New(env);
-			obj.Set("name", Napi::String::New(env, data->items[i]->name));
-			obj.Set("width", Napi::Number::New(env, data->items[i]->width));
-			obj.Set("height", Napi::Number::New(env, data->items[i]->height));
-			obj.Set("flags", Napi::Number::New(env, data->items[i]->flags));
-			result.Set(i, obj);
-		}
-		jsCallback.Call({ result });
+		jsCallback.Call({ SourceSizesToValue(env, *data) });
 		delete data;
 	};
 
 	auto volmeter_callback = []( Napi::Env env, Napi::Function jsCallback, VolmeterData* data ) {
-		Napi::Array magnitude = Napi::Array::New(env);
-		Napi::Array peak = Napi::Array::New(env);
-		Napi::Array input_peak = Napi::Array::New(env);
-
-		for (size_t i = 0; i < data->magnitude.size(); i++) {
-			magnitude.Set(i, Napi::Number::New(env, data->magnitude[i]));
-		}
-		for (size_t i = 0; i < data->peak.size(); i++) {
-			peak.Set(i, Napi::Number::New(env, data->peak[i]));
-		}
-		for (size_t i = 0; i < data->input_peak.size(); i++) {
-			input_peak.Set(i, Napi::Number::New(env, data->input_peak[i]));
-		}
-
 		if (data->magnitude.size() > 0 && data->peak.size() > 0 && data->input_peak.size() > 0) {
-			jsCallback.Call({ magnitude, peak, input_peak });
+			jsCallback.Call(
+			    {LevelsToValue(env, data->magnitude), LevelsToValue(env, data->peak), LevelsToValue(env, data->input_peak)});
 		}
 		delete data;
 	};
@@ -139,7 +172,7 @@ void globalCallback::worker()
 	while (!worker_stop && !m_all_workers_stop) {
 		auto tp_start = std::chrono::high_resolution_clock::now();
 
-		auto conn = Controller::GetInstance().GetConnection();
+		auto conn = Controller::GetInstance().GetQueryConnection();
 		if (!conn)
 			return;
 
@@ -158,6 +191,7 @@ void globalCallback::worker()
 			std::vector<ipc::value> response =
 				conn->call_synchronous_helper("CallbackManager", "GlobalQuery",
 				{
+					ipc::value(Controller::GetInstance().GetEventSubscriber()),
 					ipc::value((uint64_t)volmeters_ids.size()),
 					ipc::value(volmeters_ids)
 				});
@@ -212,6 +246,20 @@ void globalCallback::worker()
 				}
 			}
 
+			const ipc::value& media = response.back();
+			if (media.type == ipc::type::Binary) {
+				std::vector<obs::MediaClock> clocks;
+				if (obs::read_list(media.value_bin, clocks) && !clocks.empty())
+					update_media(clocks);
+			}
+
+			const ipc::value& readiness = response[response.size() - 2];
+			if (media.type == ipc::type::Binary && readiness.type == ipc::type::Binary) {
+				std::vector<obs::TransitionReadiness> events;
+				if (obs::read_list(readiness.value_bin, events) && !events.empty())
+					dispatch_transition_readiness(events);
+			}
+
 		}
 
 	do_sleep:
@@ -244,4 +292,110 @@ void globalCallback::remove_volmeter(uint64_t id)
 	
 	volmeters[id].Release();
 	volmeters.erase(id);
-}
\ No newline at end of file
+}
+
+void globalCallback::update_media(const std::vector<obs::MediaClock>& clocks)
+{
+	auto                         now = std::chrono::steady_clock::now();
+	std::unique_lock<std::mutex> ulock(mtx_media);
+	for (auto& clock : clocks) {
+		MediaClockSample& sample = media_clocks[clock.uid];
+		sample.state             = clock.state;
+		sample.time              = clock.time;
+		sample.duration          = clock.duration;
+		sample.received          = now;
+		sample.pending           = false;
+	}
+}
+
+bool globalCallback::get_media(uint64_t id, MediaClockSample& sample)
+{
+	if (worker_stop)
+		return false;
+
+	std::unique_lock<std::mutex> ulock(mtx_media);
+	auto                         found = media_clocks.find(id);
+	if (found == media_clocks.end() || found->second.pending)
+		return false;
+
+	sample = found->second;
+	if (sample.state == media_state_playing) {
+		auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
+		    std::chrono::steady_clock::now() - sample.received);
+		sample.time += elapsed.count();
+		if (sample.duration > 0 && sample.time > sample.duration)
+			sample.time = sample.duration;
+	}
+	return true;
+}
+
+void globalCallback::invalidate_media(uint64_t id)
+{
+	std::unique_lock<std::mutex> ulock(mtx_media);
+	auto                         found = media_clocks.find(id);
+	if (found != media_clocks.end())
+		found->second.pending = true;
+}
+
+void globalCallback::set_media_time(uint64_t id, int64_t time)
+{
+	std::unique_lock<std::mutex> ulock(mtx_media);
+	auto                         found = media_clocks.find(id);
+	if (found != media_clocks.end()) {
+		found->second.time     = time;
+		found->second.received = std::chrono::steady_clock::now();
+	}
+}
+
+void globalCallback::add_transition_callback(napi_env env, uint64_t transition, uint64_t target, Napi::Function cb)
+{
+	Napi::ThreadSafeFunction callback_thread = Napi::ThreadSafeFunction::New(
+	    env, cb, "TransitionPrepare", 0, 1, [](Napi::Env) {});
+
+	std::unique_lock<std::mutex> ulock(mtx_transitions);
+	auto                         key   = std::make_pair(transition, target);
+	auto                         found = transition_callbacks.find(key);
+	if (found != transition_callbacks.end()) {
+		found->second.Release();
+		found->second = callback_thread;
+	} else {
+		transition_callbacks.emplace(key, callback_thread);
+	}
+}
+
+void globalCallback::remove_transition_callback(uint64_t transition, uint64_t target)
+{
+	std::unique_lock<std::mutex> ulock(mtx_transitions);
+	auto                         found = transition_callbacks.find(std::make_pair(transition, target));
+	if (found == transition_callbacks.end())
+		return;
+
+	found->second.Release();
+	transition_callbacks.erase(found);
+}
+
+void globalCallback::dispatch_transition_readiness(const std::vector<obs::TransitionReadiness>& events)
+{
+	auto readiness_callback = [](Napi::Env env, Napi::Function jsCallback, obs::TransitionReadiness* data) {
+		jsCallback.Call({readiness_shape.New(
+		    env,
+		    {Napi::Number::New(env, data->state),
+		     Napi::Number::New(env, data->ready),
+		     Napi::Number::New(env, data->total)})});
+		delete data;
+	};
+
+	std::unique_lock<std::mutex> ulock(mtx_transitions);
+	for (auto& event : events) {
+		auto found = transition_callbacks.find(std::make_pair(event.transition, event.target));
+		if (found == transition_callbacks.end())
+			continue;
+
+		obs::TransitionReadiness* data   = new obs::TransitionReadiness(event);
+		napi_status               status = found->second.NonBlockingCall(data, readiness_callback);
+		if (status != napi_ok)
+			delete data;
+		found->second.Release();
+		transition_callbacks.erase(found);
+	}
+}
@@ -16,10 +16,13 @@
 
 ******************************************************************************/
 
+#include <chrono>
 #include <mutex>
 #include <napi.h>
 #include <thread>
 #include <map>
+#include "obs-media.hpp"
+#include "obs-transition.hpp"
 #include "utility-v8.hpp"
 
 struct SourceSizeInfo
@@ -35,6 +38,17 @@ struct SourceSizeInfoData
 	std::vector<SourceSizeInfo*> items;
 };
 
+// Last media clock received for an input. `pending` is set by the client's
+// own play/pause/stop calls until the server confirms the new state.
+struct MediaClockSample
+{
+	int32_t                               state    = 0;
+	int64_t                               time     = 0;
+	int64_t                               duration = 0;
+	std::chrono::steady_clock::time_point received;
+	bool                                  pending = false;
+};
+
 namespace globalCallback
 {
 	extern bool isWorkerRunning;
@@ -54,8 +68,38 @@ namespace globalCallback
 	void add_volmeter(napi_env env, uint64_t id, Napi::Function cb);
 	void remove_volmeter(uint64_t id);
 
+	extern std::mutex mtx_media;
+	extern std::map<uint64_t, MediaClockSample> media_clocks;
+
+	void update_media(const std::vector<obs::MediaClock>& clocks);
+	// Fills in the state and the current playback time of an input, advanced
+	// locally since the last clock while playing. Returns false if no usable
+	// clock is known and the caller has to ask the server.
+	bool get_media(uint64_t id, MediaClockSample& sample);
+	void invalidate_media(uint64_t id);
+	void set_media_time(uint64_t id, int64_t time);
+
+	// One shot callbacks of Transition.prepare, keyed by transition and
+	// target. Preparing the same pair again replaces the callback.
+	extern std::mutex mtx_transitions;
+	extern std::map<std::pair<uint64_t, uint64_t>, Napi::ThreadSafeFunction> transition_callbacks;
+
+	void add_transition_callback(napi_env env, uint64_t transition, uint64_t target, Napi::Function cb);
+	void remove_transition_callback(uint64_t transition, uint64_t target);
+	void dispatch_transition_readiness(const std::vector<obs::TransitionReadiness>& events);
+
+	// JS values of the worker's payloads, also used by BenchmarkPayloads.
+	Napi::Array SourceSizesToValue(Napi::Env env, const SourceSizeInfoData& data);
+	Napi::Array LevelsToValue(Napi::Env env, const std::vector<float>& levels);
+
 	void Init(Napi::Env env, Napi::Object exports);
 
 	Napi::Value RegisterGlobalCallback(const Napi::CallbackInfo& info);
 	Napi::Value RemoveGlobalCallback(const Napi::CallbackInfo& info);
+#ifdef OSN_CLIENT_BENCHMARKS
+	// Converts synthetic sources-resize and volmeter payloads for a while and
+	// reports objects created per second, next to the former per-field path.
+	// See benchmarks/callback-payloads-bench.cpp.
+	Napi::Value BenchmarkPayloads(const Napi::CallbackInfo& info);
+#endif
 }
\ No newline at end of file
@@ -0,0 +1,180 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "collection.hpp"
+#include <error.hpp>
+#include <obs-buffer.hpp>
+#include "controller.hpp"
+#include "input.hpp"
+#include "scene.hpp"
+#include "shared.hpp"
+#include "transition.hpp"
+#include "utility.hpp"
+
+Napi::FunctionReference osn::Collection::constructor;
+
+Napi::Object osn::Collection::Init(Napi::Env env, Napi::Object exports) {
+	Napi::HandleScope scope(env);
+	Napi::Function func =
+		DefineClass(env,
+		"Collection",
+		{
+			StaticMethod("load", &osn::Collection::Load),
+			StaticMethod("save", &osn::Collection::Save),
+			StaticMethod("flush", &osn::Collection::Flush),
+			StaticMethod("setSnapshot", &osn::Collection::SetSnapshot),
+			StaticMethod("restoreSnapshot", &osn::Collection::RestoreSnapshot),
+		});
+	exports.Set("Collection", func);
+	osn::Collection::constructor = Napi::Persistent(func);
+	osn::Collection::constructor.SuppressDestruct();
+	return exports;
+}
+
+osn::Collection::Collection(const Napi::CallbackInfo& info)
+    : Napi::ObjectWrap<osn::Collection>(info) {
+    Napi::Env env = info.Env();
+    Napi::HandleScope scope(env);
+}
+
+Napi::Value osn::Collection::Load(const Napi::CallbackInfo& info)
+{
+	std::string path = info[0].ToString().Utf8Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("Collection", "Load", {ipc::value(path)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	return ReadContent(info, response[1].value_bin);
+}
+
+// Caches and wraps the sources described by a Load or RestoreSnapshot reply.
+Napi::Value osn::Collection::ReadContent(const Napi::CallbackInfo& info, std::vector<char> const& buf)
+{
+	Napi::Array inputs      = Napi::Array::New(info.Env());
+	Napi::Array scenes      = Napi::Array::New(info.Env());
+	Napi::Array transitions = Napi::Array::New(info.Env());
+
+	obs::BufferReader in(buf);
+	uint32_t          count = 0;
+	in.read(count);
+	for (uint32_t idx = 0; idx < count && in.ok(); idx++) {
+		uint64_t    uid  = UINT64_MAX;
+		uint32_t    type = 0;
+		std::string id, name;
+		if (!in.read(uid) || !in.read(type) || !in.read(id) || !in.read(name))
+			break;
+
+		SourceDataInfo* sdi = new SourceDataInfo;
+		sdi->name           = name;
+		sdi->obs_sourceId   = id;
+		sdi->id             = uid;
+		CacheManager<SourceDataInfo*>::getInstance().Store(uid, name, sdi);
+
+		// Values of obs_source_type
+		switch (type) {
+		case 0:
+			inputs[inputs.Length()] = osn::Input::constructor.New({Napi::Number::New(info.Env(), uid)});
+			break;
+		case 2:
+			transitions[transitions.Length()] =
+			    osn::Transition::constructor.New({Napi::Number::New(info.Env(), uid)});
+			break;
+		case 3: {
+			SceneInfo* si = new SceneInfo();
+			si->name      = name;
+			si->id        = uid;
+			CacheManager<SceneInfo*>::getInstance().Store(uid, name, si);
+			scenes[scenes.Length()] = osn::Scene::constructor.New({Napi::Number::New(info.Env(), uid)});
+			break;
+		}
+		}
+	}
+
+	Napi::Object result = Napi::Object::New(info.Env());
+	result.Set("inputs", inputs);
+	result.Set("scenes", scenes);
+	result.Set("transitions", transitions);
+	return result;
+}
+
+Napi::Value osn::Collection::Save(const Napi::CallbackInfo& info)
+{
+	std::string path = info[0].ToString().Utf8Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("Collection", "Save", {ipc::value(path)});
+
+	ValidateResponse(info, response);
+	return info.Env().Undefined();
+}
+
+Napi::Value osn::Collection::Flush(const Napi::CallbackInfo& info)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Collection", "Flush", {});
+
+	ValidateResponse(info, response);
+	return info.Env().Undefined();
+}
+
+Napi::Value osn::Collection::SetSnapshot(const Napi::CallbackInfo& info)
+{
+	std::string path     = info[0].ToString().Utf8Value();
+	uint32_t    interval = info[1].ToNumber().Uint32Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("Collection", "SetSnapshot", {ipc::value(path), ipc::value(interval)});
+
+	ValidateResponse(info, response);
+	return info.Env().Undefined();
+}
+
+Napi::Value osn::Collection::RestoreSnapshot(const Napi::CallbackInfo& info)
+{
+	std::string path = info[0].ToString().Utf8Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("Collection", "RestoreSnapshot", {ipc::value(path)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	return ReadContent(info, response[1].value_bin);
+}
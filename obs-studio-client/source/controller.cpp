@@ -23,6 +23,7 @@
 #include <locale>
 #include <sstream>
 #include <string>
+#include "error.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
 
@@ -350,17 +351,18 @@ std::shared_ptr<ipc::client> Controller::connect(
 	if (m_connection)
 		return nullptr;
 
+	std::string path;
+#ifdef WIN32
+	path = uri;
+#else
+	path = "/tmp/" + uri;
+#endif
+
 	std::shared_ptr<ipc::client> cl;
 	using std::chrono::high_resolution_clock;
 	high_resolution_clock::time_point begin_time = high_resolution_clock::now();
 	while (!cl) {
 		try {
-			std::string path;
-#ifdef WIN32
-			path = uri;
-#else
-			path = "/tmp/" + uri;
-#endif
 			cl = ipc::client::create(path);
 		} catch (...) {
 			cl = nullptr;
@@ -384,11 +386,50 @@ std::shared_ptr<ipc::client> Controller::connect(
 	}
 
 	m_connection = cl;
+	{
+		std::unique_lock<std::mutex> ulock(m_subscriberMtx);
+		m_subscriber = 0;
+	}
+
+	// The server runs every connection on its own thread, the polling
+	// threads get theirs so their queries do not wait behind the calls of
+	// the main thread. Without them everything goes through m_connection.
+	std::vector<std::shared_ptr<ipc::client>> queries;
+	for (size_t idx = 0; idx < queryConnectionCount; idx++) {
+		std::shared_ptr<ipc::client> query;
+		try {
+			query = ipc::client::create(path);
+		} catch (...) {
+			query = nullptr;
+		}
+		if (!query)
+			break;
+		queries.push_back(query);
+	}
+	{
+		std::unique_lock<std::mutex> ulock(m_queryConnectionsMtx);
+		m_queryConnections.swap(queries);
+	}
+
 	return m_connection;
 }
 
 void Controller::disconnect()
 {
+	// The polling threads may still pick a query connection, take them out
+	// under the lock and let the last user close them.
+	std::vector<std::shared_ptr<ipc::client>> queries;
+	{
+		std::unique_lock<std::mutex> ulock(m_queryConnectionsMtx);
+		m_queryConnections.swap(queries);
+	}
+	queries.clear();
+	{
+		std::unique_lock<std::mutex> ulock(m_subscriberMtx);
+		if (m_subscriber && m_connection)
+			m_connection->call_synchronous_helper("CallbackManager", "Unsubscribe", {ipc::value(m_subscriber)});
+		m_subscriber = 0;
+	}
 	if (m_isServer) {
 		m_connection->call_synchronous_helper("System", "Shutdown", {});
 		m_isServer = false;
@@ -428,6 +469,26 @@ std::shared_ptr<ipc::client> Controller::GetConnection()
 	return m_connection;
 }
 
+std::shared_ptr<ipc::client> Controller::GetQueryConnection()
+{
+	std::unique_lock<std::mutex> ulock(m_queryConnectionsMtx);
+	if (m_queryConnections.empty())
+		return m_connection;
+	return m_queryConnections[m_nextQuery++ % m_queryConnections.size()];
+}
+
+uint64_t Controller::GetEventSubscriber()
+{
+	std::unique_lock<std::mutex> ulock(m_subscriberMtx);
+	if (m_subscriber || !m_connection)
+		return m_subscriber;
+
+	std::vector<ipc::value> response = m_connection->call_synchronous_helper("CallbackManager", "Subscribe", {});
+	if (response.size() >= 2 && (ErrorCode)response[0].value_union.ui64 == ErrorCode::Ok)
+		m_subscriber = response[1].value_union.ui64;
+	return m_subscriber;
+}
+
 Napi::Value js_setServerPath(const Napi::CallbackInfo& info)
 {
 	if (info.Length() == 0) {
@@ -17,9 +17,12 @@
 ******************************************************************************/
 
 #pragma once
+#include <atomic>
 #include <memory>
 #include <map>
+#include <mutex>
 #include <string>
+#include <vector>
 #include "ipc.hpp"
 #include "ipc-client.hpp"
 #include <napi.h>
@@ -56,8 +59,24 @@ class Controller
 
 	std::shared_ptr<ipc::client> GetConnection();
 
+	// Connection for the read-only queries of the polling threads, see
+	// osn::Dispatch on the server. Falls back to GetConnection().
+	std::shared_ptr<ipc::client> GetQueryConnection();
+
+	// Subscription to the server's event logs, taken on first use and
+	// shared by all polling threads of this process. 0 if there is none.
+	uint64_t GetEventSubscriber();
+
 	private:
 	bool                         m_isServer = false;
 	std::shared_ptr<ipc::client> m_connection;
+
+	static const size_t                       queryConnectionCount = 2;
+	std::mutex                                m_queryConnectionsMtx;
+	std::vector<std::shared_ptr<ipc::client>> m_queryConnections;
+	std::atomic<size_t>                       m_nextQuery{0};
+
+	std::mutex m_subscriberMtx;
+	uint64_t   m_subscriber = 0;
 	ipc::ProcessInfo                  procId;
 };
@@ -23,6 +23,7 @@
 #include "controller.hpp"
 #include "error.hpp"
 #include "ipc-value.hpp"
+#include "obs-source-type.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
 
@@ -35,6 +36,7 @@ Napi::Object osn::Filter::Init(Napi::Env env, Napi::Object exports) {
 		"Filter",
 		{
 			StaticMethod("types", &osn::Filter::Types),
+			StaticMethod("typeCatalog", &osn::Filter::TypeCatalog),
 			StaticMethod("create", &osn::Filter::Create),
 
 			InstanceAccessor("configurable", &osn::Filter::CallIsConfigurable, nullptr),
@@ -51,6 +53,8 @@ Napi::Object osn::Filter::Init(Napi::Env env, Napi::Object exports) {
 
 			InstanceMethod("release", &osn::Filter::CallRelease),
 			InstanceMethod("remove", &osn::Filter::CallRemove),
+			InstanceMethod("openPropertySession", &osn::Filter::CallOpenPropertySession),
+			InstanceMethod("closePropertySession", &osn::Filter::CallClosePropertySession),
 			InstanceMethod("update", &osn::Filter::CallUpdate),
 			InstanceMethod("load", &osn::Filter::CallLoad),
 			InstanceMethod("save", &osn::Filter::CallSave),
@@ -82,22 +86,12 @@ osn::Filter::Filter(const Napi::CallbackInfo& info)
 
 Napi::Value osn::Filter::Types(const Napi::CallbackInfo& info)
 {
-	auto conn = GetConnection(info);
-	if (!conn)
-		return info.Env().Undefined();
-
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Filter", "Types", {});
-
-	if (!ValidateResponse(info, response))
-		return info.Env().Undefined();
-
-	size_t count = response.size() - 1;
-	Napi::Array types = Napi::Array::New(info.Env(), count);
-
-	for (size_t idx = 0; idx < count; idx++)
-		types.Set(idx, Napi::String::New(info.Env(), response[1 + idx].value_str));
+	return osn::ISource::GetTypes(info, obs::SourceTypeEntry::Filter);
+}
 
-	return types;
+Napi::Value osn::Filter::TypeCatalog(const Napi::CallbackInfo& info)
+{
+	return osn::ISource::GetTypeCatalog(info, obs::SourceTypeEntry::Filter);
 }
 
 Napi::Value osn::Filter::Create(const Napi::CallbackInfo& info)
@@ -241,6 +235,20 @@ Napi::Value osn::Filter::CallRemove(const Napi::CallbackInfo& info)
 	return info.Env().Undefined();
 }
 
+Napi::Value osn::Filter::CallOpenPropertySession(const Napi::CallbackInfo& info)
+{
+	osn::ISource::OpenPropertySession(info, this->sourceId);
+
+	return info.Env().Undefined();
+}
+
+Napi::Value osn::Filter::CallClosePropertySession(const Napi::CallbackInfo& info)
+{
+	osn::ISource::ClosePropertySession(info, this->sourceId);
+
+	return info.Env().Undefined();
+}
+
 Napi::Value osn::Filter::CallUpdate(const Napi::CallbackInfo& info)
 {
 	osn::ISource::Update(info, this->sourceId);
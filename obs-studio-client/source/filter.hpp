@@ -34,6 +34,7 @@ namespace osn
 		Filter(const Napi::CallbackInfo& info);
 
 		static Napi::Value Types(const Napi::CallbackInfo& info);
+		static Napi::Value TypeCatalog(const Napi::CallbackInfo& info);
 		static Napi::Value Create(const Napi::CallbackInfo& info);
 
 		Napi::Value CallIsConfigurable(const Napi::CallbackInfo& info);
@@ -55,6 +56,8 @@ namespace osn
 
 		Napi::Value CallRelease(const Napi::CallbackInfo& info);
 		Napi::Value CallRemove(const Napi::CallbackInfo& info);
+		Napi::Value CallOpenPropertySession(const Napi::CallbackInfo& info);
+		Napi::Value CallClosePropertySession(const Napi::CallbackInfo& info);
 		Napi::Value CallUpdate(const Napi::CallbackInfo& info);
 		Napi::Value CallLoad(const Napi::CallbackInfo& info);
 		Napi::Value CallSave(const Napi::CallbackInfo& info);
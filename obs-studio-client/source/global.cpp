@@ -25,6 +25,7 @@
 #include "input.hpp"
 #include "scene.hpp"
 #include "transition.hpp"
+#include "video.hpp"
 #include "utility-v8.hpp"
 
 Napi::FunctionReference osn::Global::constructor;
@@ -133,6 +134,10 @@ Napi::Value osn::Global::getOutputFlagsFromId(const Napi::CallbackInfo& info)
 
 Napi::Value osn::Global::laggedFrames(const Napi::CallbackInfo& info)
 {
+	obs::FrameStats stats;
+	if (osn::Video::ReadFrameStats(info, stats))
+		return Napi::Number::New(info.Env(), double(stats.render_lagged));
+
 	auto conn = GetConnection(info);
 	if (!conn)
 		return info.Env().Undefined();
@@ -147,6 +152,10 @@ Napi::Value osn::Global::laggedFrames(const Napi::CallbackInfo& info)
 
 Napi::Value osn::Global::totalFrames(const Napi::CallbackInfo& info)
 {
+	obs::FrameStats stats;
+	if (osn::Video::ReadFrameStats(info, stats))
+		return Napi::Number::New(info.Env(), double(stats.render_total));
+
 	auto conn = GetConnection(info);
 	if (!conn)
 		return info.Env().Undefined();
@@ -22,10 +22,15 @@
 #include <string>
 #include <algorithm>
 #include <iterator>
+#include "callback-manager.hpp"
 #include "controller.hpp"
 #include "error.hpp"
 #include "filter.hpp"
 #include "ipc-value.hpp"
+#include "obs-import.hpp"
+#include "obs-source-type.hpp"
+#include "scene.hpp"
+#include "sceneitem.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
 
@@ -38,15 +43,18 @@ Napi::Object osn::Input::Init(Napi::Env env, Napi::Object exports) {
 		"Input",
 		{
 			StaticMethod("types", &osn::Input::Types),
+			StaticMethod("typeCatalog", &osn::Input::TypeCatalog),
 			StaticMethod("create", &osn::Input::Create),
 			StaticMethod("createPrivate", &osn::Input::CreatePrivate),
 			StaticMethod("fromName", &osn::Input::FromName),
 			StaticMethod("getPublicSources", &osn::Input::GetPublicSources),
+			StaticMethod("createBulk", &osn::Input::CreateBulk),
 
 			InstanceMethod("duplicate", &osn::Input::Duplicate),
 			InstanceMethod("addFilter", &osn::Input::AddFilter),
 			InstanceMethod("removeFilter", &osn::Input::RemoveFilter),
 			InstanceMethod("setFilterOrder", &osn::Input::SetFilterOrder),
+			InstanceMethod("setFilterChain", &osn::Input::SetFilterChain),
 			InstanceMethod("findFilter", &osn::Input::FindFilter),
 			InstanceMethod("copyFilters", &osn::Input::CopyFilters),
 
@@ -77,6 +85,8 @@ Napi::Object osn::Input::Init(Napi::Env env, Napi::Object exports) {
 
 			InstanceMethod("release", &osn::Input::CallRelease),
 			InstanceMethod("remove", &osn::Input::CallRemove),
+			InstanceMethod("openPropertySession", &osn::Input::CallOpenPropertySession),
+			InstanceMethod("closePropertySession", &osn::Input::CallClosePropertySession),
 			InstanceMethod("update", &osn::Input::CallUpdate),
 			InstanceMethod("load", &osn::Input::CallLoad),
 			InstanceMethod("save", &osn::Input::CallSave),
@@ -114,22 +124,12 @@ osn::Input::Input(const Napi::CallbackInfo& info)
 
 Napi::Value osn::Input::Types(const Napi::CallbackInfo& info)
 {
-	auto conn = GetConnection(info);
-	if (!conn)
-		return info.Env().Undefined();
-
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Input", "Types", {});
-
-	if (!ValidateResponse(info, response))
-		return info.Env().Undefined();
-
-	std::vector<std::string> types;
-
-	for (size_t i = 1; i < response.size(); i++) {
-		types.push_back(response[i].value_str);
-	}
+	return osn::ISource::GetTypes(info, obs::SourceTypeEntry::Input);
+}
 
-	return utilv8::ToValue<std::string>(info, types);
+Napi::Value osn::Input::TypeCatalog(const Napi::CallbackInfo& info)
+{
+	return osn::ISource::GetTypeCatalog(info, obs::SourceTypeEntry::Input);
 }
 
 Napi::Value osn::Input::Create(const Napi::CallbackInfo& info)
@@ -297,6 +297,146 @@ Napi::Value osn::Input::GetPublicSources(const Napi::CallbackInfo& info)
 	return arr;
 }
 
+Napi::Value osn::Input::CreateBulk(const Napi::CallbackInfo& info)
+{
+	if (info.Length() < 1 || !info[0].IsArray()) {
+		Napi::TypeError::New(info.Env(), "Expected an array of input definitions").ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+
+	Napi::Object   json      = info.Env().Global().Get("JSON").As<Napi::Object>();
+	Napi::Function stringify = json.Get("stringify").As<Napi::Function>();
+	auto           toJson    = [&](Napi::Object object, const char* key) {
+		if (!object.Has(key) || object.Get(key).IsUndefined())
+			return std::string();
+		return stringify.Call(json, {object.Get(key)}).As<Napi::String>().Utf8Value();
+	};
+
+	Napi::Array                       array = info[0].As<Napi::Array>();
+	std::vector<obs::InputDefinition> definitions(array.Length());
+	for (uint32_t idx = 0; idx < array.Length(); idx++) {
+		Napi::Object          object = array.Get(idx).ToObject();
+		obs::InputDefinition& input  = definitions[idx];
+
+		input.type     = object.Get("id").ToString().Utf8Value();
+		input.name     = object.Get("name").ToString().Utf8Value();
+		input.settings = toJson(object, "settings");
+		input.hotkeys  = toJson(object, "hotkeys");
+
+		if (object.Has("filters") && object.Get("filters").IsArray()) {
+			Napi::Array filters = object.Get("filters").As<Napi::Array>();
+			for (uint32_t fdx = 0; fdx < filters.Length(); fdx++) {
+				Napi::Object          entry = filters.Get(fdx).ToObject();
+				obs::FilterDefinition filter;
+				filter.type     = entry.Get("id").ToString().Utf8Value();
+				filter.name     = entry.Get("name").ToString().Utf8Value();
+				filter.settings = toJson(entry, "settings");
+				if (entry.Has("enabled"))
+					filter.enabled = entry.Get("enabled").ToBoolean().Value();
+				input.filters.push_back(std::move(filter));
+			}
+		}
+
+		if (object.Has("placements") && object.Get("placements").IsArray()) {
+			Napi::Array placements = object.Get("placements").As<Napi::Array>();
+			for (uint32_t pdx = 0; pdx < placements.Length(); pdx++) {
+				Napi::Object             entry = placements.Get(pdx).ToObject();
+				obs::PlacementDefinition placement;
+				placement.scene = Napi::ObjectWrap<osn::Scene>::Unwrap(entry.Get("scene").ToObject())->sourceId;
+				if (entry.Has("visible"))
+					placement.visible = entry.Get("visible").ToBoolean().Value();
+				osn::SceneItem::ParseTransform(entry, placement.transform);
+				input.placements.push_back(placement);
+			}
+		}
+	}
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper(
+	    "Input", "CreateBulk", {ipc::value(obs::serialize_definitions(definitions))});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	std::vector<obs::InputImportResult> results;
+	if (!obs::read_results(response[1].value_bin, results) || results.size() != definitions.size()) {
+		Napi::Error::New(info.Env(), "Malformed bulk import response").ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+
+	Napi::Array arr = Napi::Array::New(info.Env(), results.size());
+	for (size_t idx = 0; idx < results.size(); idx++) {
+		obs::InputDefinition&   input   = definitions[idx];
+		obs::InputImportResult& result  = results[idx];
+		Napi::Object            entry   = Napi::Object::New(info.Env());
+		Napi::Array             filters = Napi::Array::New(info.Env(), result.filters.size());
+		Napi::Array             items   = Napi::Array::New(info.Env(), result.items.size());
+
+		if (result.uid == UINT64_MAX) {
+			entry.Set("input", info.Env().Null());
+			entry.Set("filters", filters);
+			entry.Set("items", items);
+			arr[uint32_t(idx)] = entry;
+			continue;
+		}
+
+		SourceDataInfo* sdi = new SourceDataInfo;
+		sdi->name           = input.name;
+		sdi->obs_sourceId   = input.type;
+		sdi->id             = result.uid;
+		sdi->audioMixers    = result.audio_mixers;
+		CacheManager<SourceDataInfo*>::getInstance().Store(result.uid, input.name, sdi);
+		entry.Set("input", osn::Input::constructor.New({Napi::Number::New(info.Env(), result.uid)}));
+
+		for (size_t fdx = 0; fdx < result.filters.size(); fdx++) {
+			uint64_t filter_uid = result.filters[fdx];
+			if (filter_uid == UINT64_MAX) {
+				filters[uint32_t(fdx)] = info.Env().Null();
+				continue;
+			}
+
+			SourceDataInfo* fdi = new SourceDataInfo;
+			fdi->name           = input.filters[fdx].name;
+			fdi->obs_sourceId   = input.filters[fdx].type;
+			fdi->id             = filter_uid;
+			CacheManager<SourceDataInfo*>::getInstance().Store(filter_uid, fdi->name, fdi);
+			filters[uint32_t(fdx)] = osn::Filter::constructor.New({Napi::Number::New(info.Env(), filter_uid)});
+		}
+
+		for (size_t tdx = 0; tdx < result.items.size(); tdx++) {
+			const obs::InputImportResult::Item& item      = result.items[tdx];
+			const obs::PlacementDefinition&     placement = input.placements[tdx];
+			if (item.uid == UINT64_MAX) {
+				items[uint32_t(tdx)] = info.Env().Null();
+				continue;
+			}
+
+			SceneInfo* si = CacheManager<SceneInfo*>::getInstance().Retrieve(placement.scene);
+			if (si) {
+				si->items.push_back(std::make_pair(item.obs_id, item.uid));
+				si->itemsOrderCached = true;
+			}
+
+			SceneItemData* sid  = new SceneItemData;
+			sid->obs_itemId     = item.obs_id;
+			sid->scene_id       = placement.scene;
+			sid->isVisible      = placement.visible;
+			sid->visibleChanged = false;
+			CacheManager<SceneItemData*>::getInstance().Store(item.uid, sid);
+			items[uint32_t(tdx)] = osn::SceneItem::constructor.New({Napi::Number::New(info.Env(), item.uid)});
+		}
+
+		entry.Set("filters", filters);
+		entry.Set("items", items);
+		arr[uint32_t(idx)] = entry;
+	}
+
+	return arr;
+}
+
 Napi::Value osn::Input::Duplicate(const Napi::CallbackInfo& info)
 {
 	std::string name       = "";
@@ -673,6 +813,62 @@ Napi::Value osn::Input::SetFilterOrder(const Napi::CallbackInfo& info)
 	return info.Env().Undefined();
 }
 
+Napi::Value osn::Input::SetFilterChain(const Napi::CallbackInfo& info)
+{
+	if (!info[0].IsArray()) {
+		Napi::TypeError::New(info.Env(), "Expected an array of filter chain entries").ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+
+	Napi::Array                        chain = info[0].As<Napi::Array>();
+	std::vector<obs::FilterChainEntry> entries(chain.Length());
+	for (uint32_t idx = 0; idx < chain.Length(); idx++) {
+		Napi::Object entry = chain.Get(idx).ToObject();
+		if (!entry.Get("filter").IsObject()) {
+			Napi::TypeError::New(info.Env(), "Filter chain entry is missing its filter")
+			    .ThrowAsJavaScriptException();
+			return info.Env().Undefined();
+		}
+
+		osn::Filter* objfilter = Napi::ObjectWrap<osn::Filter>::Unwrap(entry.Get("filter").ToObject());
+		entries[idx].uid       = objfilter->sourceId;
+		if (entry.Has("enabled"))
+			entries[idx].enabled = entry.Get("enabled").ToBoolean().Value() ? 1 : 0;
+	}
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper(
+	    "Input", "SetFilterChain", {ipc::value(this->sourceId), ipc::value(obs::serialize_list(entries))});
+
+	SourceDataInfo* sdi = CacheManager<SourceDataInfo*>::getInstance().Retrieve(this->sourceId);
+	if (sdi)
+		sdi->filtersOrderChanged = true;
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	std::vector<uint64_t> order;
+	if (response.size() < 2 || !obs::read_list(response[1].value_bin, order)) {
+		Napi::Error::New(info.Env(), "Malformed filter chain response").ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+
+	// The answer is the authoritative order, so it refreshes the cache and
+	// the next read of `filters` does not need another round trip.
+	if (sdi) {
+		*sdi->filters            = order;
+		sdi->filtersOrderChanged = false;
+	}
+
+	Napi::Array array = Napi::Array::New(info.Env(), order.size());
+	for (size_t idx = 0; idx < order.size(); idx++)
+		array.Set(uint32_t(idx), osn::Filter::constructor.New({Napi::Number::New(info.Env(), order[idx])}));
+	return array;
+}
+
 Napi::Value osn::Input::FindFilter(const Napi::CallbackInfo& info)
 {
 	std::string name = info[0].ToString().Utf8Value();
@@ -805,6 +1001,20 @@ Napi::Value osn::Input::CallRemove(const Napi::CallbackInfo& info)
 	return info.Env().Undefined();
 }
 
+Napi::Value osn::Input::CallOpenPropertySession(const Napi::CallbackInfo& info)
+{
+	osn::ISource::OpenPropertySession(info, this->sourceId);
+
+	return info.Env().Undefined();
+}
+
+Napi::Value osn::Input::CallClosePropertySession(const Napi::CallbackInfo& info)
+{
+	osn::ISource::ClosePropertySession(info, this->sourceId);
+
+	return info.Env().Undefined();
+}
+
 Napi::Value osn::Input::CallUpdate(const Napi::CallbackInfo& info)
 {
 	osn::ISource::Update(info, this->sourceId);
@@ -868,6 +1078,10 @@ Napi::Value osn::Input::CallSendKeyClick(const Napi::CallbackInfo& info)
 
 Napi::Value osn::Input::GetDuration(const Napi::CallbackInfo& info)
 {
+	MediaClockSample sample;
+	if (globalCallback::get_media(this->sourceId, sample))
+		return Napi::Number::New(info.Env(), sample.duration);
+
 	auto conn = GetConnection(info);
 
 	if (!conn)
@@ -884,6 +1098,10 @@ Napi::Value osn::Input::GetDuration(const Napi::CallbackInfo& info)
 
 Napi::Value osn::Input::GetTime(const Napi::CallbackInfo& info)
 {
+	MediaClockSample sample;
+	if (globalCallback::get_media(this->sourceId, sample))
+		return Napi::Number::New(info.Env(), sample.time);
+
 	auto conn = GetConnection(info);
 
 	if (!conn)
@@ -906,6 +1124,7 @@ void osn::Input::SetTime(const Napi::CallbackInfo& info, const Napi::Value &valu
 	if (!conn)
 		return;
 
+	globalCallback::set_media_time(this->sourceId, ms);
 	conn->call("Input", "SetTime", {ipc::value((uint64_t)this->sourceId), ipc::value(ms)});
 }
 
@@ -915,6 +1134,7 @@ void osn::Input::Play(const Napi::CallbackInfo& info)
 	if (!conn)
 		return;
 
+	globalCallback::invalidate_media(this->sourceId);
 	conn->call("Input", "Play", {ipc::value((uint64_t)this->sourceId)});
 }
 
@@ -924,6 +1144,7 @@ void osn::Input::Pause(const Napi::CallbackInfo& info)
 	if (!conn)
 		return;
 
+	globalCallback::invalidate_media(this->sourceId);
 	conn->call("Input", "Pause", {ipc::value((uint64_t)this->sourceId)});
 }
 
@@ -933,6 +1154,7 @@ void osn::Input::Restart(const Napi::CallbackInfo& info)
 	if (!conn)
 		return;
 
+	globalCallback::invalidate_media(this->sourceId);
 	conn->call("Input", "Restart", {ipc::value((uint64_t)this->sourceId)});
 }
 
@@ -942,11 +1164,16 @@ void osn::Input::Stop(const Napi::CallbackInfo& info)
 	if (!conn)
 		return;
 
+	globalCallback::invalidate_media(this->sourceId);
 	conn->call("Input", "Stop", {ipc::value((uint64_t)this->sourceId)});
 }
 
 Napi::Value osn::Input::GetMediaState(const Napi::CallbackInfo& info)
 {
+	MediaClockSample sample;
+	if (globalCallback::get_media(this->sourceId, sample))
+		return Napi::Number::New(info.Env(), sample.state);
+
 	auto conn = GetConnection(info);
 
 	if (!conn)
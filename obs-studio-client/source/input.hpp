@@ -34,15 +34,18 @@ namespace osn
 		Input(const Napi::CallbackInfo& info);
 
 		static Napi::Value Types(const Napi::CallbackInfo& info);
+		static Napi::Value TypeCatalog(const Napi::CallbackInfo& info);
 		static Napi::Value Create(const Napi::CallbackInfo& info);
 		static Napi::Value CreatePrivate(const Napi::CallbackInfo& info);
 		static Napi::Value FromName(const Napi::CallbackInfo& info);
 		static Napi::Value GetPublicSources(const Napi::CallbackInfo& info);
+		static Napi::Value CreateBulk(const Napi::CallbackInfo& info);
 
 		Napi::Value Duplicate(const Napi::CallbackInfo& info);
 		Napi::Value AddFilter(const Napi::CallbackInfo& info);
 		Napi::Value RemoveFilter(const Napi::CallbackInfo& info);
 		Napi::Value SetFilterOrder(const Napi::CallbackInfo& info);
+		Napi::Value SetFilterChain(const Napi::CallbackInfo& info);
 		Napi::Value FindFilter(const Napi::CallbackInfo& info);
 		Napi::Value CopyFilters(const Napi::CallbackInfo& info);
 
@@ -83,6 +86,8 @@ namespace osn
 
 		Napi::Value CallRelease(const Napi::CallbackInfo& info);
 		Napi::Value CallRemove(const Napi::CallbackInfo& info);
+		Napi::Value CallOpenPropertySession(const Napi::CallbackInfo& info);
+		Napi::Value CallClosePropertySession(const Napi::CallbackInfo& info);
 		Napi::Value CallUpdate(const Napi::CallbackInfo& info);
 		Napi::Value CallLoad(const Napi::CallbackInfo& info);
 		Napi::Value CallSave(const Napi::CallbackInfo& info);
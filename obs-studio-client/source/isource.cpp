@@ -20,6 +20,8 @@
 #include <error.hpp>
 #include <functional>
 #include "controller.hpp"
+#include "obs-source-type.hpp"
+#include "obs-string-table.hpp"
 #include "shared.hpp"
 #include "utility-v8.hpp"
 #include "utility.hpp"
@@ -30,6 +32,13 @@ void osn::ISource::Release(const Napi::CallbackInfo& info, uint64_t id)
 	if (!conn)
 		return;
 
+	// The server closes the property session together with the source.
+	SourceDataInfo* sdi = CacheManager<SourceDataInfo*>::getInstance().Retrieve(id);
+	if (sdi) {
+		sdi->propertySession   = 0;
+		sdi->propertiesChanged = true;
+	}
+
 	conn->call("Source", "Release", {ipc::value(id)});
 }
 
@@ -44,6 +53,95 @@ void osn::ISource::Remove(const Napi::CallbackInfo& info, uint64_t id)
 	conn->call("Source", "Remove", {ipc::value(id)});
 }
 
+struct SourceTypeInfo
+{
+	uint32_t    kind         = 0;
+	std::string id;
+	std::string display_name;
+	uint32_t    output_flags = 0;
+	int32_t     icon_type    = 0;
+};
+
+static std::vector<SourceTypeInfo> source_types;
+static bool                        source_types_valid = false;
+
+static bool load_source_types(const Napi::CallbackInfo& info)
+{
+	if (source_types_valid)
+		return true;
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return false;
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Source", "GetTypes", {});
+
+	if (!ValidateResponse(info, response))
+		return false;
+
+	std::vector<obs::SourceTypeEntry> entries;
+	if (response.size() < 3 || !obs::read_list(response[1].value_bin, entries)) {
+		Napi::Error::New(info.Env(), "Malformed source type response").ThrowAsJavaScriptException();
+		return false;
+	}
+	const std::vector<char>& strings = response[2].value_bin;
+
+	source_types.clear();
+	source_types.reserve(entries.size());
+	for (auto& entry : entries) {
+		SourceTypeInfo type;
+		type.kind         = entry.kind;
+		type.id           = obs::StringTable::read(strings, entry.id);
+		type.display_name = obs::StringTable::read(strings, entry.display_name);
+		type.output_flags = entry.output_flags;
+		type.icon_type    = entry.icon_type;
+		source_types.push_back(std::move(type));
+	}
+	source_types_valid = true;
+	return true;
+}
+
+Napi::Value osn::ISource::GetTypes(const Napi::CallbackInfo& info, uint32_t kind)
+{
+	if (!load_source_types(info))
+		return info.Env().Undefined();
+
+	Napi::Array types = Napi::Array::New(info.Env());
+	uint32_t    index = 0;
+	for (auto& type : source_types) {
+		if (type.kind == kind)
+			types.Set(index++, Napi::String::New(info.Env(), type.id));
+	}
+	return types;
+}
+
+Napi::Value osn::ISource::GetTypeCatalog(const Napi::CallbackInfo& info, uint32_t kind)
+{
+	if (!load_source_types(info))
+		return info.Env().Undefined();
+
+	Napi::Array types = Napi::Array::New(info.Env());
+	uint32_t    index = 0;
+	for (auto& type : source_types) {
+		if (type.kind != kind)
+			continue;
+
+		Napi::Object object = Napi::Object::New(info.Env());
+		object.Set("id", Napi::String::New(info.Env(), type.id));
+		object.Set("name", Napi::String::New(info.Env(), type.display_name));
+		object.Set("outputFlags", Napi::Number::New(info.Env(), type.output_flags));
+		object.Set("iconType", Napi::Number::New(info.Env(), type.icon_type));
+		types.Set(index++, object);
+	}
+	return types;
+}
+
+void osn::ISource::InvalidateTypes()
+{
+	source_types_valid = false;
+	source_types.clear();
+}
+
 Napi::Value osn::ISource::IsConfigurable(const Napi::CallbackInfo& info, uint64_t id)
 {
 	osn::ISource* source =
@@ -64,234 +162,165 @@ Napi::Value osn::ISource::IsConfigurable(const Napi::CallbackInfo& info, uint64_
 	return Napi::Boolean::New(info.Env(), (bool)response[1].value_union.i32);
 }
 
-Napi::Value osn::ISource::GetProperties(const Napi::CallbackInfo& info, uint64_t id)
+osn::property_set_t osn::ISource::ApplyPropertyChanges(
+    const property_set_t& current, const std::vector<ipc::value>& response, size_t first)
 {
-	osn::ISource* source =
-		Napi::ObjectWrap<osn::ISource>::Unwrap(info.This().ToObject());
-	if (!source)
-		return info.Env().Undefined();
+	if (response.size() <= first)
+		return current;
+
+	bool rebuilt = !!response[first].value_union.ui32;
+	if (!rebuilt && response.size() == first + 1)
+		return current;
+
+	osn::PropertySetBuilder builder;
+	for (size_t idx = first + 1; idx < response.size(); ++idx)
+		builder.Read(response[idx].value_bin);
+	if (rebuilt || !current)
+		return builder.Build();
+
+	// Snapshots are immutable, the changed properties replace theirs in a copy.
+	property_set_t changed = builder.Build();
+	for (auto& prop : current->properties) {
+		const osn::Property* replacement = changed->find(current->string(prop.name));
+		if (replacement)
+			builder.Copy(*changed, *replacement);
+		else
+			builder.Copy(*current, prop);
+	}
+	return builder.Build();
+}
 
-	SourceDataInfo* sdi =
-		CacheManager<SourceDataInfo*>::getInstance().Retrieve(id);
+std::vector<ipc::value> osn::ISource::CallPropertySession(
+    const Napi::CallbackInfo& info, SourceDataInfo* sdi, const std::string& function, std::vector<ipc::value> args)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return {};
+
+	// A session the server dropped is reopened once, which also resends the
+	// whole list.
+	for (int attempt = 0; attempt < 2; attempt++) {
+		if (!sdi->propertySession) {
+			std::vector<ipc::value> response = conn->call_synchronous_helper(
+			    "Properties", "OpenSession", {ipc::value(sdi->id), ipc::value(sdi->maxInlineListItems)});
+			if (response.size() < 3 || (ErrorCode)response[0].value_union.ui64 != ErrorCode::Ok)
+				return response;
+
+			sdi->propertySession = response[1].value_union.ui64;
+			sdi->properties      = ApplyPropertyChanges(sdi->properties, response, 2);
+		}
+
+		std::vector<ipc::value> call_args = {ipc::value(sdi->propertySession)};
+		call_args.insert(call_args.end(), args.begin(), args.end());
 
-	if (sdi && !sdi->propertiesChanged && sdi->properties.size() > 0) {
-		std::shared_ptr<property_map_t> pSomeObject = std::make_shared<property_map_t>(sdi->properties);
-		auto prop_ptr = Napi::External<property_map_t>::New(info.Env(), pSomeObject.get());
-		auto instance =
-			osn::Properties::constructor.New({
-				prop_ptr,
-				Napi::Number::New(info.Env(), (uint32_t)id)
-				});
-		return instance;
+		std::vector<ipc::value> response = conn->call_synchronous_helper("Properties", function, call_args);
+		if (attempt == 0 && response.size() > 0
+		    && (ErrorCode)response[0].value_union.ui64 == ErrorCode::InvalidReference) {
+			sdi->propertySession = 0;
+			continue;
+		}
+		return response;
 	}
+	return {};
+}
+
+void osn::ISource::OpenPropertySession(const Napi::CallbackInfo& info, uint64_t id)
+{
+	SourceDataInfo* sdi = CacheManager<SourceDataInfo*>::getInstance().Retrieve(id);
+	if (!sdi || sdi->propertySession)
+		return;
+
+	if (info.Length() > 0 && info[0].IsNumber())
+		sdi->maxInlineListItems = info[0].ToNumber().Uint32Value();
 
 	auto conn = GetConnection(info);
 	if (!conn)
-		return info.Env().Undefined();
+		return;
 
-	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Source", "GetProperties", {ipc::value(id)});
+	std::vector<ipc::value> response = conn->call_synchronous_helper(
+	    "Properties", "OpenSession", {ipc::value(id), ipc::value(sdi->maxInlineListItems)});
 
 	if (!ValidateResponse(info, response))
-		return info.Env().Undefined();
+		return;
 
-	if (response.size() == 1)
-		return info.Env().Null();
+	sdi->propertySession   = response[1].value_union.ui64;
+	sdi->properties        = ApplyPropertyChanges(sdi->properties, response, 2);
+	sdi->propertiesChanged = false;
+}
 
-	osn::property_map_t pmap;
-	for (size_t idx = 1; idx < response.size(); ++idx) {
-		auto raw_property = obs::Property::deserialize(response[idx].value_bin);
+void osn::ISource::ClosePropertySession(const Napi::CallbackInfo& info, uint64_t id)
+{
+	SourceDataInfo* sdi = CacheManager<SourceDataInfo*>::getInstance().Retrieve(id);
+	if (!sdi || !sdi->propertySession)
+		return;
 
-		std::shared_ptr<osn::Property> pr;
+	auto conn = GetConnection(info);
+	if (!conn)
+		return;
 
-		switch (raw_property->type()) {
-		case obs::Property::Type::Boolean: {
-			std::shared_ptr<obs::BooleanProperty> cast_property =
-			    std::dynamic_pointer_cast<obs::BooleanProperty>(raw_property);
-			std::shared_ptr<osn::NumberProperty> pr2 = std::make_shared<osn::NumberProperty>();
-			pr2->bool_value.value                    = cast_property->value;
-			pr                                       = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		case obs::Property::Type::Integer: {
-			std::shared_ptr<obs::IntegerProperty> cast_property =
-			    std::dynamic_pointer_cast<obs::IntegerProperty>(raw_property);
-			std::shared_ptr<osn::NumberProperty> pr2 = std::make_shared<osn::NumberProperty>();
-			pr2->field_type                          = osn::NumberProperty::Type(cast_property->field_type);
-			pr2->int_value.min                       = cast_property->minimum;
-			pr2->int_value.max                       = cast_property->maximum;
-			pr2->int_value.step                      = cast_property->step;
-			pr2->int_value.value                     = cast_property->value;
-			pr                                       = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		case obs::Property::Type::Color: {
-			std::shared_ptr<obs::ColorProperty> cast_property =
-			    std::dynamic_pointer_cast<obs::ColorProperty>(raw_property);
-			std::shared_ptr<osn::NumberProperty> pr2 = std::make_shared<osn::NumberProperty>();
-			pr2->field_type                          = osn::NumberProperty::Type(cast_property->field_type);
-			pr2->int_value.value                     = cast_property->value;
-			pr                                       = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		case obs::Property::Type::Capture: {
-			std::shared_ptr<obs::CaptureProperty> cast_property =
-			    std::dynamic_pointer_cast<obs::CaptureProperty>(raw_property);
-			std::shared_ptr<osn::NumberProperty> pr2 = std::make_shared<osn::NumberProperty>();
-			pr2->field_type                          = osn::NumberProperty::Type(cast_property->field_type);
-			pr2->int_value.value                     = cast_property->value;
-			pr                                       = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		case obs::Property::Type::Float: {
-			std::shared_ptr<obs::FloatProperty> cast_property =
-			    std::dynamic_pointer_cast<obs::FloatProperty>(raw_property);
-			std::shared_ptr<osn::NumberProperty> pr2 = std::make_shared<osn::NumberProperty>();
-			pr2->field_type                          = osn::NumberProperty::Type(cast_property->field_type);
-			pr2->float_value.min                     = cast_property->minimum;
-			pr2->float_value.max                     = cast_property->maximum;
-			pr2->float_value.step                    = cast_property->step;
-			pr2->float_value.value                   = cast_property->value;
-			pr                                       = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		case obs::Property::Type::Text: {
-			std::shared_ptr<obs::TextProperty> cast_property =
-			    std::dynamic_pointer_cast<obs::TextProperty>(raw_property);
-			std::shared_ptr<osn::TextProperty> pr2 = std::make_shared<osn::TextProperty>();
-			pr2->field_type                        = osn::TextProperty::Type(cast_property->field_type);
-			pr2->value                             = cast_property->value;
-			pr                                     = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		case obs::Property::Type::Path: {
-			std::shared_ptr<obs::PathProperty> cast_property =
-			    std::dynamic_pointer_cast<obs::PathProperty>(raw_property);
-			std::shared_ptr<osn::PathProperty> pr2 = std::make_shared<osn::PathProperty>();
-			pr2->field_type                        = osn::PathProperty::Type(cast_property->field_type);
-			pr2->filter                            = cast_property->filter;
-			pr2->default_path                      = cast_property->default_path;
-			pr2->value                             = cast_property->value;
-			pr                                     = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		case obs::Property::Type::List: {
-			std::shared_ptr<obs::ListProperty> cast_property =
-			    std::dynamic_pointer_cast<obs::ListProperty>(raw_property);
-			std::shared_ptr<osn::ListProperty> pr2 = std::make_shared<osn::ListProperty>();
-			pr2->field_type                        = osn::ListProperty::Type(cast_property->field_type);
-			pr2->item_format                       = osn::ListProperty::Format(cast_property->format);
-
-			switch (cast_property->format) {
-			case obs::ListProperty::Format::Integer:
-				pr2->current_value_int = cast_property->current_value_int;
-				break;
-			case obs::ListProperty::Format::Float:
-				pr2->current_value_float = cast_property->current_value_float;
-				break;
-			case obs::ListProperty::Format::String:
-				pr2->current_value_str = cast_property->current_value_str;
-				break;
-			}
+	conn->call("Properties", "CloseSession", {ipc::value(sdi->propertySession)});
+	sdi->propertySession   = 0;
+	sdi->propertiesChanged = true;
+}
 
-			for (auto& item : cast_property->items) {
-				osn::ListProperty::Item item2;
-				item2.name     = item.name;
-				item2.disabled = !item.enabled;
-				switch (cast_property->format) {
-				case obs::ListProperty::Format::Integer:
-					item2.value_int = item.value_int;
-					break;
-				case obs::ListProperty::Format::Float:
-					item2.value_float = item.value_float;
-					break;
-				case obs::ListProperty::Format::String:
-					item2.value_str = item.value_string;
-					break;
-				}
-				pr2->items.push_back(std::move(item2));
-			}
-			pr = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		case obs::Property::Type::Font: {
-			std::shared_ptr<obs::FontProperty> cast_property =
-			    std::dynamic_pointer_cast<obs::FontProperty>(raw_property);
-			std::shared_ptr<osn::FontProperty> pr2 = std::make_shared<osn::FontProperty>();
-			pr2->face                              = cast_property->face;
-			pr2->style                             = cast_property->style;
-			pr2->path                              = cast_property->path;
-			pr2->sizeF                             = cast_property->sizeF;
-			pr2->flags                             = cast_property->flags;
-			pr                                     = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		case obs::Property::Type::EditableList: {
-			std::shared_ptr<obs::EditableListProperty> cast_property =
-			    std::dynamic_pointer_cast<obs::EditableListProperty>(raw_property);
-			std::shared_ptr<osn::EditableListProperty> pr2 = std::make_shared<osn::EditableListProperty>();
-			pr2->field_type                                = osn::EditableListProperty::Type(cast_property->field_type);
-			pr2->filter                                    = cast_property->filter;
-			pr2->default_path                              = cast_property->default_path;
-
-			for (auto& item : cast_property->values) {
-				pr2->values.push_back(item);
-			}
-			pr = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		case obs::Property::Type::FrameRate: {
-			std::shared_ptr<obs::FrameRateProperty> cast_property =
-			    std::dynamic_pointer_cast<obs::FrameRateProperty>(raw_property);
-			std::shared_ptr<osn::ListProperty> pr2 = std::make_shared<osn::ListProperty>();
-			pr2->field_type                        = osn::ListProperty::Type::LIST;
-			pr2->item_format                       = osn::ListProperty::Format::STRING;
-
-			nlohmann::json fps;
-			fps["numerator"] = cast_property->current_numerator;
-			fps["denominator"] = cast_property->current_denominator;
-			pr2->current_value_str = fps.dump();
-
-			for (auto& option : cast_property->ranges) {
-				nlohmann::json fps;
-				fps["numerator"] = option.maximum.first;
-				fps["denominator"] = option.maximum.second;
-				osn::ListProperty::Item item2;
-				item2.name     = std::to_string(option.maximum.first / option.maximum.second);
-				item2.disabled = false;
-				item2.value_str = fps.dump();
-				pr2->items.push_back(std::move(item2));
-			}
+static bool FetchProperties(const Napi::CallbackInfo& info, uint64_t id, osn::property_set_t& set)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return false;
 
-			pr = std::static_pointer_cast<osn::Property>(pr2);
-			break;
-		}
-		default: {
-			pr = std::make_shared<osn::Property>();
-			break;
-		}
-		}
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("Source", "GetProperties", {ipc::value(id)});
+
+	if (!ValidateResponse(info, response))
+		return false;
+
+	osn::PropertySetBuilder builder;
+	for (size_t idx = 1; idx < response.size(); ++idx)
+		builder.Read(response[idx].value_bin);
+	set = builder.Build();
+	return true;
+}
+
+Napi::Value osn::ISource::GetProperties(const Napi::CallbackInfo& info, uint64_t id)
+{
+	osn::ISource* source =
+		Napi::ObjectWrap<osn::ISource>::Unwrap(info.This().ToObject());
+	if (!source)
+		return info.Env().Undefined();
+
+	SourceDataInfo* sdi =
+		CacheManager<SourceDataInfo*>::getInstance().Retrieve(id);
 
-		if (pr) {
-			pr->name             = raw_property->name;
-			pr->description      = raw_property->description;
-			pr->long_description = raw_property->long_description;
-			pr->type             = osn::Property::Type(raw_property->type());
-			if (pr->type == osn::Property::Type::FRAMERATE)
-				pr->type = osn::Property::Type::LIST;
-			pr->enabled          = raw_property->enabled;
-			pr->visible          = raw_property->visible;
-
-			pmap.emplace(idx - 1, pr);
+	// An open property session only fetches what changed, without one the
+	// whole set is read again.
+	if (sdi && sdi->propertiesChanged) {
+		if (sdi->propertySession) {
+			std::vector<ipc::value> response = CallPropertySession(info, sdi, "RefreshSession", {});
+			if (!ValidateResponse(info, response))
+				return info.Env().Undefined();
+
+			sdi->properties = ApplyPropertyChanges(sdi->properties, response, 2);
+		} else {
+			if (!FetchProperties(info, id, sdi->properties))
+				return info.Env().Undefined();
 		}
+		sdi->propertiesChanged = false;
 	}
 
+	// The snapshot is shared with the cache, never copied.
+	property_set_t set;
 	if (sdi) {
-		sdi->properties        = pmap;
-		sdi->propertiesChanged = false;
+		set = sdi->properties;
+	} else {
+		if (!FetchProperties(info, id, set))
+			return info.Env().Undefined();
 	}
-	std::shared_ptr<property_map_t> pSomeObject = std::make_shared<property_map_t>(pmap);
-	auto prop_ptr = Napi::External<property_map_t>::New(info.Env(), pSomeObject.get());
+
+	if (!set || set->properties.empty())
+		return info.Env().Null();
+
+	auto prop_ptr = Napi::External<property_set_t>::New(info.Env(), &set);
 	auto instance =
 		osn::Properties::constructor.New({
 			prop_ptr,
@@ -18,6 +18,7 @@
 
 #pragma once
 #include <napi.h>
+#include "ipc-value.hpp"
 #include "utility-v8.hpp"
 #include "properties.hpp"
 #include "obs-property.hpp"
@@ -45,8 +46,28 @@ namespace osn
 		static void Load(const Napi::CallbackInfo& info, uint64_t id);
 		static void Save(const Napi::CallbackInfo& info, uint64_t id);
 
+		// Source type catalogue, fetched once and kept until modules change.
+		// `kind` is an obs::SourceTypeEntry::Kind.
+		static Napi::Value GetTypes(const Napi::CallbackInfo& info, uint32_t kind);
+		static Napi::Value GetTypeCatalog(const Napi::CallbackInfo& info, uint32_t kind);
+		static void        InvalidateTypes();
+
 		static Napi::Value IsConfigurable(const Napi::CallbackInfo& info, uint64_t id);
 		static Napi::Value GetProperties(const Napi::CallbackInfo& info, uint64_t id);
+
+		// Property sessions, see Properties.OpenSession. They are opened by
+		// OpenPropertySession or on demand by CallPropertySession, which
+		// prepends the session id to `args`, and closed by ClosePropertySession
+		// or when the server releases the source.
+		static void OpenPropertySession(const Napi::CallbackInfo& info, uint64_t id);
+		static void ClosePropertySession(const Napi::CallbackInfo& info, uint64_t id);
+		static property_set_t
+		    ApplyPropertyChanges(const property_set_t& current, const std::vector<ipc::value>& response, size_t first);
+		static std::vector<ipc::value> CallPropertySession(
+		    const Napi::CallbackInfo& info,
+		    SourceDataInfo*           sdi,
+		    const std::string&        function,
+		    std::vector<ipc::value>   args);
 		static Napi::Value GetSettings(const Napi::CallbackInfo& info, uint64_t id);
 
 		static Napi::Value GetType(const Napi::CallbackInfo& info, uint64_t id);
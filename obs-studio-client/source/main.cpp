@@ -22,6 +22,7 @@
 
 #include <fstream>
 #include <string>
+#include "collection.hpp"
 #include "controller.hpp"
 #include "fader.hpp"
 #include "filter.hpp"
@@ -103,6 +104,7 @@ Napi::Object main_node(Napi::Env env, Napi::Object exports) {
 	osn::Transition::Init(env, exports);
 	osn::Module::Init(env, exports);
 	osn::Video::Init(env, exports);
+	osn::Collection::Init(env, exports);
 	osn::Volmeter::Init(env, exports);
 	settings::Init(env, exports);
 	display::Init(env, exports);
@@ -22,6 +22,7 @@
 #include "controller.hpp"
 #include "error.hpp"
 #include "ipc-value.hpp"
+#include "isource.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
 #include "module.hpp"
@@ -120,6 +121,9 @@ Napi::Value osn::Module::Initialize(const Napi::CallbackInfo& info)
 	std::vector<ipc::value> response =
 	    conn->call_synchronous_helper("Module", "Initialize", {ipc::value(this->moduleId)});
 
+	// The module may have registered new source types.
+	osn::ISource::InvalidateTypes();
+
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
 
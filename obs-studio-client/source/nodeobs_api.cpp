@@ -18,11 +18,13 @@
 
 #include "controller.hpp"
 #include "error.hpp"
+#include "isource.hpp"
 #include "nodeobs_api.hpp"
 #include <sstream>
 #include <string>
 #include "shared.hpp"
 #include "utility.hpp"
+#include "video.hpp"
 #include "volmeter.hpp"
 #include "callback-manager.hpp"
 
@@ -52,6 +54,10 @@ Napi::Value api::OBS_API_initAPI(const Napi::CallbackInfo& info)
 	std::vector<ipc::value> response = conn->call_synchronous_helper(
 	    "API", "OBS_API_initAPI", {ipc::value(path), ipc::value(language), ipc::value(version), ipc::value(crashserverurl)});
 
+	// A fresh server loaded its modules and publishes a new stats page.
+	osn::ISource::InvalidateTypes();
+	osn::Video::CloseFrameStats();
+
 	// The API init method will return a response error + graphical error
 	// If there is a problem with the IPC the number of responses here will be zero so we must validate the
 	// response.
@@ -73,6 +79,7 @@ Napi::Value api::OBS_API_destroyOBS_API(const Napi::CallbackInfo& info)
 		return info.Env().Undefined();
 
 	conn->call("API", "OBS_API_destroyOBS_API", {});
+	osn::Video::CloseFrameStats();
 
 #ifdef __APPLE__
 	if (js_thread)
@@ -170,6 +177,26 @@ Napi::Value api::InitShutdownSequence(const Napi::CallbackInfo& info)
 	return info.Env().Undefined();
 }
 
+Napi::Value api::SetShutdownGracePeriod(const Napi::CallbackInfo& info)
+{
+	if (info.Length() < 1 || !info[0].IsNumber()) {
+		Napi::Error::New(info.Env(), "Argument 'milliseconds' must be of type 'Number'.").ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+	uint32_t milliseconds = info[0].ToNumber().Uint32Value();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("System", "SetShutdownGracePeriod", {ipc::value(milliseconds)});
+
+	ValidateResponse(info, response);
+
+	return info.Env().Undefined();
+}
+
 Napi::Value api::OBS_API_QueryHotkeys(const Napi::CallbackInfo& info)
 {
 	auto conn = GetConnection(info);
@@ -322,6 +349,7 @@ void api::Init(Napi::Env env, Napi::Object exports)
 	exports.Set(Napi::String::New(env, "OBS_API_getPerformanceStatistics"), Napi::Function::New(env, api::OBS_API_getPerformanceStatistics));
 	exports.Set(Napi::String::New(env, "SetWorkingDirectory"), Napi::Function::New(env, api::SetWorkingDirectory));
 	exports.Set(Napi::String::New(env, "InitShutdownSequence"), Napi::Function::New(env, api::InitShutdownSequence));
+	exports.Set(Napi::String::New(env, "SetShutdownGracePeriod"), Napi::Function::New(env, api::SetShutdownGracePeriod));
 	exports.Set(Napi::String::New(env, "OBS_API_QueryHotkeys"), Napi::Function::New(env, api::OBS_API_QueryHotkeys));
 	exports.Set(Napi::String::New(env, "OBS_API_ProcessHotkeyStatus"), Napi::Function::New(env, api::OBS_API_ProcessHotkeyStatus));
 	exports.Set(Napi::String::New(env, "SetUsername"), Napi::Function::New(env, api::SetUsername));
@@ -36,6 +36,7 @@ namespace api
 	Napi::Value OBS_API_getPerformanceStatistics(const Napi::CallbackInfo& info);
 	Napi::Value SetWorkingDirectory(const Napi::CallbackInfo& info);
 	Napi::Value InitShutdownSequence(const Napi::CallbackInfo& info);
+	Napi::Value SetShutdownGracePeriod(const Napi::CallbackInfo& info);
 	Napi::Value OBS_API_QueryHotkeys(const Napi::CallbackInfo& info);
 	Napi::Value OBS_API_ProcessHotkeyStatus(const Napi::CallbackInfo& info);
 	Napi::Value SetUsername(const Napi::CallbackInfo& info);
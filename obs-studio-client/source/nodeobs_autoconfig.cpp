@@ -41,7 +41,7 @@ void autoConfig::worker()
 	while (!worker_stop) {
 		auto tp_start = std::chrono::high_resolution_clock::now();
 
-		auto conn = Controller::GetInstance().GetConnection();
+		auto conn = Controller::GetInstance().GetQueryConnection();
 		if (!conn) {
 			goto do_sleep;
 		}
@@ -21,9 +21,11 @@
 #include "error.hpp"
 #include "utility-v8.hpp"
 
+#include <map>
 #include <node.h>
 #include <sstream>
 #include <string>
+#include "obs-window.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
 #include "callback-manager.hpp"
@@ -77,37 +79,110 @@ Napi::Value display::OBS_content_createDisplay(const Napi::CallbackInfo& info)
 	return info.Env().Undefined();
 }
 
+// Thumbnails handed out by the last refresh, by window id. Unchanged
+// windows reuse their Buffer instead of receiving the image again. The
+// references are dropped by an env cleanup hook, see display::Init, as
+// they can't be deleted once the env is gone at process exit.
+struct WindowThumbEntry
+{
+	uint64_t                            hash   = 0;
+	uint32_t                            width  = 0;
+	uint32_t                            height = 0;
+	uint32_t                            format = 0;
+	Napi::Reference<Napi::Buffer<char>> image;
+};
+static std::map<int64_t, WindowThumbEntry> window_thumbs;
+
 Napi::Value display::LONGISLAND_content_getWindowThumbs(const Napi::CallbackInfo& info)
 {
-//	Napi::Buffer<void *> bufferData = ;
-	std::string windowIds= info[0].ToString().Utf8Value();
+	std::string windowIds = info[0].ToString().Utf8Value();
+
+	// Optional { width, height, format }: thumbnails are scaled down to fit
+	// and encoded as obs::ThumbFormat, by default they come as captured.
+	uint32_t maxWidth = 0, maxHeight = 0, format = 0;
+	if (info.Length() > 1 && info[1].IsObject()) {
+		Napi::Object options = info[1].ToObject();
+		if (options.Get("width").IsNumber())
+			maxWidth = options.Get("width").ToNumber().Uint32Value();
+		if (options.Get("height").IsNumber())
+			maxHeight = options.Get("height").ToNumber().Uint32Value();
+		if (options.Get("format").IsNumber())
+			format = options.Get("format").ToNumber().Uint32Value();
+	}
 
 	auto conn = GetConnection(info);
 	if (!conn)
 		return info.Env().Undefined();
 
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Display", "LONGISLAND_content_getWindowThumbs", {ipc::value(windowIds)});
+	std::vector<obs::WindowThumbKnown> known;
+	known.reserve(window_thumbs.size());
+	for (auto& entry : window_thumbs)
+		known.push_back({entry.first, entry.second.hash});
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper(
+	    "Display",
+	    "LONGISLAND_content_getWindowThumbs",
+	    {ipc::value(windowIds),
+	     ipc::value(obs::serialize_list(known)),
+	     ipc::value(maxWidth),
+	     ipc::value(maxHeight),
+	     ipc::value(format)});
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
 
-	uint64_t items = response[1].value_union.ui64;
-
-	Napi::Array devices = Napi::Array::New(info.Env());
-
-	uint32_t js_array_index = 0;
-	//	uint64_t items = response[1].value_union.ui64;
-	if (items > 0) {
-		for (uint64_t idx = 2; idx < items * 4 + 2; idx += 4) {
-			Napi::Object device = Napi::Object::New(info.Env());
-			std::string des_str = response[idx].value_str;
-			device.Set("id", Napi::String::New(info.Env(), response[idx].value_str.c_str()));
-			device.Set("width", Napi::String::New(info.Env(), response[idx + 1].value_str.c_str()));
-			device.Set("height", Napi::String::New(info.Env(), response[idx + 2].value_str.c_str()));
-			device.Set("base64", Napi::String::New(info.Env(), response[idx + 3].value_str.c_str()));
-			devices.Set(js_array_index++, device);
+	std::vector<obs::WindowThumb> headers;
+	if (response.size() < 2 || !obs::read_list(response[1].value_bin, headers)) {
+		Napi::Error::New(info.Env(), "Malformed window thumbnail response").ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+
+	std::map<int64_t, WindowThumbEntry> refreshed;
+	Napi::Array                          devices = Napi::Array::New(info.Env(), headers.size());
+	size_t                               next    = 2;
+	for (size_t idx = 0; idx < headers.size(); idx++) {
+		const obs::WindowThumb& header = headers[idx];
+		WindowThumbEntry&       entry  = refreshed[header.window_id];
+		auto                    cached = window_thumbs.find(header.window_id);
+
+		if (header.changed || cached == window_thumbs.end()) {
+			if (next >= response.size()) {
+				Napi::Error::New(info.Env(), "Malformed window thumbnail response").ThrowAsJavaScriptException();
+				return info.Env().Undefined();
+			}
+
+			// Hand the received bytes to the Buffer as they are, it frees
+			// them once collected.
+			auto*              bytes = new std::vector<char>(std::move(response[next++].value_bin));
+			Napi::Buffer<char> image = Napi::Buffer<char>::New(
+			    info.Env(),
+			    bytes->data(),
+			    bytes->size(),
+			    [](Napi::Env, char*, std::vector<char>* hint) { delete hint; },
+			    bytes);
+			entry.image  = Napi::Persistent(image);
+			entry.width  = header.width;
+			entry.height = header.height;
+			entry.format = header.format;
+		} else {
+			// The header of an unchanged window describes the capture, the
+			// reused image keeps the size and format it was encoded with.
+			entry = std::move(cached->second);
 		}
+		entry.hash = header.hash;
+
+		Napi::Object device = Napi::Object::New(info.Env());
+		device.Set("id", Napi::String::New(info.Env(), std::to_string(header.window_id)));
+		device.Set("width", Napi::Number::New(info.Env(), entry.width));
+		device.Set("height", Napi::Number::New(info.Env(), entry.height));
+		device.Set("format", Napi::Number::New(info.Env(), entry.format));
+		device.Set("image", entry.image.Value());
+		device.Set("changed", Napi::Boolean::New(info.Env(), header.changed != 0));
+		devices.Set(uint32_t(idx), device);
 	}
+
+	// Windows that are gone, or were not asked for, drop out of the cache.
+	window_thumbs = std::move(refreshed);
 	return devices;
 }
 
@@ -317,6 +392,8 @@ Napi::Value display::OBS_content_createIOSurface(const Napi::CallbackInfo& info)
 
 void display::Init(Napi::Env env, Napi::Object exports)
 {
+	napi_add_env_cleanup_hook(env, [](void*) { window_thumbs.clear(); }, nullptr);
+
 	exports.Set(
 		Napi::String::New(env, "OBS_content_createDisplay"),
 		Napi::Function::New(env, display::OBS_content_createDisplay));
@@ -51,6 +51,8 @@ void service::start_worker(napi_env env, Napi::Function async_callback)
 		0,
 		1,
 		[]( Napi::Env ) {} );
+	// Subscribe before polling so no signal raised in between is missed.
+	Controller::GetInstance().GetEventSubscriber();
 	worker_thread = new std::thread(&service::worker);
 }
 
@@ -240,9 +242,10 @@ void service::worker()
 		auto tp_start = std::chrono::high_resolution_clock::now();
 
 		// Validate Connection
-		auto conn = Controller::GetInstance().GetConnection();
+		auto conn = Controller::GetInstance().GetQueryConnection();
 		if (conn) {
-			std::vector<ipc::value> response = conn->call_synchronous_helper("Service", "Query", {});
+			std::vector<ipc::value> response = conn->call_synchronous_helper(
+			    "Service", "Query", {ipc::value(Controller::GetInstance().GetEventSubscriber())});
 			if (response.size() && (response.size() == 5) && signalsList.size() < maximum_signals_in_queue) {
 				ErrorCode error = (ErrorCode)response[0].value_union.ui64;
 				if (error == ErrorCode::Ok) {
@@ -19,8 +19,12 @@
 #include "nodeobs_settings.hpp"
 #include "controller.hpp"
 #include "error.hpp"
+#include "obs-string-table.hpp"
+#include "obs-window.hpp"
+#include "object-shapes.hpp"
 #include "utility-v8.hpp"
 
+#include <map>
 #include <node.h>
 #include <sstream>
 #include <string>
@@ -510,40 +514,107 @@ Napi::Value settings::OBS_settings_getVideoDevices(const Napi::CallbackInfo& inf
 	return devices_to_js(info, response);
 }
 
-Napi::Value settings::LONGISLAND_settings_getWindowLists(const Napi::CallbackInfo& info)
+static Napi::Value window_string(
+    Napi::Env                         env,
+    const std::vector<char>&          strings,
+    uint32_t                          offset,
+    std::map<uint32_t, Napi::String>& interned)
+{
+	auto found = interned.find(offset);
+	if (found != interned.end())
+		return found->second;
+
+	Napi::String string = Napi::String::New(env, obs::StringTable::read(strings, offset));
+	interned.emplace(offset, string);
+	return string;
+}
+
+static const utilv8::ObjectShape window_shape(
+    {"id", "window_name", "owner_name", "owner_pid", "pos_x", "pos_y", "width", "height"});
+static const utilv8::ObjectShape changed_window_shape(
+    {"id", "change", "window_name", "owner_name", "owner_pid", "pos_x", "pos_y", "width", "height"});
+static const utilv8::ObjectShape closed_window_shape({"id", "change"});
+static const utilv8::ObjectShape window_changes_shape({"revision", "full", "windows"});
+
+static Napi::Value windows_to_js(const Napi::CallbackInfo& info, uint64_t known_revision, bool changes)
 {
 	auto conn = GetConnection(info);
 	if (!conn)
 		return info.Env().Undefined();
 
-	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Settings", "LONGISLAND_settings_getWindowLists", {});
+	std::vector<ipc::value> response = conn->call_synchronous_helper(
+	    "Settings", "LONGISLAND_settings_getWindowLists", {ipc::value(known_revision)});
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
 
-	uint64_t items = response[1].value_union.ui64;
-
-	Napi::Array devices = Napi::Array::New(info.Env());
-
-	uint32_t js_array_index = 0;
-//	uint64_t items = response[1].value_union.ui64;
-	if (items > 0) {
-		for (uint64_t idx = 2; idx < items * 7 + 2; idx += 7) {
-			Napi::Object device = Napi::Object::New(info.Env());
-
-			std::string des_str = response[idx].value_str;
-			device.Set("window_name", Napi::String::New(info.Env(), response[idx].value_str.c_str()));
-			device.Set("id", Napi::String::New(info.Env(), response[idx + 1].value_str.c_str()));
-			device.Set("pos_x", Napi::String::New(info.Env(), response[idx + 2].value_str.c_str()));
-			device.Set("pos_y", Napi::String::New(info.Env(), response[idx + 3].value_str.c_str()));
-			device.Set("width", Napi::String::New(info.Env(), response[idx + 4].value_str.c_str()));
-			device.Set("height", Napi::String::New(info.Env(), response[idx + 5].value_str.c_str()));
-			device.Set("owner_name", Napi::String::New(info.Env(), response[idx + 6].value_str.c_str()));
-			devices.Set(js_array_index++, device);
+	std::vector<obs::WindowEntry> entries;
+	if (response.size() < 5 || !obs::read_list(response[3].value_bin, entries)) {
+		Napi::Error::New(info.Env(), "Malformed window list response").ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+	const std::vector<char>& strings = response[4].value_bin;
+
+	// Most windows share their owner name, create each string once.
+	Napi::Env                        env = info.Env();
+	std::map<uint32_t, Napi::String> interned;
+	Napi::Array                      windows = Napi::Array::New(env, entries.size());
+	for (size_t idx = 0; idx < entries.size(); idx++) {
+		const obs::WindowEntry& entry = entries[idx];
+		Napi::Value             id    = Napi::Number::New(env, double(entry.window_id));
+		Napi::Object            window;
+		if (entry.change & obs::WindowEntry::Closed) {
+			window = closed_window_shape.New(env, {id, Napi::Number::New(env, entry.change)});
+		} else {
+			Napi::Value window_name = window_string(env, strings, entry.window_name, interned);
+			Napi::Value owner_name  = window_string(env, strings, entry.owner_name, interned);
+			Napi::Value owner_pid   = Napi::Number::New(env, double(entry.owner_pid));
+			Napi::Value pos_x       = Napi::Number::New(env, entry.x);
+			Napi::Value pos_y       = Napi::Number::New(env, entry.y);
+			Napi::Value width       = Napi::Number::New(env, entry.width);
+			Napi::Value height      = Napi::Number::New(env, entry.height);
+			if (changes) {
+				window = changed_window_shape.New(
+				    env,
+				    {id,
+				     Napi::Number::New(env, entry.change),
+				     window_name,
+				     owner_name,
+				     owner_pid,
+				     pos_x,
+				     pos_y,
+				     width,
+				     height});
+			} else {
+				window = window_shape.New(
+				    env, {id, window_name, owner_name, owner_pid, pos_x, pos_y, width, height});
+			}
 		}
+		windows.Set(uint32_t(idx), window);
 	}
-	return devices;
+
+	if (!changes)
+		return windows;
+
+	return window_changes_shape.New(
+	    env,
+	    {Napi::Number::New(env, double(response[1].value_union.ui64)),
+	     Napi::Boolean::New(env, response[2].value_union.ui32 != 0),
+	     windows});
+}
+
+Napi::Value settings::LONGISLAND_settings_getWindowLists(const Napi::CallbackInfo& info)
+{
+	return windows_to_js(info, 0, false);
+}
+
+Napi::Value settings::LONGISLAND_settings_getWindowChanges(const Napi::CallbackInfo& info)
+{
+	uint64_t revision = 0;
+	if (info.Length() > 0 && info[0].IsNumber())
+		revision = uint64_t(info[0].ToNumber().Int64Value());
+
+	return windows_to_js(info, revision, true);
 }
 
 void settings::Init(Napi::Env env, Napi::Object exports)
@@ -576,4 +647,8 @@ void settings::Init(Napi::Env env, Napi::Object exports)
 	    Napi::String::New(env, "LONGISLAND_settings_getWindowLists"),
 	    Napi::Function::New(env, settings::LONGISLAND_settings_getWindowLists)
 	);
+	exports.Set(
+	    Napi::String::New(env, "LONGISLAND_settings_getWindowChanges"),
+	    Napi::Function::New(env, settings::LONGISLAND_settings_getWindowChanges)
+	);
 }
\ No newline at end of file
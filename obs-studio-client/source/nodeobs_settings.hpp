@@ -143,6 +143,9 @@ namespace settings
 	Napi::Value OBS_settings_getOutputAudioDevices(const Napi::CallbackInfo& info);
 	Napi::Value OBS_settings_getVideoDevices(const Napi::CallbackInfo& info);
 	Napi::Value LONGISLAND_settings_getWindowLists(const Napi::CallbackInfo& info);
+	// Windows opened, closed, moved or renamed since `revision`. Revision 0
+	// or one the server no longer keeps answers with the full list.
+	Napi::Value LONGISLAND_settings_getWindowChanges(const Napi::CallbackInfo& info);
 
 
 	static std::vector<std::string> getListCategories(void);
@@ -0,0 +1,119 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "object-shapes.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <unordered_map>
+
+namespace
+{
+	// Keys live as elements of one persistent array, N-API can't hold a
+	// reference to a string before version 9. Shapes keep the element index
+	// of each of their fields.
+	struct InternedKeys
+	{
+		Napi::ObjectReference                     strings;
+		std::unordered_map<const char*, uint32_t> index;
+		std::vector<std::vector<uint32_t>>        shapes;
+		Napi::FunctionReference                   freeze;
+	};
+
+	InternedKeys& interned_keys(Napi::Env env)
+	{
+		InternedKeys* keys = env.GetInstanceData<InternedKeys>();
+		if (!keys) {
+			keys          = new InternedKeys;
+			keys->strings = Napi::Persistent(Napi::Object(Napi::Array::New(env)));
+			env.SetInstanceData(keys);
+		}
+		return *keys;
+	}
+
+	uint32_t intern(Napi::Env env, InternedKeys& keys, const char* name)
+	{
+		auto found = keys.index.find(name);
+		if (found != keys.index.end())
+			return found->second;
+
+		uint32_t idx = uint32_t(keys.index.size());
+		keys.strings.Value().Set(idx, Napi::String::New(env, name));
+		keys.index.emplace(name, idx);
+		return idx;
+	}
+
+	size_t next_shape_id()
+	{
+		static std::atomic<size_t> next{0};
+		return next++;
+	}
+} // namespace
+
+Napi::Value utilv8::Key(Napi::Env env, const char* name)
+{
+	InternedKeys& keys = interned_keys(env);
+	uint32_t      idx  = intern(env, keys, name);
+	return keys.strings.Value().Get(idx);
+}
+
+void utilv8::Freeze(Napi::Env env, Napi::Object object)
+{
+	InternedKeys& keys = interned_keys(env);
+	if (keys.freeze.IsEmpty())
+		keys.freeze = Napi::Persistent(env.Global().Get("Object").As<Napi::Object>().Get("freeze").As<Napi::Function>());
+
+	keys.freeze.Call({object});
+}
+
+utilv8::ObjectShape::ObjectShape(std::initializer_list<const char*> fields) : id(next_shape_id()), fields(fields)
+{
+	assert(fields.size() <= max_fields);
+}
+
+Napi::Object utilv8::ObjectShape::New(Napi::Env env, std::initializer_list<napi_value> values) const
+{
+	InternedKeys& keys = interned_keys(env);
+	if (keys.shapes.size() <= id)
+		keys.shapes.resize(id + 1);
+
+	std::vector<uint32_t>& indices = keys.shapes[id];
+	if (indices.empty()) {
+		for (const char* field : fields)
+			indices.push_back(intern(env, keys, field));
+	}
+
+	Napi::Object strings = keys.strings.Value();
+	size_t       count   = std::min(std::min(indices.size(), values.size()), max_fields);
+
+	napi_property_descriptor descriptors[max_fields];
+	const napi_value*        value = values.begin();
+	for (size_t i = 0; i < count; i++) {
+		descriptors[i]            = napi_property_descriptor{};
+		descriptors[i].name       = strings.Get(indices[i]);
+		descriptors[i].value      = value[i];
+		descriptors[i].attributes = napi_property_attributes(napi_writable | napi_enumerable | napi_configurable);
+	}
+
+	napi_value  object;
+	napi_status status = napi_create_object(env, &object);
+	NAPI_THROW_IF_FAILED(env, status, Napi::Object());
+	status = napi_define_properties(env, object, count, descriptors);
+	NAPI_THROW_IF_FAILED(env, status, Napi::Object());
+	return Napi::Object(env, object);
+}
@@ -0,0 +1,54 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <initializer_list>
+#include <napi.h>
+#include <vector>
+
+namespace utilv8
+{
+	// Property name interned for the env, created once and reused instead of
+	// a new string for every field of every object. Names are looked up by
+	// address, pass string literals only. The cache is the instance data of
+	// the env.
+	Napi::Value Key(Napi::Env env, const char* name);
+
+	// Object.freeze, napi_object_freeze needs N-API 8. The function is looked
+	// up once per env.
+	void Freeze(Napi::Env env, Napi::Object object);
+
+	// Fixed fields of an object type returned on hot paths, the N-API
+	// counterpart of an object template. New() creates the object with all
+	// fields in one napi_define_properties call, in the same order and with
+	// interned keys, so every instance ends up with the same hidden class.
+	class ObjectShape
+	{
+		public:
+		static const size_t max_fields = 16;
+
+		ObjectShape(std::initializer_list<const char*> fields);
+
+		// `values` are given in field order, missing ones are left out.
+		Napi::Object New(Napi::Env env, std::initializer_list<napi_value> values) const;
+
+		private:
+		size_t                   id;
+		std::vector<const char*> fields;
+	};
+} // namespace utilv8
@@ -17,13 +17,277 @@
 ******************************************************************************/
 
 #include "properties.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cstring>
 #include "isource.hpp"
+#include "obs-property.hpp"
+#include "object-shapes.hpp"
 #include "utility-v8.hpp"
+#include "nlohmann/json.hpp"
+
+static const utilv8::ObjectShape list_item_shape({"name", "enabled", "value"});
+static const utilv8::ObjectShape list_page_shape({"total", "items"});
+static const utilv8::ObjectShape editable_item_shape({"value"});
+static const utilv8::ObjectShape font_shape({"face", "style", "path", "size", "flags"});
+static const utilv8::ObjectShape number_details_shape({"type", "min", "max", "step"});
+static const utilv8::ObjectShape text_details_shape({"type"});
+static const utilv8::ObjectShape path_details_shape({"type", "filter", "defaultPath"});
+static const utilv8::ObjectShape list_details_shape({"type", "format", "itemCount", "items"});
+
+const osn::Property* osn::PropertySet::find(const char* name) const
+{
+	for (auto& prop : properties) {
+		if (strcmp(string(prop.name), name) == 0)
+			return &prop;
+	}
+	return nullptr;
+}
 
-std::shared_ptr<osn::property_map_t> osn::Properties::GetProperties()
+bool osn::PropertySetBuilder::Read(const std::vector<char>& buf)
+{
+	auto raw_property = obs::Property::deserialize(buf);
+	if (!raw_property)
+		return false;
+
+	// The concrete type always matches type(), so no dynamic casts are needed.
+	osn::Property prop;
+	prop.type             = osn::Property::Type(raw_property->type());
+	prop.name             = strings.intern(raw_property->name);
+	prop.description      = strings.intern(raw_property->description);
+	prop.long_description = strings.intern(raw_property->long_description);
+	prop.enabled          = raw_property->enabled;
+	prop.visible          = raw_property->visible;
+
+	switch (raw_property->type()) {
+	case obs::Property::Type::Boolean: {
+		auto cast_property = std::static_pointer_cast<obs::BooleanProperty>(raw_property);
+		prop.number.bool_value.value = cast_property->value;
+		break;
+	}
+	case obs::Property::Type::Integer: {
+		auto cast_property = std::static_pointer_cast<obs::IntegerProperty>(raw_property);
+		prop.field_type              = uint32_t(cast_property->field_type);
+		prop.number.int_value.min    = cast_property->minimum;
+		prop.number.int_value.max    = cast_property->maximum;
+		prop.number.int_value.step   = cast_property->step;
+		prop.number.int_value.value  = cast_property->value;
+		break;
+	}
+	case obs::Property::Type::Color: {
+		auto cast_property = std::static_pointer_cast<obs::ColorProperty>(raw_property);
+		prop.field_type             = uint32_t(cast_property->field_type);
+		prop.number.int_value.value = cast_property->value;
+		break;
+	}
+	case obs::Property::Type::Capture: {
+		auto cast_property = std::static_pointer_cast<obs::CaptureProperty>(raw_property);
+		prop.field_type             = uint32_t(cast_property->field_type);
+		prop.number.int_value.value = cast_property->value;
+		break;
+	}
+	case obs::Property::Type::Float: {
+		auto cast_property = std::static_pointer_cast<obs::FloatProperty>(raw_property);
+		prop.field_type               = uint32_t(cast_property->field_type);
+		prop.number.float_value.min   = cast_property->minimum;
+		prop.number.float_value.max   = cast_property->maximum;
+		prop.number.float_value.step  = cast_property->step;
+		prop.number.float_value.value = cast_property->value;
+		break;
+	}
+	case obs::Property::Type::Text: {
+		auto cast_property = std::static_pointer_cast<obs::TextProperty>(raw_property);
+		prop.field_type = uint32_t(cast_property->field_type);
+		prop.value_str  = strings.intern(cast_property->value);
+		break;
+	}
+	case obs::Property::Type::Path: {
+		auto cast_property = std::static_pointer_cast<obs::PathProperty>(raw_property);
+		prop.field_type   = uint32_t(cast_property->field_type);
+		prop.filter       = strings.intern(cast_property->filter);
+		prop.default_path = strings.intern(cast_property->default_path);
+		prop.value_str    = strings.intern(cast_property->value);
+		break;
+	}
+	case obs::Property::Type::List: {
+		auto cast_property = std::static_pointer_cast<obs::ListProperty>(raw_property);
+		prop.field_type     = uint32_t(cast_property->field_type);
+		prop.item_format    = uint32_t(cast_property->format);
+		prop.item_count     = cast_property->item_count;
+		prop.items_deferred = cast_property->items_deferred;
+
+		switch (cast_property->format) {
+		case obs::ListProperty::Format::Integer:
+			prop.number.int_value.value = cast_property->current_value_int;
+			break;
+		case obs::ListProperty::Format::Float:
+			prop.number.float_value.value = cast_property->current_value_float;
+			break;
+		case obs::ListProperty::Format::String:
+			prop.value_str = strings.intern(cast_property->current_value_str);
+			break;
+		}
+
+		prop.first_item = uint32_t(result.items.size());
+		for (auto& item : cast_property->items) {
+			osn::PropertyItem item2;
+			item2.name      = strings.intern(item.name);
+			item2.disabled  = !item.enabled;
+			item2.value_int = 0;
+			switch (cast_property->format) {
+			case obs::ListProperty::Format::Integer:
+				item2.value_int = item.value_int;
+				break;
+			case obs::ListProperty::Format::Float:
+				item2.value_float = item.value_float;
+				break;
+			case obs::ListProperty::Format::String:
+				item2.value_str = strings.intern(item.value_string);
+				break;
+			}
+			result.items.push_back(item2);
+		}
+		prop.items = uint32_t(result.items.size()) - prop.first_item;
+		break;
+	}
+	case obs::Property::Type::Font: {
+		auto cast_property = std::static_pointer_cast<obs::FontProperty>(raw_property);
+		prop.value_str    = strings.intern(cast_property->face);
+		prop.filter       = strings.intern(cast_property->style);
+		prop.default_path = strings.intern(cast_property->path);
+		prop.font_size    = cast_property->sizeF;
+		prop.font_flags   = cast_property->flags;
+		break;
+	}
+	case obs::Property::Type::EditableList: {
+		auto cast_property = std::static_pointer_cast<obs::EditableListProperty>(raw_property);
+		prop.field_type   = uint32_t(cast_property->field_type);
+		prop.filter       = strings.intern(cast_property->filter);
+		prop.default_path = strings.intern(cast_property->default_path);
+
+		prop.first_item = uint32_t(result.items.size());
+		for (auto& value : cast_property->values) {
+			osn::PropertyItem item2;
+			item2.name      = strings.intern(value);
+			item2.value_int = 0;
+			item2.value_str = item2.name;
+			result.items.push_back(item2);
+		}
+		prop.items      = uint32_t(result.items.size()) - prop.first_item;
+		prop.item_count = prop.items;
+		break;
+	}
+	case obs::Property::Type::FrameRate: {
+		// Frame rates are shown as a list of strings holding the fraction as JSON.
+		auto cast_property = std::static_pointer_cast<obs::FrameRateProperty>(raw_property);
+		prop.type        = osn::Property::Type::LIST;
+		prop.field_type  = uint32_t(obs::ListProperty::ListType::List);
+		prop.item_format = uint32_t(osn::PropertyItem::Format::STRING);
+
+		nlohmann::json fps;
+		fps["numerator"]   = cast_property->current_numerator;
+		fps["denominator"] = cast_property->current_denominator;
+		prop.value_str     = strings.intern(fps.dump());
+
+		prop.first_item = uint32_t(result.items.size());
+		for (auto& option : cast_property->ranges) {
+			nlohmann::json fps;
+			fps["numerator"]   = option.maximum.first;
+			fps["denominator"] = option.maximum.second;
+			osn::PropertyItem item2;
+			item2.name      = strings.intern(std::to_string(option.maximum.first / option.maximum.second));
+			item2.value_int = 0;
+			item2.value_str = strings.intern(fps.dump());
+			result.items.push_back(item2);
+		}
+		prop.items      = uint32_t(result.items.size()) - prop.first_item;
+		prop.item_count = prop.items;
+		break;
+	}
+	default:
+		break;
+	}
+
+	result.properties.push_back(prop);
+	return true;
+}
+
+uint32_t osn::PropertySetBuilder::CopyString(const PropertySet& set, uint32_t offset)
+{
+	return offset == 0 ? 0 : strings.intern(set.string(offset));
+}
+
+void osn::PropertySetBuilder::Copy(const PropertySet& set, const Property& prop, const PropertySet* items_from)
+{
+	osn::Property copy    = prop;
+	copy.name             = CopyString(set, prop.name);
+	copy.description      = CopyString(set, prop.description);
+	copy.long_description = CopyString(set, prop.long_description);
+	copy.value_str        = CopyString(set, prop.value_str);
+	copy.filter           = CopyString(set, prop.filter);
+	copy.default_path     = CopyString(set, prop.default_path);
+
+	const PropertySet& owner = items_from ? *items_from : set;
+	const Property&    range = items_from ? items_from->properties.front() : prop;
+	copy.first_item          = uint32_t(result.items.size());
+	for (uint32_t idx = 0; idx < range.items; idx++) {
+		osn::PropertyItem item = owner.items[range.first_item + idx];
+		item.name              = CopyString(owner, item.name);
+		item.value_str         = CopyString(owner, item.value_str);
+		result.items.push_back(item);
+	}
+	copy.items = range.items;
+	if (items_from)
+		copy.items_deferred = false;
+
+	result.properties.push_back(copy);
+}
+
+osn::property_set_t osn::PropertySetBuilder::Build()
+{
+	result.strings = std::move(strings.data);
+	auto set       = std::make_shared<const PropertySet>(std::move(result));
+
+	result  = PropertySet();
+	strings = obs::StringTable();
+	return set;
+}
+
+osn::property_set_t osn::Properties::GetProperties()
 {
 	return properties;
 }
+
+void osn::Properties::SetProperties(property_set_t set)
+{
+	properties = std::move(set);
+	generation++;
+	wrappers.clear();
+}
+
+Napi::Value osn::Properties::Wrap(Napi::Env env, size_t index)
+{
+	if (!properties || index >= properties->properties.size())
+		return env.Undefined();
+
+	if (wrappers.size() < properties->properties.size())
+		wrappers.resize(properties->properties.size());
+
+	Napi::ObjectReference& wrapper = wrappers[index];
+	if (!wrapper.IsEmpty()) {
+		Napi::Object existing = wrapper.Value();
+		if (!existing.IsEmpty())
+			return existing;
+	}
+
+	Napi::Object instance =
+		osn::PropertyObject::constructor.New({
+			Value(), Napi::Number::New(env, (uint32_t)index)
+			});
+	wrapper = Napi::Weak(instance);
+	return instance;
+}
+
 Napi::FunctionReference osn::Properties::constructor;
 
 Napi::Object osn::Properties::Init(Napi::Env env, Napi::Object exports) {
@@ -47,7 +311,7 @@ osn::Properties::Properties(const Napi::CallbackInfo& info)
     : Napi::ObjectWrap<osn::Properties>(info) {
     Napi::Env env = info.Env();
     Napi::HandleScope scope(env);
-	this->properties = std::make_shared<property_map_t>(*info[0].As<const Napi::External<property_map_t>>().Data());
+	this->properties = *info[0].As<const Napi::External<property_set_t>>().Data();
 	this->sourceId = (uint64_t)info[1].ToNumber().Uint32Value();
 }
 
@@ -58,7 +322,7 @@ Napi::Value osn::Properties::Count(const Napi::CallbackInfo& info)
 	if (!obj)
 		return info.Env().Undefined();
 
-	return Napi::Number::New(info.Env(), (uint32_t)obj->properties->size());
+	return Napi::Number::New(info.Env(), (uint32_t)(obj->properties ? obj->properties->properties.size() : 0));
 }
 
 Napi::Value osn::Properties::First(const Napi::CallbackInfo& info)
@@ -68,15 +332,7 @@ Napi::Value osn::Properties::First(const Napi::CallbackInfo& info)
 	if (!obj)
 		return info.Env().Undefined();
 
-	if (obj->properties->size() == 0)
-		return info.Env().Undefined();
-
-	auto iter = obj->properties->begin();
-	auto instance =
-		osn::PropertyObject::constructor.New({
-			info.This(), Napi::Number::New(info.Env(), (uint32_t)iter->first)
-			});
-	return instance;
+	return obj->Wrap(info.Env(), 0);
 }
 
 Napi::Value osn::Properties::Last(const Napi::CallbackInfo& info)
@@ -86,15 +342,10 @@ Napi::Value osn::Properties::Last(const Napi::CallbackInfo& info)
 	if (!obj)
 		return info.Env().Undefined();
 
-	if (obj->properties->size() == 0)
+	if (!obj->properties || obj->properties->properties.empty())
 		return info.Env().Undefined();
 
-	auto iter = --obj->properties->end();
-	auto instance =
-		osn::PropertyObject::constructor.New({
-			info.This(), Napi::Number::New(info.Env(), (uint32_t)iter->first)
-			});
-	return instance;
+	return obj->Wrap(info.Env(), obj->properties->properties.size() - 1);
 }
 
 Napi::Value osn::Properties::Get(const Napi::CallbackInfo& info)
@@ -104,18 +355,16 @@ Napi::Value osn::Properties::Get(const Napi::CallbackInfo& info)
 	if (!obj)
 		return info.Env().Undefined();
 
+	if (!obj->properties)
+		return info.Env().Undefined();
+
 	std::string name = info[0].ToString().Utf8Value();
 
-	for (auto iter = obj->properties->begin(); iter != obj->properties->end(); iter++) {
-		if (iter->second->name == name) {
-			auto instance =
-				osn::PropertyObject::constructor.New({
-					info.This(), Napi::Number::New(info.Env(), (uint32_t)iter->first)
-					});
-			return instance;
-		}
-	}
-	return info.Env().Undefined();
+	const osn::Property* prop = obj->properties->find(name.c_str());
+	if (!prop)
+		return info.Env().Undefined();
+
+	return obj->Wrap(info.Env(), prop - obj->properties->properties.data());
 }
 
 Napi::FunctionReference osn::PropertyObject::constructor;
@@ -138,6 +387,7 @@ Napi::Object osn::PropertyObject::Init(Napi::Env env, Napi::Object exports) {
 			InstanceAccessor("enabled", &osn::PropertyObject::IsEnabled, nullptr),
 			InstanceAccessor("visible", &osn::PropertyObject::IsVisible, nullptr),
 			InstanceAccessor("details", &osn::PropertyObject::GetDetails, nullptr),
+			InstanceMethod("listItems", &osn::PropertyObject::ListItems),
 			InstanceAccessor("type", &osn::PropertyObject::GetType, nullptr),
 
 			InstanceMethod("modified", &osn::PropertyObject::Modified),
@@ -154,7 +404,33 @@ osn::PropertyObject::PropertyObject(const Napi::CallbackInfo& info)
 	Napi::Env env = info.Env();
 	Napi::HandleScope scope(env);
 	this->parent = Napi::ObjectWrap<osn::Properties>::Unwrap(info[0].ToObject());
+	// Keeps the parent alive for as long as this property is reachable.
+	this->parentRef = Napi::Persistent(info[0].ToObject());
 	this->index = (uint64_t)info[1].ToNumber().Uint32Value();
+
+	property_set_t set = this->parent ? this->parent->GetProperties() : nullptr;
+	if (set && this->index < set->properties.size())
+		this->name = set->string(set->properties[this->index].name);
+}
+
+const osn::Property* osn::PropertyObject::Find(property_set_t& set)
+{
+	if (!parent)
+		return nullptr;
+
+	set = parent->GetProperties();
+	if (!set)
+		return nullptr;
+
+	if (index < set->properties.size() && name == set->string(set->properties[index].name))
+		return &set->properties[index];
+
+	const Property* prop = set->find(name.c_str());
+	if (!prop)
+		return nullptr;
+
+	index = (uint32_t)(prop - set->properties.data());
+	return prop;
 }
 
 Napi::Value osn::PropertyObject::Previous(const Napi::CallbackInfo& info)
@@ -163,24 +439,12 @@ Napi::Value osn::PropertyObject::Previous(const Napi::CallbackInfo& info)
 		Napi::ObjectWrap<osn::PropertyObject>::Unwrap(info.This().ToObject());
 	if (!self)
 		return info.Env().Undefined();
-	osn::Properties* parent = self->parent;
-	if (!parent)
-		return info.Env().Undefined();
-
-	auto iter = parent->GetProperties()->find(self->index);
-	if (iter == parent->GetProperties()->end())
-		return info.Env().Undefined();
 
-	if (iter == parent->GetProperties()->begin())
+	property_set_t set;
+	if (!self->Find(set) || self->index == 0)
 		return info.Env().Undefined();
 
-	iter--;
-
-	auto instance =
-		osn::PropertyObject::constructor.New({
-			parent->Get(info), Napi::Number::New(info.Env(), (uint32_t)iter->first)
-			});
-	return instance;
+	return self->parent->Wrap(info.Env(), self->index - 1);
 }
 
 Napi::Value osn::PropertyObject::Next(const Napi::CallbackInfo& info)
@@ -189,26 +453,12 @@ Napi::Value osn::PropertyObject::Next(const Napi::CallbackInfo& info)
 		Napi::ObjectWrap<osn::PropertyObject>::Unwrap(info.This().ToObject());
 	if (!self)
 		return info.Env().Undefined();
-	osn::Properties* parent = self->parent;
-	if (!parent)
-		return info.Env().Undefined();
 
-	auto iter = parent->GetProperties()->find(self->index);
-	if (iter == parent->GetProperties()->end())
+	property_set_t set;
+	if (!self->Find(set))
 		return info.Env().Undefined();
 
-	iter++;
-	if (iter == parent->GetProperties()->end())
-		return info.Env().Undefined();
-
-	auto prop_ptr = Napi::External<property_map_t>::New(info.Env(), parent->properties.get());
-	auto obj = osn::Properties::constructor.New( {prop_ptr, Napi::Number::New(info.Env(), (uint32_t)parent->sourceId) });
-
-	auto instance =
-		osn::PropertyObject::constructor.New({
-			obj, Napi::Number::New(info.Env(), (uint32_t)iter->first)
-			});
-	return instance;
+	return self->parent->Wrap(info.Env(), self->index + 1);
 }
 
 Napi::Value osn::PropertyObject::IsFirst(const Napi::CallbackInfo& info)
@@ -217,13 +467,12 @@ Napi::Value osn::PropertyObject::IsFirst(const Napi::CallbackInfo& info)
 		Napi::ObjectWrap<osn::PropertyObject>::Unwrap(info.This().ToObject());
 	if (!self)
 		return info.Env().Undefined();
-	osn::Properties* parent = self->parent;
-	if (!parent)
-		return info.Env().Undefined();
 
-	auto iter = parent->GetProperties()->find(self->index);
-	return Napi::Boolean::New(info.Env(), iter == parent->GetProperties()->begin());
+	property_set_t set;
+	if (!self->Find(set))
+		return info.Env().Undefined();
 
+	return Napi::Boolean::New(info.Env(), self->index == 0);
 }
 
 Napi::Value osn::PropertyObject::IsLast(const Napi::CallbackInfo& info)
@@ -232,12 +481,12 @@ Napi::Value osn::PropertyObject::IsLast(const Napi::CallbackInfo& info)
 		Napi::ObjectWrap<osn::PropertyObject>::Unwrap(info.This().ToObject());
 	if (!self)
 		return info.Env().Undefined();
-	osn::Properties* parent = self->parent;
-	if (!parent)
+
+	property_set_t set;
+	if (!self->Find(set))
 		return info.Env().Undefined();
 
-	auto iter = property_map_t::reverse_iterator(parent->GetProperties()->find(self->index));
-	return Napi::Boolean::New(info.Env(), iter == parent->GetProperties()->rbegin());
+	return Napi::Boolean::New(info.Env(), self->index + 1 == set->properties.size());
 }
 
 Napi::Value osn::PropertyObject::GetValue(const Napi::CallbackInfo& info)
@@ -246,68 +495,48 @@ Napi::Value osn::PropertyObject::GetValue(const Napi::CallbackInfo& info)
 		Napi::ObjectWrap<osn::PropertyObject>::Unwrap(info.This().ToObject());
 	if (!self)
 		return info.Env().Undefined();
-	osn::Properties* parent = self->parent;
-	if (!parent)
-		return info.Env().Undefined();
 
-	auto iter = parent->GetProperties()->find(self->index);
-	if (iter == parent->GetProperties()->end())
+	property_set_t       set;
+	const osn::Property* prop = self->Find(set);
+	if (!prop)
 		return info.Env().Undefined();
 
-	switch (iter->second->type) {
+	switch (prop->type) {
 	case osn::Property::Type::INVALID:
 		return info.Env().Undefined();
-	case osn::Property::Type::BOOL: {
-		std::shared_ptr<osn::NumberProperty> cast_property =
-		    std::static_pointer_cast<osn::NumberProperty>(iter->second);
-		return Napi::Boolean::New(info.Env(), cast_property->bool_value.value);
-	}
-	case osn::Property::Type::INT: {
-		std::shared_ptr<osn::NumberProperty> cast_property =
-		    std::static_pointer_cast<osn::NumberProperty>(iter->second);
-		return Napi::Number::New(info.Env(), cast_property->int_value.value);
-	}
-	case osn::Property::Type::COLOR: {
-		std::shared_ptr<osn::NumberProperty> cast_property =
-		    std::static_pointer_cast<osn::NumberProperty>(iter->second);
-		return Napi::Number::New(info.Env(), cast_property->int_value.value);
-	}
-	case osn::Property::Type::FLOAT: {
-		std::shared_ptr<osn::NumberProperty> cast_property =
-		    std::static_pointer_cast<osn::NumberProperty>(iter->second);
-		return Napi::Number::New(info.Env(), cast_property->float_value.value);
-	}
-	case osn::Property::Type::TEXT: {
-		std::shared_ptr<osn::TextProperty> cast_property = std::static_pointer_cast<osn::TextProperty>(iter->second);
-		return Napi::String::New(info.Env(), cast_property->value);
-	}
-	case osn::Property::Type::PATH: {
-		std::shared_ptr<osn::PathProperty> cast_property = std::static_pointer_cast<osn::PathProperty>(iter->second);
-		return Napi::String::New(info.Env(), cast_property->value);
-	}
-
+	case osn::Property::Type::BOOL:
+		return Napi::Boolean::New(info.Env(), prop->number.bool_value.value);
+	case osn::Property::Type::INT:
+		return Napi::Number::New(info.Env(), prop->number.int_value.value);
+	case osn::Property::Type::COLOR:
+		return Napi::Number::New(info.Env(), prop->number.int_value.value);
+	case osn::Property::Type::FLOAT:
+		return Napi::Number::New(info.Env(), prop->number.float_value.value);
+	case osn::Property::Type::TEXT:
+		return Napi::String::New(info.Env(), set->string(prop->value_str));
+	case osn::Property::Type::PATH:
+		return Napi::String::New(info.Env(), set->string(prop->value_str));
 	case osn::Property::Type::LIST: {
-		std::shared_ptr<osn::ListProperty> cast_property = std::static_pointer_cast<osn::ListProperty>(iter->second);
-		switch (cast_property->item_format) {
-		case ListProperty::Format::FLOAT:
-			return Napi::Number::New(info.Env(), cast_property->current_value_float);
-		case ListProperty::Format::INT:
-			return Napi::Number::New(info.Env(), cast_property->current_value_int);
-		case ListProperty::Format::STRING:
-			return Napi::String::New(info.Env(), cast_property->current_value_str);
+		switch (osn::PropertyItem::Format(prop->item_format)) {
+		case osn::PropertyItem::Format::FLOAT:
+			return Napi::Number::New(info.Env(), prop->number.float_value.value);
+		case osn::PropertyItem::Format::INT:
+			return Napi::Number::New(info.Env(), prop->number.int_value.value);
+		case osn::PropertyItem::Format::STRING:
+			return Napi::String::New(info.Env(), set->string(prop->value_str));
+		default:
+			break;
 		}
 		break;
 	}
 	case osn::Property::Type::EDITABLELIST: {
-		std::shared_ptr<osn::EditableListProperty> cast_property =
-		    std::static_pointer_cast<osn::EditableListProperty>(iter->second);
-
-		Napi::Array values = Napi::Array::New(info.Env());
-		size_t idx = 0;
-		for (auto value : cast_property->values) {
-			Napi::Object iobj = Napi::Object::New(info.Env());
-			iobj.Set("value", value);
-			values.Set((uint32_t)idx++, iobj);
+		Napi::Array values = Napi::Array::New(info.Env(), prop->items);
+		for (uint32_t idx = 0; idx < prop->items; idx++) {
+			values.Set(
+			    idx,
+			    editable_item_shape.New(
+			        info.Env(),
+			        {Napi::String::New(info.Env(), set->string(set->items[prop->first_item + idx].value_str))}));
 		}
 
 		return values;
@@ -315,14 +544,13 @@ Napi::Value osn::PropertyObject::GetValue(const Napi::CallbackInfo& info)
 	case osn::Property::Type::BUTTON:
 		break;
 	case osn::Property::Type::FONT: {
-		std::shared_ptr<osn::FontProperty> cast_property = std::static_pointer_cast<osn::FontProperty>(iter->second);
-		Napi::Object font = Napi::Object::New(info.Env());
-		font.Set("face", cast_property->face);
-		font.Set("style", cast_property->style);
-		font.Set("path", cast_property->path);
-		font.Set("size", Napi::Number::New(info.Env(), cast_property->sizeF));
-		font.Set("flags", Napi::Number::New(info.Env(), cast_property->flags));
-		return font;
+		return font_shape.New(
+		    info.Env(),
+		    {Napi::String::New(info.Env(), set->string(prop->value_str)),
+		     Napi::String::New(info.Env(), set->string(prop->filter)),
+		     Napi::String::New(info.Env(), set->string(prop->default_path)),
+		     Napi::Number::New(info.Env(), prop->font_size),
+		     Napi::Number::New(info.Env(), prop->font_flags)});
 	}
 	case osn::Property::Type::FRAMERATE:
 		break;
@@ -336,15 +564,13 @@ Napi::Value osn::PropertyObject::GetName(const Napi::CallbackInfo& info)
 		Napi::ObjectWrap<osn::PropertyObject>::Unwrap(info.This().ToObject());
 	if (!self)
 		return info.Env().Undefined();
-	osn::Properties* parent = self->parent;
-	if (!parent)
-		return info.Env().Undefined();
 
-	auto iter = parent->GetProperties()->find(self->index);
-	if (iter == parent->GetProperties()->end())
+	property_set_t       set;
+	const osn::Property* prop = self->Find(set);
+	if (!prop)
 		return info.Env().Undefined();
 
-	return Napi::String::New(info.Env(), iter->second->name);
+	return Napi::String::New(info.Env(), set->string(prop->name));
 }
 
 Napi::Value osn::PropertyObject::GetDescription(const Napi::CallbackInfo& info)
@@ -353,15 +579,13 @@ Napi::Value osn::PropertyObject::GetDescription(const Napi::CallbackInfo& info)
 		Napi::ObjectWrap<osn::PropertyObject>::Unwrap(info.This().ToObject());
 	if (!self)
 		return info.Env().Undefined();
-	osn::Properties* parent = self->parent;
-	if (!parent)
-		return info.Env().Undefined();
 
-	auto iter = parent->GetProperties()->find(self->index);
-	if (iter == parent->GetProperties()->end())
+	property_set_t       set;
+	const osn::Property* prop = self->Find(set);
+	if (!prop)
 		return info.Env().Undefined();
 
-	return Napi::String::New(info.Env(), iter->second->description);
+	return Napi::String::New(info.Env(), set->string(prop->description));
 }
 
 Napi::Value osn::PropertyObject::GetLongDescription(const Napi::CallbackInfo& info)
@@ -370,15 +594,13 @@ Napi::Value osn::PropertyObject::GetLongDescription(const Napi::CallbackInfo& in
 		Napi::ObjectWrap<osn::PropertyObject>::Unwrap(info.This().ToObject());
 	if (!self)
 		return info.Env().Undefined();
-	osn::Properties* parent = self->parent;
-	if (!parent)
-		return info.Env().Undefined();
 
-	auto iter = parent->GetProperties()->find(self->index);
-	if (iter == parent->GetProperties()->end())
+	property_set_t       set;
+	const osn::Property* prop = self->Find(set);
+	if (!prop)
 		return info.Env().Undefined();
 
-	return Napi::String::New(info.Env(), iter->second->long_description);
+	return Napi::String::New(info.Env(), set->string(prop->long_description));
 }
 
 Napi::Value osn::PropertyObject::IsEnabled(const Napi::CallbackInfo& info)
@@ -387,15 +609,13 @@ Napi::Value osn::PropertyObject::IsEnabled(const Napi::CallbackInfo& info)
 		Napi::ObjectWrap<osn::PropertyObject>::Unwrap(info.This().ToObject());
 	if (!self)
 		return info.Env().Undefined();
-	osn::Properties* parent = self->parent;
-	if (!parent)
-		return info.Env().Undefined();
 
-	auto iter = parent->GetProperties()->find(self->index);
-	if (iter == parent->GetProperties()->end())
+	property_set_t       set;
+	const osn::Property* prop = self->Find(set);
+	if (!prop)
 		return info.Env().Undefined();
 
-	return Napi::Boolean::New(info.Env(), iter->second->enabled);
+	return Napi::Boolean::New(info.Env(), prop->enabled);
 }
 
 Napi::Value osn::PropertyObject::IsVisible(const Napi::CallbackInfo& info)
@@ -404,15 +624,13 @@ Napi::Value osn::PropertyObject::IsVisible(const Napi::CallbackInfo& info)
 		Napi::ObjectWrap<osn::PropertyObject>::Unwrap(info.This().ToObject());
 	if (!self)
 		return info.Env().Undefined();
-	osn::Properties* parent = self->parent;
-	if (!parent)
-		return info.Env().Undefined();
 
-	auto iter = parent->GetProperties()->find(self->index);
-	if (iter == parent->GetProperties()->end())
+	property_set_t       set;
+	const osn::Property* prop = self->Find(set);
+	if (!prop)
 		return info.Env().Undefined();
 
-	return Napi::Boolean::New(info.Env(), iter->second->visible);
+	return Napi::Boolean::New(info.Env(), prop->visible);
 }
 
 Napi::Value osn::PropertyObject::GetType(const Napi::CallbackInfo& info)
@@ -421,15 +639,100 @@ Napi::Value osn::PropertyObject::GetType(const Napi::CallbackInfo& info)
 		Napi::ObjectWrap<osn::PropertyObject>::Unwrap(info.This().ToObject());
 	if (!self)
 		return info.Env().Undefined();
-	osn::Properties* parent = self->parent;
-	if (!parent)
-		return info.Env().Undefined();
 
-	auto iter = parent->GetProperties()->find(self->index);
-	if (iter == parent->GetProperties()->end())
+	property_set_t       set;
+	const osn::Property* prop = self->Find(set);
+	if (!prop)
 		return info.Env().Undefined();
 
-	return Napi::Number::New(info.Env(), (uint32_t)iter->second->type);
+	return Napi::Number::New(info.Env(), (uint32_t)prop->type);
+}
+
+static bool contains_nocase(const char* haystack, const std::string& needle)
+{
+	const char* end = haystack + strlen(haystack);
+	return std::search(haystack, end, needle.begin(), needle.end(), [](char a, char b) {
+		       return std::tolower((unsigned char)a) == std::tolower((unsigned char)b);
+	       })
+	       != end;
+}
+
+static Napi::Array ListItemsToArray(
+    Napi::Env env, const osn::PropertySet& set, uint32_t format, const std::vector<const osn::PropertyItem*>& items)
+{
+	Napi::Array itemsobj = Napi::Array::New(env, items.size());
+	uint32_t    idx      = 0;
+	for (const osn::PropertyItem* itm : items) {
+		Napi::Value name    = Napi::String::New(env, set.string(itm->name));
+		Napi::Value enabled = Napi::Boolean::New(env, !itm->disabled);
+
+		Napi::Object iobj;
+		switch (osn::PropertyItem::Format(format)) {
+		case osn::PropertyItem::Format::INT:
+			iobj = list_item_shape.New(env, {name, enabled, Napi::Number::New(env, itm->value_int)});
+			break;
+		case osn::PropertyItem::Format::FLOAT:
+			iobj = list_item_shape.New(env, {name, enabled, Napi::Number::New(env, itm->value_float)});
+			break;
+		case osn::PropertyItem::Format::STRING:
+			iobj = list_item_shape.New(env, {name, enabled, Napi::String::New(env, set.string(itm->value_str))});
+			break;
+		default:
+			iobj = list_item_shape.New(env, {name, enabled});
+			break;
+		}
+		itemsobj.Set(idx++, iobj);
+	}
+	return itemsobj;
+}
+
+static Napi::Array ListItemsToArray(Napi::Env env, const osn::PropertySet& set, const osn::Property& prop)
+{
+	std::vector<const osn::PropertyItem*> items;
+	items.reserve(prop.items);
+	for (uint32_t idx = 0; idx < prop.items; idx++)
+		items.push_back(&set.items[prop.first_item + idx]);
+	return ListItemsToArray(env, set, prop.item_format, items);
+}
+
+// Fetches a page of list items through the property session of the source,
+// as a set holding the list alone. Its item_count is the number of items
+// matching `filter`.
+static osn::property_set_t FetchListItems(
+    const Napi::CallbackInfo& info,
+    uint64_t                  sourceId,
+    const std::string&        name,
+    uint32_t                  offset,
+    uint32_t                  count,
+    const std::string&        filter)
+{
+	SourceDataInfo* sdi = CacheManager<SourceDataInfo*>::getInstance().Retrieve(sourceId);
+	if (!sdi)
+		return nullptr;
+
+	// Only lists read through a session leave their items on the server.
+	if (!sdi->propertySession) {
+		Napi::Error::New(info.Env(), "The property session of the source is closed").ThrowAsJavaScriptException();
+		return nullptr;
+	}
+
+	auto rval = osn::ISource::CallPropertySession(
+	    info, sdi, "GetListItems", {ipc::value(name), ipc::value(offset), ipc::value(count), ipc::value(filter)});
+	if (!ValidateResponse(info, rval))
+		return nullptr;
+
+	osn::PropertySetBuilder builder;
+	if (rval.size() < 2 || !builder.Read(rval[1].value_bin)) {
+		Napi::Error::New(info.Env(), "Malformed list items response").ThrowAsJavaScriptException();
+		return nullptr;
+	}
+
+	osn::property_set_t page = builder.Build();
+	if (page->properties.front().type != osn::Property::Type::LIST) {
+		Napi::Error::New(info.Env(), "Malformed list items response").ThrowAsJavaScriptException();
+		return nullptr;
+	}
+	return page;
 }
 
 Napi::Value osn::PropertyObject::GetDetails(const Napi::CallbackInfo& info)
@@ -438,123 +741,153 @@ Napi::Value osn::PropertyObject::GetDetails(const Napi::CallbackInfo& info)
 		Napi::ObjectWrap<osn::PropertyObject>::Unwrap(info.This().ToObject());
 	if (!self)
 		return info.Env().Undefined();
-	osn::Properties* parent = self->parent;
-	if (!parent)
-		return info.Env().Undefined();
 
-	auto iter = parent->GetProperties()->find(self->index);
-	if (iter == parent->GetProperties()->end())
+	property_set_t       set;
+	const osn::Property* prop = self->Find(set);
+	if (!prop)
 		return info.Env().Undefined();
 
-	Napi::Object object = Napi::Object::New(info.Env());
+	osn::Properties* parent = self->parent;
+	if (!self->details.IsEmpty() && self->detailsGeneration == parent->generation)
+		return self->details.Value();
+
+	// Callers reading the items of a deferred list get all of them, only
+	// fetched now. Paging through listItems avoids that. The filled in list
+	// replaces the deferred one in a new snapshot, shared with the cache.
+	if (prop->type == osn::Property::Type::LIST && prop->items_deferred) {
+		property_set_t page =
+		    FetchListItems(info, parent->sourceId, set->string(prop->name), 0, (uint32_t)prop->item_count, "");
+		if (page) {
+			osn::PropertySetBuilder builder;
+			for (auto& entry : set->properties)
+				builder.Copy(*set, entry, &entry == prop ? page.get() : nullptr);
+			property_set_t filled = builder.Build();
+
+			SourceDataInfo* sdi = CacheManager<SourceDataInfo*>::getInstance().Retrieve(parent->sourceId);
+			if (sdi && sdi->properties == set)
+				sdi->properties = filled;
+			parent->SetProperties(filled);
+
+			set  = filled;
+			prop = &set->properties[self->index];
+		}
+	}
 
-	switch (iter->second->type) {
-	case osn::Property::Type::INT: {
-		std::shared_ptr<osn::NumberProperty> prop = std::static_pointer_cast<osn::NumberProperty>(iter->second);
+	Napi::Env    env = info.Env();
+	Napi::Object object;
 
-		object.Set("type", Napi::Number::New(info.Env(), (uint32_t)prop->field_type));
-		object.Set("min", Napi::Number::New(info.Env(), prop->int_value.min));
-		object.Set("max", Napi::Number::New(info.Env(), prop->int_value.max));
-		object.Set("step", Napi::Number::New(info.Env(), prop->int_value.step));
+	switch (prop->type) {
+	case osn::Property::Type::INT: {
+		object = number_details_shape.New(
+		    env,
+		    {Napi::Number::New(env, prop->field_type),
+		     Napi::Number::New(env, prop->number.int_value.min),
+		     Napi::Number::New(env, prop->number.int_value.max),
+		     Napi::Number::New(env, prop->number.int_value.step)});
 		break;
 	}
 	case osn::Property::Type::FLOAT: {
-		std::shared_ptr<osn::NumberProperty> prop = std::static_pointer_cast<osn::NumberProperty>(iter->second);
-
-		object.Set("type", Napi::Number::New(info.Env(), (uint32_t)prop->field_type));
-		object.Set("min", Napi::Number::New(info.Env(), prop->float_value.min));
-		object.Set("max", Napi::Number::New(info.Env(), prop->float_value.max));
-		object.Set("step", Napi::Number::New(info.Env(), prop->float_value.step));
+		object = number_details_shape.New(
+		    env,
+		    {Napi::Number::New(env, prop->field_type),
+		     Napi::Number::New(env, prop->number.float_value.min),
+		     Napi::Number::New(env, prop->number.float_value.max),
+		     Napi::Number::New(env, prop->number.float_value.step)});
 		break;
 	}
 	case osn::Property::Type::TEXT: {
-		std::shared_ptr<osn::TextProperty> prop = std::static_pointer_cast<osn::TextProperty>(iter->second);
-
-		object.Set("type", Napi::Number::New(info.Env(), (uint32_t)prop->field_type));
+		object = text_details_shape.New(env, {Napi::Number::New(env, prop->field_type)});
 		break;
 	}
-	case osn::Property::Type::PATH: {
-		std::shared_ptr<osn::PathProperty> prop = std::static_pointer_cast<osn::PathProperty>(iter->second);
-
-		object.Set("type", Napi::Number::New(info.Env(), (uint32_t)prop->field_type));
-		object.Set("filter", Napi::String::New(info.Env(), prop->filter));
-		object.Set("defaultPath", Napi::String::New(info.Env(), prop->default_path));
+	case osn::Property::Type::PATH:
+	case osn::Property::Type::EDITABLELIST: {
+		object = path_details_shape.New(
+		    env,
+		    {Napi::Number::New(env, prop->field_type),
+		     Napi::String::New(env, set->string(prop->filter)),
+		     Napi::String::New(env, set->string(prop->default_path))});
 		break;
 	}
 	case osn::Property::Type::LIST: {
-		std::shared_ptr<osn::ListProperty> prop = std::static_pointer_cast<osn::ListProperty>(iter->second);
-
-		object.Set("type", Napi::Number::New(info.Env(), (uint32_t)prop->field_type));
-		object.Set("format", Napi::Number::New(info.Env(), (uint32_t)prop->item_format));
-
-		Napi::Array itemsobj = Napi::Array::New(info.Env());
-		size_t idx = 0;
-		for (auto itm : prop->items) {
-			Napi::Object iobj = Napi::Object::New(info.Env());
-			iobj.Set("name", Napi::String::New(info.Env(), itm.name));
-			iobj.Set("enabled", Napi::Boolean::New(info.Env(), !itm.disabled));
-
-			switch (prop->item_format) {
-			case ListProperty::Format::INT:
-				iobj.Set("value", Napi::Number::New(info.Env(), itm.value_int));
-				break;
-			case ListProperty::Format::FLOAT:
-				iobj.Set("value", Napi::Number::New(info.Env(), itm.value_float));
-				break;
-			case ListProperty::Format::STRING:
-				iobj.Set("value", Napi::String::New(info.Env(), itm.value_str));
-				break;
-			}
-			itemsobj.Set((uint32_t)idx++, iobj);
-		}
-		object.Set("items", itemsobj);
+		object = list_details_shape.New(
+		    env,
+		    {Napi::Number::New(env, prop->field_type),
+		     Napi::Number::New(env, prop->item_format),
+		     Napi::Number::New(env, (double)(prop->items_deferred ? prop->item_count : prop->items)),
+		     ListItemsToArray(env, *set, *prop)});
 		break;
 	}
-	case osn::Property::Type::EDITABLELIST: {
-		std::shared_ptr<osn::EditableListProperty> prop =
-		    std::static_pointer_cast<osn::EditableListProperty>(iter->second);
-
-		object.Set("type", Napi::Number::New(info.Env(), (uint32_t)prop->field_type));
-		object.Set("filter", Napi::String::New(info.Env(), prop->filter));
-		object.Set("defaultPath", Napi::String::New(info.Env(), prop->default_path));
+	default:
+		object = Napi::Object::New(env);
 		break;
 	}
-	case osn::Property::Type::FRAMERATE: {
-		std::shared_ptr<osn::FrameRateProperty> prop = std::static_pointer_cast<osn::FrameRateProperty>(iter->second);
 
-		Napi::Array rangesobj = Napi::Array::New(info.Env());
-		size_t idx = 0;
-		for (auto itm : prop->ranges) {
-			Napi::Object minobj = Napi::Object::New(info.Env());
-			minobj.Set("numerator", Napi::Number::New(info.Env(), itm.first.numerator));
-			minobj.Set("denominator", Napi::Number::New(info.Env(), itm.first.denominator));
+	// The details are shared by every read until the snapshot changes.
+	if (prop->type == osn::Property::Type::LIST) {
+		Napi::Array items = object.Get("items").As<Napi::Array>();
+		for (uint32_t idx = 0; idx < items.Length(); idx++)
+			utilv8::Freeze(env, items.Get(idx).As<Napi::Object>());
+		utilv8::Freeze(env, items);
+	}
+	utilv8::Freeze(env, object);
+
+	self->details           = Napi::Persistent(object);
+	self->detailsGeneration = parent->generation;
+	return object;
+}
+
+Napi::Value osn::PropertyObject::ListItems(const Napi::CallbackInfo& info)
+{
+	if (info.Length() < 2 || !info[0].IsNumber() || !info[1].IsNumber()) {
+		Napi::Error::New(info.Env(), "Arguments 'offset' and 'count' must be of type 'Number'.")
+		    .ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+	if (info.Length() > 2 && !info[2].IsUndefined() && !info[2].IsString()) {
+		Napi::Error::New(info.Env(), "Argument 'filter' must be of type 'String'.").ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+	uint32_t    offset = info[0].ToNumber().Uint32Value();
+	uint32_t    count  = info[1].ToNumber().Uint32Value();
+	std::string filter = info.Length() > 2 && info[2].IsString() ? info[2].ToString().Utf8Value() : "";
 
-			Napi::Object maxobj = Napi::Object::New(info.Env());
-			maxobj.Set("numerator", Napi::Number::New(info.Env(), itm.second.numerator));
-			maxobj.Set("denominator", Napi::Number::New(info.Env(), itm.second.denominator));
+	osn::PropertyObject* self =
+		Napi::ObjectWrap<osn::PropertyObject>::Unwrap(info.This().ToObject());
+	if (!self)
+		return info.Env().Undefined();
 
-			Napi::Object iobj = Napi::Object::New(info.Env());
-			iobj.Set("min", minobj);
-			iobj.Set("max", maxobj);
+	property_set_t       set;
+	const osn::Property* prop = self->Find(set);
+	if (!prop || prop->type != osn::Property::Type::LIST)
+		return info.Env().Undefined();
 
-			rangesobj.Set((uint32_t)idx++, iobj);
+	// Lists that were sent whole, like frame rates, are paged locally.
+	if (!prop->items_deferred) {
+		std::vector<const osn::PropertyItem*> items;
+		uint64_t                              total = 0;
+		for (uint32_t idx = 0; idx < prop->items; idx++) {
+			const osn::PropertyItem& itm = set->items[prop->first_item + idx];
+			if (!filter.empty() && !contains_nocase(set->string(itm.name), filter))
+				continue;
+			if (total >= offset && total - offset < count)
+				items.push_back(&itm);
+			total++;
 		}
-		object.Set("ranges", rangesobj);
-
-		Napi::Array itemsobj = Napi::Array::New(info.Env());
-		idx = 0;
-		for (auto itm : prop->options) {
-			Napi::Object iobj = Napi::Object::New(info.Env());
-			iobj.Set("name", Napi::String::New(info.Env(), itm.name));
-			iobj.Set("description", Napi::String::New(info.Env(), itm.description));
-			rangesobj.Set((uint32_t)idx++, iobj);
-		}
-		object.Set("items", itemsobj);
-		break;
-	}
+		return list_page_shape.New(
+		    info.Env(),
+		    {Napi::Number::New(info.Env(), (double)total),
+		     ListItemsToArray(info.Env(), *set, prop->item_format, items)});
 	}
 
-	return object;
+	property_set_t fetched =
+	    FetchListItems(info, self->parent->sourceId, set->string(prop->name), offset, count, filter);
+	if (!fetched)
+		return info.Env().Undefined();
+
+	const osn::Property& list = fetched->properties.front();
+	return list_page_shape.New(
+	    info.Env(),
+	    {Napi::Number::New(info.Env(), (double)list.item_count), ListItemsToArray(info.Env(), *fetched, list)});
 }
 
 Napi::Value osn::PropertyObject::Modified(const Napi::CallbackInfo& info)
@@ -568,17 +901,31 @@ Napi::Value osn::PropertyObject::Modified(const Napi::CallbackInfo& info)
 		Napi::ObjectWrap<osn::PropertyObject>::Unwrap(info.This().ToObject());
 	if (!self)
 		return info.Env().Undefined();
-	osn::Properties* parent = self->parent;
-	if (!parent)
-		return info.Env().Undefined();
 
-	auto iter = parent->GetProperties()->find(self->index);
-	if (iter == parent->GetProperties()->end())
+	property_set_t       set;
+	const osn::Property* prop = self->Find(set);
+	if (!prop)
 		return info.Env().Null();
+	osn::Properties* parent = self->parent;
+	std::string      name   = set->string(prop->name);
 
 	Napi::String settings_str = stringify.Call(json, { settings }).As<Napi::String>();
 	std::string value = settings_str.Utf8Value();
 
+	SourceDataInfo* sdi = CacheManager<SourceDataInfo*>::getInstance().Retrieve(parent->sourceId);
+	if (sdi) {
+		auto rval = osn::ISource::CallPropertySession(info, sdi, "SessionModified", {ipc::value(name), ipc::value(value)});
+		if (!ValidateResponse(info, rval))
+			return Napi::Boolean::New(info.Env(), false);
+
+		sdi->properties        = osn::ISource::ApplyPropertyChanges(sdi->properties, rval, 2);
+		sdi->propertiesChanged = false;
+		sdi->settingsChanged   = true;
+		parent->SetProperties(sdi->properties);
+
+		return Napi::Boolean::New(info.Env(), !!rval[1].value_union.i32);
+	}
+
 	auto conn = GetConnection(info);
 	if (!conn)
 		return info.Env().Undefined();
@@ -586,17 +933,11 @@ Napi::Value osn::PropertyObject::Modified(const Napi::CallbackInfo& info)
 	auto rval = conn->call_synchronous_helper(
 	    "Properties",
 	    "Modified",
-	    {ipc::value(parent->sourceId), ipc::value(iter->second->name), ipc::value(value)});
+	    {ipc::value(parent->sourceId), ipc::value(name), ipc::value(value)});
 
 	if (!ValidateResponse(info, rval))
 		return Napi::Boolean::New(info.Env(), false);
 
-	SourceDataInfo* sdi = CacheManager<SourceDataInfo*>::getInstance().Retrieve(parent->sourceId);
-	if (sdi) {
-		sdi->propertiesChanged = true;
-		sdi->settingsChanged   = true;
-	}
-
 	return Napi::Boolean::New(info.Env(), !!rval[1].value_union.i32);
 }
 
@@ -606,13 +947,27 @@ Napi::Value osn::PropertyObject::ButtonClicked(const Napi::CallbackInfo& info)
 		Napi::ObjectWrap<osn::PropertyObject>::Unwrap(info.This().ToObject());
 	if (!self)
 		return info.Env().Undefined();
-	osn::Properties* parent = self->parent;
-	if (!parent)
-		return info.Env().Undefined();
 
-	auto iter = parent->GetProperties()->find(self->index);
-	if (iter == parent->GetProperties()->end())
+	property_set_t       set;
+	const osn::Property* prop = self->Find(set);
+	if (!prop)
 		return info.Env().Null();
+	osn::Properties* parent = self->parent;
+	std::string      name   = set->string(prop->name);
+
+	SourceDataInfo* sdi = CacheManager<SourceDataInfo*>::getInstance().Retrieve(parent->sourceId);
+	if (sdi) {
+		auto rval = osn::ISource::CallPropertySession(info, sdi, "SessionClicked", {ipc::value(name)});
+		if (!ValidateResponse(info, rval))
+			return Napi::Boolean::New(info.Env(), false);
+
+		sdi->properties        = osn::ISource::ApplyPropertyChanges(sdi->properties, rval, 2);
+		sdi->propertiesChanged = false;
+		sdi->settingsChanged   = true;
+		parent->SetProperties(sdi->properties);
+
+		return Napi::Boolean::New(info.Env(), true);
+	}
 
 	// Call
 	auto conn = GetConnection(info);
@@ -620,7 +975,7 @@ Napi::Value osn::PropertyObject::ButtonClicked(const Napi::CallbackInfo& info)
 		return info.Env().Undefined();
 
 	auto rval = conn->call_synchronous_helper(
-	    "Properties", "Clicked", {ipc::value(parent->sourceId), ipc::value(iter->second->name)});
+	    "Properties", "Clicked", {ipc::value(parent->sourceId), ipc::value(name)});
 
 	if (!ValidateResponse(info, rval))
 		return Napi::Boolean::New(info.Env(), false);
@@ -628,16 +983,8 @@ Napi::Value osn::PropertyObject::ButtonClicked(const Napi::CallbackInfo& info)
 	rval = conn->call_synchronous_helper(
 	    "Properties",
 	    "Modified",
-	    {ipc::value(parent->sourceId), ipc::value(iter->second->name), ipc::value("")});
-	bool settings_changed = false;
-	if (ValidateResponse(info, rval))
-		settings_changed = true;
-
-	SourceDataInfo* sdi = CacheManager<SourceDataInfo*>::getInstance().Retrieve(parent->sourceId);
-	if (sdi) {
-		sdi->propertiesChanged = true;
-		sdi->settingsChanged   = settings_changed;
-	}
+	    {ipc::value(parent->sourceId), ipc::value(name), ipc::value("")});
+	ValidateResponse(info, rval);
 
 	return Napi::Boolean::New(info.Env(), true);
 }
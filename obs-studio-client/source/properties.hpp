@@ -18,14 +18,19 @@
 
 #pragma once
 #include <inttypes.h>
-#include <map>
 #include <math.h>
+#include <memory>
 #include <napi.h>
-#include <unordered_map>
+#include <string>
+#include <vector>
+#include "obs-string-table.hpp"
 #include "utility-v8.hpp"
 
 namespace osn
 {
+	// One property of a PropertySet. Strings are offsets into the string
+	// table of the set, list items and editable list values are a range of
+	// its items. Which fields are used depends on `type`.
 	struct Property
 	{
 		enum class Type
@@ -44,24 +49,19 @@ namespace osn
 			FRAMERATE,
 		};
 
-		std::string name;
-		std::string description;
-		std::string long_description;
-
-		bool enabled;
-		bool visible;
+		Type     type             = Type::INVALID;
+		bool     enabled          = false;
+		bool     visible          = false;
+		uint32_t name             = 0;
+		uint32_t description      = 0;
+		uint32_t long_description = 0;
 
-		Type type;
-	};
-
-	struct NumberProperty : Property
-	{
-		enum class Type
-		{
-			SCROLLER,
-			SLIDER,
-		};
+		// Number, text, path, list or editable list type, and the format of
+		// list items.
+		uint32_t field_type  = 0;
+		uint32_t item_format = 0;
 
+		// Numbers, and the current value of integer and float lists.
 		union
 		{
 			struct
@@ -76,47 +76,28 @@ namespace osn
 			{
 				bool value;
 			} bool_value;
-		};
-
-		Type field_type;
-	};
-
-	struct TextProperty : Property
-	{
-		enum class Type
-		{
-			DEFAULT,
-			PASSWORD,
-			MULTILINE,
-		};
-
-		Type        field_type;
-		std::string value;
+		} number = {};
+
+		// Text and path values, current value of string lists, font face.
+		uint32_t value_str = 0;
+		// Filter of paths and editable lists, font style.
+		uint32_t filter = 0;
+		// Default path of paths and editable lists, font path.
+		uint32_t default_path = 0;
+		int64_t  font_size    = 0;
+		uint32_t font_flags   = 0;
+
+		// Items held by the set, and the number of items of the list. Deferred
+		// lists only hold their selected item until the rest is fetched through
+		// the property session.
+		uint32_t first_item     = 0;
+		uint32_t items          = 0;
+		uint64_t item_count     = 0;
+		bool     items_deferred = false;
 	};
 
-	struct PathProperty : Property
+	struct PropertyItem
 	{
-		enum class Type
-		{
-			FILE,
-			FILE_SAVE,
-			PATH_DIRECTORY
-		};
-
-		Type        field_type;
-		std::string filter;
-		std::string default_path;
-		std::string value;
-	};
-
-	struct ListProperty : Property
-	{
-		enum class Type
-		{
-			INVALID,
-			EDITABLE,
-			LIST,
-		};
 		enum class Format
 		{
 			INVALID,
@@ -125,85 +106,72 @@ namespace osn
 			STRING,
 		};
 
-		struct Item
-		{
-			std::string name;
-			bool        disabled;
-
-			union
-			{
-				int64_t  value_int;
-				double_t value_float;
-			};
-			std::string value_str;
-		};
+		uint32_t name     = 0;
+		bool     disabled = false;
 
 		union
 		{
-			int64_t  current_value_int;
-			double_t current_value_float;
+			int64_t  value_int;
+			double_t value_float;
 		};
-		std::string     current_value_str;
-
-		Type            field_type;
-		Format          item_format;
-		std::list<Item> items;
+		uint32_t value_str = 0;
 	};
 
-	struct FontProperty : Property
+	// Immutable snapshot of the properties of a source. Properties, items and
+	// strings live in three flat vectors, so a snapshot costs the same few
+	// allocations however many properties it holds and reading it allocates
+	// nothing. Snapshots are shared between the source cache and the JS
+	// wrappers, changes build a new one.
+	class PropertySet
 	{
-		std::string face;
-		std::string style;
-		std::string path;
-		int64_t     sizeF;
-		uint32_t    flags;
-	};
+		public:
+		std::vector<Property>     properties;
+		std::vector<PropertyItem> items;
+		std::vector<char>         strings;
 
-	// Contrary to the name, not compatible with the ListProperty. Actually more comparable to PathProperty.
-	struct EditableListProperty : Property
-	{
-		enum class Type
+		const char* string(uint32_t offset) const
 		{
-			STRINGS,
-			FILES,
-			FILES_AND_URLS,
-		};
-
-		Type                   field_type;
-		std::string            filter;
-		std::string            default_path;
-		std::list<std::string> values;
+			return offset < strings.size() ? strings.data() + offset : "";
+		}
+		const Property* find(const char* name) const;
 	};
+	typedef std::shared_ptr<const PropertySet> property_set_t;
 
-	struct FrameRateProperty : Property
+	class PropertySetBuilder
 	{
-		struct FrameRate
-		{
-			uint32_t numerator;
-			uint32_t denominator;
-		};
-		struct Option
-		{
-			std::string name;
-			std::string description;
-		};
-
-		std::list<std::pair<FrameRate, FrameRate>> ranges; // minmax range
-		std::list<Option> options; // Could also be a list, but this allows fast indexing by name.
+		public:
+		// Appends a property as serialized by the server, false if it could
+		// not be read.
+		bool Read(const std::vector<char>& buf);
+		// Appends a property of another set, with the items of `items_from`
+		// instead of its own when given.
+		void Copy(const PropertySet& set, const Property& prop, const PropertySet* items_from = nullptr);
+		property_set_t Build();
+
+		private:
+		uint32_t         CopyString(const PropertySet& set, uint32_t offset);
+		PropertySet      result;
+		obs::StringTable strings;
 	};
 
-	// This is a class that basically implements the OBS behavior.
-	typedef std::map<size_t, std::shared_ptr<Property>> property_map_t;
-
 	// The actual classes that work with JavaScript
 	class Properties : public Napi::ObjectWrap<osn::Properties>
 	{
 		public:
-		std::shared_ptr<property_map_t> properties;
+		property_set_t properties;
 		uint64_t sourceId;
 
+		// Property wrappers handed out, by index. They are weak so that
+		// iterating a large set does not keep every wrapper alive, and reset
+		// whenever the snapshot is replaced.
+		std::vector<Napi::ObjectReference> wrappers;
+		uint32_t                           generation = 0;
+
 		public:
-		std::shared_ptr<property_map_t> GetProperties();
+		property_set_t GetProperties();
+		void           SetProperties(property_set_t set);
+		Napi::Value    Wrap(Napi::Env env, size_t index);
+
 		static Napi::FunctionReference constructor;
 		static Napi::Object Init(Napi::Env env, Napi::Object exports);
 		Properties(const Napi::CallbackInfo& info);
@@ -216,8 +184,19 @@ namespace osn
 
 	class PropertyObject : public Napi::ObjectWrap<osn::PropertyObject>
 	{
-		osn::Properties* parent;
-		uint32_t index;
+		osn::Properties*      parent;
+		Napi::ObjectReference parentRef;
+		// The property is identified by its name, the index is where it was
+		// last seen. Modified and ButtonClicked can add or remove properties.
+		std::string name;
+		uint32_t    index;
+
+		// Details are built on first access and reused until the snapshot of
+		// the parent changes.
+		Napi::ObjectReference details;
+		uint32_t              detailsGeneration = 0;
+
+		const Property* Find(property_set_t& set);
 
 		public:
 		static Napi::FunctionReference constructor;
@@ -239,6 +218,7 @@ namespace osn
 		Napi::Value GetType(const Napi::CallbackInfo& info);
 
 		Napi::Value GetDetails(const Napi::CallbackInfo& info);
+		Napi::Value ListItems(const Napi::CallbackInfo& info);
 
 		Napi::Value Modified(const Napi::CallbackInfo& info);
 		Napi::Value ButtonClicked(const Napi::CallbackInfo& info);
@@ -49,7 +49,14 @@ Napi::Object osn::Scene::Init(Napi::Env env, Napi::Object exports) {
 			InstanceMethod("orderItems", &osn::Scene::OrderItems),
 			InstanceMethod("getItemAtIdx", &osn::Scene::GetItemAtIndex),
 			InstanceMethod("getItems", &osn::Scene::GetItems),
+			InstanceMethod("getItemIds", &osn::Scene::GetItemIds),
 			InstanceMethod("getItemsInRange", &osn::Scene::GetItemsInRange),
+			InstanceMethod("beginEdit", &osn::Scene::BeginEdit),
+			InstanceMethod("editItem", &osn::Scene::EditItem),
+			InstanceMethod("commitEdit", &osn::Scene::CommitEdit),
+			InstanceMethod("hitTest", &osn::Scene::HitTest),
+			InstanceMethod("selectItems", &osn::Scene::SelectItems),
+			InstanceMethod("snap", &osn::Scene::Snap),
 
 			InstanceAccessor("configurable", &osn::Scene::CallIsConfigurable, nullptr),
 			InstanceAccessor("properties", &osn::Scene::CallGetProperties, nullptr),
@@ -62,9 +69,12 @@ Napi::Object osn::Scene::Init(Napi::Env env, Napi::Object exports) {
 			InstanceAccessor("id", &osn::Scene::CallGetId, nullptr),
 			InstanceAccessor("muted", &osn::Scene::CallGetMuted, &osn::Scene::CallSetMuted),
 			InstanceAccessor("enabled", &osn::Scene::CallGetEnabled, &osn::Scene::CallSetEnabled),
+			InstanceAccessor("duplicationTime", &osn::Scene::CallGetDuplicationTime, nullptr),
 
 			InstanceMethod("release", &osn::Scene::CallRelease),
 			InstanceMethod("remove", &osn::Scene::CallRemove),
+			InstanceMethod("openPropertySession", &osn::Scene::CallOpenPropertySession),
+			InstanceMethod("closePropertySession", &osn::Scene::CallClosePropertySession),
 			InstanceMethod("update", &osn::Scene::CallUpdate),
 			InstanceMethod("load", &osn::Scene::CallLoad),
 			InstanceMethod("save", &osn::Scene::CallSave),
@@ -242,16 +252,20 @@ Napi::Value osn::Scene::Duplicate(const Napi::CallbackInfo& info)
 
 	uint64_t sourceId = response[1].value_union.ui64;
 
+	SceneInfo* si       = new SceneInfo();
+	si->name            = name;
+	si->id              = sourceId;
+	si->duplicationTime = double(response[2].value_union.ui64) / 1000000.0;
 	SourceDataInfo* sdi = new SourceDataInfo;
 	sdi->name           = name;
 	sdi->obs_sourceId   = "scene";
 	sdi->id             = response[1].value_union.ui64;
 
 	CacheManager<SourceDataInfo*>::getInstance().Store(sourceId, name, sdi);
-	CacheManager<SceneInfo*>::getInstance().Store(sourceId, name, new SceneInfo);
+	CacheManager<SceneInfo*>::getInstance().Store(sourceId, name, si);
 
     auto instance =
-        osn::Input::constructor.New({
+        osn::Scene::constructor.New({
             Napi::Number::New(info.Env(), sourceId)
             });
 
@@ -512,62 +526,85 @@ Napi::Value osn::Scene::GetItemAtIndex(const Napi::CallbackInfo& info)
     return instance;
 }
 
-Napi::Value osn::Scene::GetItems(const Napi::CallbackInfo& info)
+bool osn::Scene::FetchItems(const Napi::CallbackInfo& info, std::vector<std::pair<int64_t, uint64_t>>& items)
 {
 	SceneInfo* si = CacheManager<SceneInfo*>::getInstance().Retrieve(this->sourceId);
 
 	if (si && si->itemsOrderCached) {
-		Napi::Array array = Napi::Array::New(info.Env(), int(si->items.size()) - 1);
-		size_t index = 0;
 		bool itemRemoved = false;
-
 		for (auto item : si->items) {
-			SceneItemData*  sid = CacheManager<SceneItemData*>::getInstance().Retrieve(item.first);
-			if (!sid) {
+			if (!CacheManager<SceneItemData*>::getInstance().Retrieve(item.second)) {
 				itemRemoved = true;
 				break;
 			}
-			auto instance =
-				osn::SceneItem::constructor.New({
-					Napi::Number::New(info.Env(), item.second)
-					});
-			array.Set(uint32_t(index++), instance);
 		}
 		if (!itemRemoved) {
-			return array;
+			items = si->items;
+			return true;
 		}
 	}
 
 	auto conn = GetConnection(info);
 	if (!conn)
-		return info.Env().Undefined();
+		return false;
 
-	std::vector<ipc::value> response =
-	    conn->call_synchronous_helper("Scene", "GetItems", std::vector<ipc::value>{ipc::value(this->sourceId)});
+	// Only a revision comes back when the cached list is still current.
+	uint64_t known = si ? si->itemsRevision : UINT64_MAX;
+	std::vector<ipc::value> response = conn->call_synchronous_helper(
+	    "Scene", "GetItems", std::vector<ipc::value>{ipc::value(this->sourceId), ipc::value(known)});
 
 	if (!ValidateResponse(info, response))
-		return info.Env().Undefined();
+		return false;
 
-	Napi::Array array = Napi::Array::New(info.Env(), int((response.size()) - 1)/2);
-	size_t index = 0;
-	for (size_t i = 1; i < response.size(); i++) {
-		auto instance =
-			osn::SceneItem::constructor.New({
-				Napi::Number::New(info.Env(), response[i++].value_union.ui64)
-				});
-		array.Set(uint32_t(index++), instance);
+	if (response.size() < 3) {
+		if (!si)
+			return false;
+		si->itemsOrderCached = true;
+		items                = si->items;
+		return true;
 	}
 
-	if (si) {
-		si->items.clear();
+	std::vector<obs::SceneItemRef> refs;
+	if (!obs::read_list(response[2].value_bin, refs))
+		return false;
 
-		for (size_t i = 1; i < response.size(); i+= 2) {
-			si->items.push_back(std::make_pair(response[i + 1].value_union.i64, response[i].value_union.ui64));
-		}
+	items.clear();
+	items.reserve(refs.size());
+	for (auto& ref : refs)
+		items.push_back(std::make_pair(ref.item_id, ref.uid));
 
+	if (si) {
+		si->items            = items;
+		si->itemsRevision    = response[1].value_union.ui64;
 		si->itemsOrderCached = true;
 	}
+	return true;
+}
+
+Napi::Value osn::Scene::GetItems(const Napi::CallbackInfo& info)
+{
+	std::vector<std::pair<int64_t, uint64_t>> items;
+	if (!FetchItems(info, items))
+		return info.Env().Undefined();
+
+	Napi::Array array = Napi::Array::New(info.Env(), items.size());
+	for (size_t index = 0; index < items.size(); index++) {
+		array.Set(
+		    uint32_t(index),
+		    osn::SceneItem::constructor.New({Napi::Number::New(info.Env(), items[index].second)}));
+	}
+	return array;
+}
+
+Napi::Value osn::Scene::GetItemIds(const Napi::CallbackInfo& info)
+{
+	std::vector<std::pair<int64_t, uint64_t>> items;
+	if (!FetchItems(info, items))
+		return info.Env().Undefined();
 
+	Napi::Float64Array array = Napi::Float64Array::New(info.Env(), items.size());
+	for (size_t index = 0; index < items.size(); index++)
+		array[index] = double(items[index].first);
 	return array;
 }
 
@@ -588,18 +625,192 @@ Napi::Value osn::Scene::GetItemsInRange(const Napi::CallbackInfo& info)
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
 
-	Napi::Array array = Napi::Array::New(info.Env(), int(response.size() - 1));
-	for (size_t i = 1; i < response.size(); i++) {
+	std::vector<obs::SceneItemRef> refs;
+	if (!obs::read_list(response[1].value_bin, refs))
+		return info.Env().Undefined();
+
+	Napi::Array array = Napi::Array::New(info.Env(), refs.size());
+	for (size_t i = 0; i < refs.size(); i++) {
 		auto instance =
 			osn::SceneItem::constructor.New({
-				Napi::Number::New(info.Env(), response[i].value_union.ui64)
+				Napi::Number::New(info.Env(), refs[i].uid)
 				});
-		array.Set(uint32_t(i - 1), instance);
+		array.Set(uint32_t(i), instance);
+	}
+
+	return array;
+}
+
+Napi::Value osn::Scene::BeginEdit(const Napi::CallbackInfo& info)
+{
+	this->editing = true;
+	this->pendingEdits.clear();
+	return info.Env().Undefined();
+}
+
+Napi::Value osn::Scene::EditItem(const Napi::CallbackInfo& info)
+{
+	if (!this->editing) {
+		Napi::Error::New(info.Env(), "beginEdit must be called before editItem").ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+
+	if (info.Length() < 2 || !info[0].IsObject() || !info[1].IsObject()) {
+		Napi::TypeError::New(info.Env(), "Expected scene item and edit object").ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+
+	osn::SceneItem* item = Napi::ObjectWrap<osn::SceneItem>::Unwrap(info[0].ToObject());
+	Napi::Object    edit = info[1].ToObject();
+
+	obs::SceneItemEdit entry;
+	entry.item_id = item->itemId;
+	osn::SceneItem::ParseTransform(edit, entry.transform);
+
+	if (edit.Has("visible")) {
+		entry.flags |= obs::SceneItemEdit::Visible;
+		entry.visible = edit.Get("visible").ToBoolean().Value();
+	}
+	if (edit.Has("order")) {
+		entry.flags |= obs::SceneItemEdit::Order;
+		entry.order_position = edit.Get("order").ToNumber().Int32Value();
+	}
+
+	this->pendingEdits.push_back(entry);
+	return info.Env().Undefined();
+}
+
+Napi::Value osn::Scene::CommitEdit(const Napi::CallbackInfo& info)
+{
+	if (!this->editing) {
+		Napi::Error::New(info.Env(), "beginEdit must be called before commitEdit").ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+
+	std::vector<obs::SceneItemEdit> edits;
+	edits.swap(this->pendingEdits);
+	this->editing = false;
+
+	if (edits.empty())
+		return info.Env().Undefined();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper(
+	    "Scene", "CommitEdit", std::vector<ipc::value>{ipc::value(this->sourceId), ipc::value(obs::serialize_list(edits))});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	std::vector<obs::Transform> transforms;
+	if (!obs::read_list(response[1].value_bin, transforms) || transforms.size() != edits.size())
+		return info.Env().Undefined();
+
+	bool orderChanged = false;
+	for (size_t idx = 0; idx < edits.size(); idx++) {
+		SceneItemData* sid = CacheManager<SceneItemData*>::getInstance().Retrieve(edits[idx].item_id);
+		if (!sid)
+			continue;
+
+		osn::SceneItem::UpdateTransformCache(sid, transforms[idx]);
+		if (edits[idx].has(obs::SceneItemEdit::Visible)) {
+			sid->isVisible      = !!edits[idx].visible;
+			sid->visibleChanged = false;
+		}
+		if (edits[idx].has(obs::SceneItemEdit::Order))
+			orderChanged = true;
+	}
+
+	if (orderChanged) {
+		SceneInfo* si = CacheManager<SceneInfo*>::getInstance().Retrieve(this->sourceId);
+		if (si)
+			si->itemsOrderCached = false;
 	}
 
+	return info.Env().Undefined();
+}
+
+Napi::Value osn::Scene::HitTest(const Napi::CallbackInfo& info)
+{
+	float x = info[0].ToNumber().FloatValue();
+	float y = info[1].ToNumber().FloatValue();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper(
+	    "Scene", "HitTest", std::vector<ipc::value>{ipc::value(this->sourceId), ipc::value(x), ipc::value(y)});
+
+	if (!ValidateResponse(info, response) || response.size() < 3)
+		return info.Env().Undefined();
+
+	return osn::SceneItem::constructor.New({Napi::Number::New(info.Env(), response[1].value_union.ui64)});
+}
+
+Napi::Value osn::Scene::SelectItems(const Napi::CallbackInfo& info)
+{
+	Napi::Object rect = info[0].ToObject();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper(
+	    "Scene",
+	    "SelectItems",
+	    std::vector<ipc::value>{ipc::value(this->sourceId),
+	                            ipc::value(rect.Get("x").ToNumber().FloatValue()),
+	                            ipc::value(rect.Get("y").ToNumber().FloatValue()),
+	                            ipc::value(rect.Get("width").ToNumber().FloatValue()),
+	                            ipc::value(rect.Get("height").ToNumber().FloatValue())});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	Napi::Array array = Napi::Array::New(info.Env(), (response.size() - 1) / 2);
+	uint32_t    index = 0;
+	for (size_t i = 1; i + 1 < response.size(); i += 2) {
+		array.Set(
+		    index++, osn::SceneItem::constructor.New({Napi::Number::New(info.Env(), response[i].value_union.ui64)}));
+	}
 	return array;
 }
 
+Napi::Value osn::Scene::Snap(const Napi::CallbackInfo& info)
+{
+	Napi::Object rect      = info[0].ToObject();
+	float        threshold = info[1].ToNumber().FloatValue();
+	uint64_t     exclude   = UINT64_MAX;
+	if (info.Length() > 2 && info[2].IsObject())
+		exclude = Napi::ObjectWrap<osn::SceneItem>::Unwrap(info[2].ToObject())->itemId;
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper(
+	    "Scene",
+	    "SnapRect",
+	    std::vector<ipc::value>{ipc::value(this->sourceId),
+	                            ipc::value(exclude),
+	                            ipc::value(rect.Get("x").ToNumber().FloatValue()),
+	                            ipc::value(rect.Get("y").ToNumber().FloatValue()),
+	                            ipc::value(rect.Get("width").ToNumber().FloatValue()),
+	                            ipc::value(rect.Get("height").ToNumber().FloatValue()),
+	                            ipc::value(threshold)});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	Napi::Object offset = Napi::Object::New(info.Env());
+	offset.Set("x", Napi::Number::New(info.Env(), response[1].value_union.fp32));
+	offset.Set("y", Napi::Number::New(info.Env(), response[2].value_union.fp32));
+	return offset;
+}
+
 Napi::Value osn::Scene::CallIsConfigurable(const Napi::CallbackInfo& info)
 {
 	return osn::ISource::IsConfigurable(info, this->sourceId);
@@ -676,6 +887,12 @@ void osn::Scene::CallSetEnabled(const Napi::CallbackInfo& info, const Napi::Valu
 	osn::ISource::SetEnabled(info, value, this->sourceId);
 }
 
+Napi::Value osn::Scene::CallGetDuplicationTime(const Napi::CallbackInfo& info)
+{
+	SceneInfo* si = CacheManager<SceneInfo*>::getInstance().Retrieve(this->sourceId);
+	return Napi::Number::New(info.Env(), si ? si->duplicationTime : 0);
+}
+
 Napi::Value osn::Scene::CallRelease(const Napi::CallbackInfo& info)
 {
 	osn::ISource::Release(info, this->sourceId);
@@ -691,6 +908,20 @@ Napi::Value osn::Scene::CallRemove(const Napi::CallbackInfo& info)
 	return info.Env().Undefined();
 }
 
+Napi::Value osn::Scene::CallOpenPropertySession(const Napi::CallbackInfo& info)
+{
+	osn::ISource::OpenPropertySession(info, this->sourceId);
+
+	return info.Env().Undefined();
+}
+
+Napi::Value osn::Scene::CallClosePropertySession(const Napi::CallbackInfo& info)
+{
+	osn::ISource::ClosePropertySession(info, this->sourceId);
+
+	return info.Env().Undefined();
+}
+
 Napi::Value osn::Scene::CallUpdate(const Napi::CallbackInfo& info)
 {
 	osn::ISource::Update(info, this->sourceId);
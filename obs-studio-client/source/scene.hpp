@@ -19,6 +19,7 @@
 #pragma once
 #include <napi.h>
 #include "isource.hpp"
+#include "obs-transform.hpp"
 #include "utility-v8.hpp"
 
 namespace osn
@@ -28,11 +29,18 @@ namespace osn
 		public:
 		uint64_t sourceId;
 
+		// Item changes queued between beginEdit and commitEdit.
+		bool                            editing = false;
+		std::vector<obs::SceneItemEdit> pendingEdits;
+
 		public:
 		static Napi::FunctionReference constructor;
 		static Napi::Object Init(Napi::Env env, Napi::Object exports);
 		Scene(const Napi::CallbackInfo& info);
 
+		// (item id, uid) pairs in scene order, from the cache when current.
+		bool FetchItems(const Napi::CallbackInfo& info, std::vector<std::pair<int64_t, uint64_t>>& items);
+
 		static Napi::Value Create(const Napi::CallbackInfo& info);
 		static Napi::Value CreatePrivate(const Napi::CallbackInfo& info);
 		static Napi::Value FromName(const Napi::CallbackInfo& info);
@@ -49,8 +57,17 @@ namespace osn
 		Napi::Value OrderItems(const Napi::CallbackInfo& info);
 		Napi::Value GetItemAtIndex(const Napi::CallbackInfo& info);
 		Napi::Value GetItems(const Napi::CallbackInfo& info);
+		Napi::Value GetItemIds(const Napi::CallbackInfo& info);
 		Napi::Value GetItemsInRange(const Napi::CallbackInfo& info);
 
+		Napi::Value BeginEdit(const Napi::CallbackInfo& info);
+		Napi::Value EditItem(const Napi::CallbackInfo& info);
+		Napi::Value CommitEdit(const Napi::CallbackInfo& info);
+
+		Napi::Value HitTest(const Napi::CallbackInfo& info);
+		Napi::Value SelectItems(const Napi::CallbackInfo& info);
+		Napi::Value Snap(const Napi::CallbackInfo& info);
+
 		Napi::Value CallIsConfigurable(const Napi::CallbackInfo& info);
 		Napi::Value CallGetProperties(const Napi::CallbackInfo& info);
 		Napi::Value CallGetSettings(const Napi::CallbackInfo& info);
@@ -67,9 +84,12 @@ namespace osn
 		void CallSetMuted(const Napi::CallbackInfo& info, const Napi::Value &value);
 		Napi::Value CallGetEnabled(const Napi::CallbackInfo& info);
 		void CallSetEnabled(const Napi::CallbackInfo& info, const Napi::Value &value);
+		Napi::Value CallGetDuplicationTime(const Napi::CallbackInfo& info);
 
 		Napi::Value CallRelease(const Napi::CallbackInfo& info);
 		Napi::Value CallRemove(const Napi::CallbackInfo& info);
+		Napi::Value CallOpenPropertySession(const Napi::CallbackInfo& info);
+		Napi::Value CallClosePropertySession(const Napi::CallbackInfo& info);
 		Napi::Value CallUpdate(const Napi::CallbackInfo& info);
 		Napi::Value CallLoad(const Napi::CallbackInfo& info);
 		Napi::Value CallSave(const Napi::CallbackInfo& info);
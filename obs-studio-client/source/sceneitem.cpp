@@ -24,6 +24,7 @@
 #include "error.hpp"
 #include "input.hpp"
 #include "ipc-value.hpp"
+#include "obs-transform.hpp"
 #include "scene.hpp"
 #include "sceneitem.hpp"
 #include "shared.hpp"
@@ -63,6 +64,7 @@ Napi::Object osn::SceneItem::Init(Napi::Env env, Napi::Object exports) {
 			InstanceMethod("remove", &osn::SceneItem::Remove),
 			InstanceMethod("deferUpdateBegin", &osn::SceneItem::DeferUpdateBegin),
 			InstanceMethod("deferUpdateEnd", &osn::SceneItem::DeferUpdateEnd),
+			InstanceMethod("setTransform", &osn::SceneItem::SetTransform),
 		});
 	exports.Set("SceneItem", func);
 	osn::SceneItem::constructor = Napi::Persistent(func);
@@ -720,41 +722,47 @@ Napi::Value osn::SceneItem::GetTransformInfo(const Napi::CallbackInfo& info)
 		return info.Env().Undefined();
 
 	std::vector<ipc::value> response = conn->call_synchronous_helper(
-	    "SceneItem", "GetTransformInfo", std::vector<ipc::value>{ipc::value(this->itemId)});
+	    "SceneItem", "GetTransform", std::vector<ipc::value>{ipc::value(this->itemId)});
 
 	if (!ValidateResponse(info, response))
 		return info.Env().Undefined();
 
-	/* Guess we forgot about alignment, not sure where this goes */
-	uint32_t alignment = response[7].value_union.ui32;
+	obs::Transform tf;
+	if (!tf.read(response[1].value_bin))
+		return info.Env().Undefined();
+
+	SceneItemData* sid = CacheManager<SceneItemData*>::getInstance().Retrieve(this->itemId);
+	if (sid)
+		UpdateTransformCache(sid, tf);
 
 	Napi::Object positionObj = Napi::Object::New(info.Env());
-	positionObj.Set("x", Napi::Number::New(info.Env(), response[1].value_union.fp32));
-	positionObj.Set("y", Napi::Number::New(info.Env(), response[2].value_union.fp32));
+	positionObj.Set("x", Napi::Number::New(info.Env(), tf.position_x));
+	positionObj.Set("y", Napi::Number::New(info.Env(), tf.position_y));
 
 	Napi::Object scaleObj = Napi::Object::New(info.Env());
-	scaleObj.Set("x", Napi::Number::New(info.Env(), response[3].value_union.fp32));
-	scaleObj.Set("y", Napi::Number::New(info.Env(), response[4].value_union.fp32));
+	scaleObj.Set("x", Napi::Number::New(info.Env(), tf.scale_x));
+	scaleObj.Set("y", Napi::Number::New(info.Env(), tf.scale_y));
 
 	Napi::Object boundsObj = Napi::Object::New(info.Env());
-	boundsObj.Set("x", Napi::Number::New(info.Env(), response[8].value_union.fp32));
-	boundsObj.Set("y", Napi::Number::New(info.Env(), response[9].value_union.fp32));
+	boundsObj.Set("x", Napi::Number::New(info.Env(), tf.bounds_x));
+	boundsObj.Set("y", Napi::Number::New(info.Env(), tf.bounds_y));
 
 	Napi::Object cropObj = Napi::Object::New(info.Env());
-	boundsObj.Set("left", Napi::Number::New(info.Env(), response[12].value_union.ui32));
-	boundsObj.Set("top", Napi::Number::New(info.Env(), response[13].value_union.ui32));
-	boundsObj.Set("right", Napi::Number::New(info.Env(), response[14].value_union.ui32));
-	boundsObj.Set("bottom", Napi::Number::New(info.Env(), response[15].value_union.ui32));
+	cropObj.Set("left", Napi::Number::New(info.Env(), tf.crop_left));
+	cropObj.Set("top", Napi::Number::New(info.Env(), tf.crop_top));
+	cropObj.Set("right", Napi::Number::New(info.Env(), tf.crop_right));
+	cropObj.Set("bottom", Napi::Number::New(info.Env(), tf.crop_bottom));
 
 	Napi::Object obj = Napi::Object::New(info.Env());
 	obj.Set("pos", positionObj);
+	obj.Set("rot", Napi::Number::New(info.Env(), tf.rotation));
 	obj.Set("scale", scaleObj);
+	obj.Set("alignment", Napi::Number::New(info.Env(), tf.alignment));
+	obj.Set("boundsType", Napi::Number::New(info.Env(), tf.bounds_type));
+	obj.Set("boundsAlignment", Napi::Number::New(info.Env(), tf.bounds_alignment));
 	obj.Set("bounds", boundsObj);
 	obj.Set("crop", cropObj);
-	obj.Set("scaleFilter", Napi::Number::New(info.Env(), response[5].value_union.ui32));
-	obj.Set("rotation", Napi::Number::New(info.Env(), response[6].value_union.fp32));
-	obj.Set("boundsType", Napi::Number::New(info.Env(), response[10].value_union.ui32));
-	obj.Set("boundsAlignment", Napi::Number::New(info.Env(), response[11].value_union.ui32));
+	obj.Set("scaleFilter", Napi::Number::New(info.Env(), tf.scale_filter));
 
 	return obj;
 }
@@ -876,3 +884,103 @@ Napi::Value osn::SceneItem::DeferUpdateEnd(const Napi::CallbackInfo& info)
 	conn->call("SceneItem", "DeferUpdateEnd", std::vector<ipc::value>{ipc::value(this->itemId)});
 	return info.Env().Undefined();
 }
+
+Napi::Value osn::SceneItem::SetTransform(const Napi::CallbackInfo& info)
+{
+	if (info.Length() < 1 || !info[0].IsObject()) {
+		Napi::TypeError::New(info.Env(), "Object expected").ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+
+	obs::Transform tf;
+	ParseTransform(info[0].ToObject(), tf);
+
+	if (tf.mask == 0)
+		return info.Env().Undefined();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper(
+	    "SceneItem", "SetTransform", std::vector<ipc::value>{ipc::value(this->itemId), ipc::value(tf.serialize())});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	SceneItemData* sid = CacheManager<SceneItemData*>::getInstance().Retrieve(this->itemId);
+	if (sid && tf.read(response[1].value_bin))
+		UpdateTransformCache(sid, tf);
+
+	return info.Env().Undefined();
+}
+
+void osn::SceneItem::UpdateTransformCache(SceneItemData* sid, const obs::Transform& tf)
+{
+	sid->posX       = tf.position_x;
+	sid->posY       = tf.position_y;
+	sid->posChanged = false;
+
+	sid->scaleX       = tf.scale_x;
+	sid->scaleY       = tf.scale_y;
+	sid->scaleChanged = false;
+
+	sid->rotation        = tf.rotation;
+	sid->rotationChanged = false;
+
+	sid->cropLeft    = tf.crop_left;
+	sid->cropTop     = tf.crop_top;
+	sid->cropRight   = tf.crop_right;
+	sid->cropBottom  = tf.crop_bottom;
+	sid->cropChanged = false;
+}
+
+void osn::SceneItem::ParseTransform(const Napi::Object& transform, obs::Transform& tf)
+{
+	if (transform.Has("position")) {
+		Napi::Object vector = transform.Get("position").ToObject();
+		tf.mask |= obs::Transform::Position;
+		tf.position_x = vector.Get("x").ToNumber().FloatValue();
+		tf.position_y = vector.Get("y").ToNumber().FloatValue();
+	}
+	if (transform.Has("rotation")) {
+		tf.mask |= obs::Transform::Rotation;
+		tf.rotation = transform.Get("rotation").ToNumber().FloatValue();
+	}
+	if (transform.Has("scale")) {
+		Napi::Object vector = transform.Get("scale").ToObject();
+		tf.mask |= obs::Transform::Scale;
+		tf.scale_x = vector.Get("x").ToNumber().FloatValue();
+		tf.scale_y = vector.Get("y").ToNumber().FloatValue();
+	}
+	if (transform.Has("alignment")) {
+		tf.mask |= obs::Transform::Alignment;
+		tf.alignment = transform.Get("alignment").ToNumber().Uint32Value();
+	}
+	if (transform.Has("bounds")) {
+		Napi::Object vector = transform.Get("bounds").ToObject();
+		tf.mask |= obs::Transform::Bounds;
+		tf.bounds_x = vector.Get("x").ToNumber().FloatValue();
+		tf.bounds_y = vector.Get("y").ToNumber().FloatValue();
+	}
+	if (transform.Has("boundsType")) {
+		tf.mask |= obs::Transform::BoundsType;
+		tf.bounds_type = transform.Get("boundsType").ToNumber().Int32Value();
+	}
+	if (transform.Has("boundsAlignment")) {
+		tf.mask |= obs::Transform::BoundsAlignment;
+		tf.bounds_alignment = transform.Get("boundsAlignment").ToNumber().Uint32Value();
+	}
+	if (transform.Has("crop")) {
+		Napi::Object crop = transform.Get("crop").ToObject();
+		tf.mask |= obs::Transform::Crop;
+		tf.crop_left   = crop.Get("left").ToNumber().Int32Value();
+		tf.crop_top    = crop.Get("top").ToNumber().Int32Value();
+		tf.crop_right  = crop.Get("right").ToNumber().Int32Value();
+		tf.crop_bottom = crop.Get("bottom").ToNumber().Int32Value();
+	}
+	if (transform.Has("scaleFilter")) {
+		tf.mask |= obs::Transform::ScaleFilter;
+		tf.scale_filter = transform.Get("scaleFilter").ToNumber().Int32Value();
+	}
+}
@@ -19,6 +19,7 @@
 #pragma once
 #include <napi.h>
 #include "isource.hpp"
+#include "obs-transform.hpp"
 #include "utility-v8.hpp"
 
 namespace osn
@@ -75,5 +76,9 @@ namespace osn
 		Napi::Value Move(const Napi::CallbackInfo& info);
 		Napi::Value DeferUpdateBegin(const Napi::CallbackInfo& info);
 		Napi::Value DeferUpdateEnd(const Napi::CallbackInfo& info);
+		Napi::Value SetTransform(const Napi::CallbackInfo& info);
+
+		static void ParseTransform(const Napi::Object& transform, obs::Transform& tf);
+		static void UpdateTransformCache(SceneItemData* sid, const obs::Transform& tf);
 	};
 }
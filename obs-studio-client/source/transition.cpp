@@ -20,9 +20,11 @@
 #include <condition_variable>
 #include <mutex>
 #include <string>
+#include "callback-manager.hpp"
 #include "controller.hpp"
 #include "error.hpp"
 #include "ipc-value.hpp"
+#include "obs-source-type.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
 
@@ -35,12 +37,14 @@ Napi::Object osn::Transition::Init(Napi::Env env, Napi::Object exports) {
 		"Transition",
 		{
 			StaticMethod("types", &osn::Transition::Types),
+			StaticMethod("typeCatalog", &osn::Transition::TypeCatalog),
 			StaticMethod("create", &osn::Transition::Create),
 			StaticMethod("createPrivate", &osn::Transition::CreatePrivate),
 			StaticMethod("fromName", &osn::Transition::FromName),
 
 			InstanceMethod("getActiveSource", &osn::Transition::GetActiveSource),
 			InstanceMethod("start", &osn::Transition::Start),
+			InstanceMethod("prepare", &osn::Transition::Prepare),
 			InstanceMethod("set", &osn::Transition::Set),
 			InstanceMethod("clear", &osn::Transition::Clear),
 
@@ -58,6 +62,8 @@ Napi::Object osn::Transition::Init(Napi::Env env, Napi::Object exports) {
 
 			InstanceMethod("release", &osn::Transition::CallRelease),
 			InstanceMethod("remove", &osn::Transition::CallRemove),
+			InstanceMethod("openPropertySession", &osn::Transition::CallOpenPropertySession),
+			InstanceMethod("closePropertySession", &osn::Transition::CallClosePropertySession),
 			InstanceMethod("update", &osn::Transition::CallUpdate),
 			InstanceMethod("load", &osn::Transition::CallLoad),
 			InstanceMethod("save", &osn::Transition::CallSave),
@@ -89,23 +95,12 @@ osn::Transition::Transition(const Napi::CallbackInfo& info)
 
 Napi::Value osn::Transition::Types(const Napi::CallbackInfo& info)
 {
-	auto conn = GetConnection(info);
-	if (!conn)
-		return info.Env().Undefined();
-
-	std::vector<ipc::value> response = conn->call_synchronous_helper("Transition", "Types", {});
-
-	if (!ValidateResponse(info, response))
-		return info.Env().Undefined();
-
-	size_t count = response.size() - 1;
-	Napi::Array types = Napi::Array::New(info.Env(), count);
-
-	for (size_t idx = 0; idx < count; idx++) {
-		types.Set(idx, Napi::String::New(info.Env(), response[1 + idx].value_str));
-	}
+	return osn::ISource::GetTypes(info, obs::SourceTypeEntry::Transition);
+}
 
-	return types;
+Napi::Value osn::Transition::TypeCatalog(const Napi::CallbackInfo& info)
+{
+	return osn::ISource::GetTypeCatalog(info, obs::SourceTypeEntry::Transition);
 }
 
 Napi::Value osn::Transition::Create(const Napi::CallbackInfo& info)
@@ -299,6 +294,28 @@ Napi::Value osn::Transition::Start(const Napi::CallbackInfo& info)
 	return Napi::Boolean::New(info.Env(), !!response[1].value_union.i32);
 }
 
+Napi::Value osn::Transition::Prepare(const Napi::CallbackInfo& info)
+{
+	osn::Scene*    scene    = Napi::ObjectWrap<osn::Scene>::Unwrap(info[0].ToObject());
+	uint32_t       timeout  = info[1].ToNumber().Uint32Value();
+	Napi::Function callback = info[2].As<Napi::Function>();
+
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	// Register first, the readiness may arrive with the very next poll.
+	globalCallback::add_transition_callback(info.Env(), this->sourceId, scene->sourceId, callback);
+
+	auto params = std::vector<ipc::value>{ipc::value(this->sourceId), ipc::value(scene->sourceId), ipc::value(timeout)};
+
+	std::vector<ipc::value> response = conn->call_synchronous_helper("Transition", "Prepare", {std::move(params)});
+
+	if (!ValidateResponse(info, response))
+		globalCallback::remove_transition_callback(this->sourceId, scene->sourceId);
+	return info.Env().Undefined();
+}
+
 Napi::Value osn::Transition::CallIsConfigurable(const Napi::CallbackInfo& info)
 {
 	return osn::ISource::IsConfigurable(info, this->sourceId);
@@ -391,6 +408,20 @@ Napi::Value osn::Transition::CallRemove(const Napi::CallbackInfo& info)
 	return info.Env().Undefined();
 }
 
+Napi::Value osn::Transition::CallOpenPropertySession(const Napi::CallbackInfo& info)
+{
+	osn::ISource::OpenPropertySession(info, this->sourceId);
+
+	return info.Env().Undefined();
+}
+
+Napi::Value osn::Transition::CallClosePropertySession(const Napi::CallbackInfo& info)
+{
+	osn::ISource::ClosePropertySession(info, this->sourceId);
+
+	return info.Env().Undefined();
+}
+
 Napi::Value osn::Transition::CallUpdate(const Napi::CallbackInfo& info)
 {
 	osn::ISource::Update(info, this->sourceId);
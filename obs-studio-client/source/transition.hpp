@@ -36,6 +36,7 @@ namespace osn
 		Transition(const Napi::CallbackInfo& info);
 
 		static Napi::Value Types(const Napi::CallbackInfo& info);
+		static Napi::Value TypeCatalog(const Napi::CallbackInfo& info);
 		static Napi::Value Create(const Napi::CallbackInfo& info);
 		static Napi::Value CreatePrivate(const Napi::CallbackInfo& info);
 		static Napi::Value FromName(const Napi::CallbackInfo& info);
@@ -44,6 +45,7 @@ namespace osn
 		Napi::Value Clear(const Napi::CallbackInfo& info);
 		Napi::Value Set(const Napi::CallbackInfo& info);
 		Napi::Value Start(const Napi::CallbackInfo& info);
+		Napi::Value Prepare(const Napi::CallbackInfo& info);
 
 		Napi::Value CallIsConfigurable(const Napi::CallbackInfo& info);
 		Napi::Value CallGetProperties(const Napi::CallbackInfo& info);
@@ -64,6 +66,8 @@ namespace osn
 
 		Napi::Value CallRelease(const Napi::CallbackInfo& info);
 		Napi::Value CallRemove(const Napi::CallbackInfo& info);
+		Napi::Value CallOpenPropertySession(const Napi::CallbackInfo& info);
+		Napi::Value CallClosePropertySession(const Napi::CallbackInfo& info);
 		Napi::Value CallUpdate(const Napi::CallbackInfo& info);
 		Napi::Value CallLoad(const Napi::CallbackInfo& info);
 		Napi::Value CallSave(const Napi::CallbackInfo& info);
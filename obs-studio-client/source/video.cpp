@@ -19,6 +19,7 @@
 #include "video.hpp"
 #include <error.hpp>
 #include "controller.hpp"
+#include "obs-shared-memory.hpp"
 #include "shared.hpp"
 #include "utility-v8.hpp"
 #include "utility.hpp"
@@ -34,6 +35,9 @@ Napi::Object osn::Video::Init(Napi::Env env, Napi::Object exports) {
 		{
 			StaticAccessor("skippedFrames", &osn::Video::skippedFrames, nullptr),
 			StaticAccessor("encodedFrames", &osn::Video::encodedFrames, nullptr),
+			StaticAccessor("frameStats", &osn::Video::frameStats, nullptr),
+			StaticMethod("getRenderTiming", &osn::Video::getRenderTiming),
+			StaticMethod("getRenderTimingWindow", &osn::Video::getRenderTimingWindow),
 		});
 	exports.Set("Video", func);
 	osn::Video::constructor = Napi::Persistent(func);
@@ -47,8 +51,119 @@ osn::Video::Video(const Napi::CallbackInfo& info)
     Napi::HandleScope scope(env);
 }
 
+static obs::SharedMemory          frame_stats_memory;
+static const obs::FrameStatsPage* frame_stats_page    = nullptr;
+static bool                       frame_stats_checked = false;
+
+bool osn::Video::ReadFrameStats(const Napi::CallbackInfo& info, obs::FrameStats& stats)
+{
+	if (!frame_stats_checked) {
+		frame_stats_checked = true;
+
+		auto conn = GetConnection(info);
+		if (!conn)
+			return false;
+
+		std::vector<ipc::value> response = conn->call_synchronous_helper("Video", "GetStatsPage", {});
+		if (response.size() < 3 || (ErrorCode)response[0].value_union.ui64 != ErrorCode::Ok)
+			return false;
+		if (response[2].value_union.ui32 != sizeof(obs::FrameStatsPage))
+			return false;
+
+		if (frame_stats_memory.open(response[1].value_str, sizeof(obs::FrameStatsPage))) {
+			auto page = static_cast<const obs::FrameStatsPage*>(frame_stats_memory.data());
+			if (page->valid())
+				frame_stats_page = page;
+			else
+				frame_stats_memory.close();
+		}
+	}
+
+	return frame_stats_page && frame_stats_page->read(stats);
+}
+
+void osn::Video::CloseFrameStats()
+{
+	frame_stats_page    = nullptr;
+	frame_stats_checked = false;
+	frame_stats_memory.close();
+}
+
+Napi::Value osn::Video::frameStats(const Napi::CallbackInfo& info)
+{
+	obs::FrameStats stats;
+	if (!ReadFrameStats(info, stats))
+		return info.Env().Undefined();
+
+	Napi::Object object = Napi::Object::New(info.Env());
+	object.Set("renderedFrames", Napi::Number::New(info.Env(), double(stats.render_total)));
+	object.Set("laggedFrames", Napi::Number::New(info.Env(), double(stats.render_lagged)));
+	object.Set("encodedFrames", Napi::Number::New(info.Env(), double(stats.video_total)));
+	object.Set("skippedFrames", Napi::Number::New(info.Env(), double(stats.video_skipped)));
+	object.Set("outputFrames", Napi::Number::New(info.Env(), double(stats.output_total)));
+	object.Set("outputDroppedFrames", Napi::Number::New(info.Env(), double(stats.output_dropped)));
+	object.Set("outputCongestion", Napi::Number::New(info.Env(), stats.output_congestion));
+	object.Set("activeFps", Napi::Number::New(info.Env(), stats.active_fps));
+	object.Set("averageFrameTime", Napi::Number::New(info.Env(), double(stats.average_frame_time) / 1000000.0));
+	return object;
+}
+
+static Napi::Value RenderTiming(const Napi::CallbackInfo& info, uint32_t seconds, bool reset)
+{
+	auto conn = GetConnection(info);
+	if (!conn)
+		return info.Env().Undefined();
+
+	std::vector<ipc::value> response =
+	    conn->call_synchronous_helper("Video", "GetRenderTiming", {ipc::value(seconds), ipc::value(uint32_t(reset))});
+
+	if (!ValidateResponse(info, response))
+		return info.Env().Undefined();
+
+	obs::RenderTiming timing;
+	if (response.size() < 2 || !timing.read(response[1].value_bin)) {
+		Napi::Error::New(info.Env(), "Malformed render timing response").ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+
+	auto ms = [&info](uint64_t ns) { return Napi::Number::New(info.Env(), double(ns) / 1000000.0); };
+
+	Napi::Object object = Napi::Object::New(info.Env());
+	object.Set("frames", Napi::Number::New(info.Env(), double(timing.frames)));
+	object.Set("overBudgetFrames", Napi::Number::New(info.Env(), double(timing.over_budget)));
+	object.Set("overTwiceBudgetFrames", Napi::Number::New(info.Env(), double(timing.over_twice_budget)));
+	object.Set("budget", ms(timing.budget));
+	object.Set("mean", ms(timing.mean));
+	object.Set("p50", ms(timing.p50));
+	object.Set("p95", ms(timing.p95));
+	object.Set("p99", ms(timing.p99));
+	object.Set("max", ms(timing.max));
+	object.Set("duration", ms(timing.duration));
+	return object;
+}
+
+Napi::Value osn::Video::getRenderTiming(const Napi::CallbackInfo& info)
+{
+	bool reset = info.Length() > 0 && info[0].ToBoolean().Value();
+	return RenderTiming(info, 0, reset);
+}
+
+Napi::Value osn::Video::getRenderTimingWindow(const Napi::CallbackInfo& info)
+{
+	uint32_t seconds = info[0].ToNumber().Uint32Value();
+	if (seconds == 0) {
+		Napi::Error::New(info.Env(), "Argument 'seconds' must be at least 1.").ThrowAsJavaScriptException();
+		return info.Env().Undefined();
+	}
+	return RenderTiming(info, seconds, false);
+}
+
 Napi::Value osn::Video::skippedFrames(const Napi::CallbackInfo& info)
 {
+	obs::FrameStats stats;
+	if (ReadFrameStats(info, stats))
+		return Napi::Number::New(info.Env(), double(stats.video_skipped));
+
 	auto conn = GetConnection(info);
 	if (!conn)
 		return info.Env().Undefined();
@@ -64,6 +179,10 @@ Napi::Value osn::Video::skippedFrames(const Napi::CallbackInfo& info)
 
 Napi::Value osn::Video::encodedFrames(const Napi::CallbackInfo& info)
 {
+	obs::FrameStats stats;
+	if (ReadFrameStats(info, stats))
+		return Napi::Number::New(info.Env(), double(stats.video_total));
+
 	auto conn = GetConnection(info);
 	if (!conn)
 		return info.Env().Undefined();
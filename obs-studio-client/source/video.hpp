@@ -18,6 +18,8 @@
 
 #pragma once
 #include <napi.h>
+#include "obs-frame-stats.hpp"
+#include "obs-render-timing.hpp"
 #include "utility-v8.hpp"
 
 namespace osn
@@ -31,5 +33,14 @@ namespace osn
 
 		static Napi::Value skippedFrames(const Napi::CallbackInfo& info);
 		static Napi::Value encodedFrames(const Napi::CallbackInfo& info);
+		static Napi::Value frameStats(const Napi::CallbackInfo& info);
+		static Napi::Value getRenderTiming(const Napi::CallbackInfo& info);
+		static Napi::Value getRenderTimingWindow(const Napi::CallbackInfo& info);
+
+		// Reads the counters from the page the server publishes. The page is
+		// looked up with one IPC call on first use; returns false if the
+		// server does not publish one and callers have to ask over IPC.
+		static bool ReadFrameStats(const Napi::CallbackInfo& info, obs::FrameStats& stats);
+		static void CloseFrameStats();
 	};
 }
@@ -0,0 +1,87 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace bench
+{
+	// A server thread answering one call at a time, like an IPC connection.
+	// Each call hands a request buffer over and waits for the answer, so a
+	// benchmark pays one thread round trip per call. That is a lower bound
+	// of a named pipe round trip, real calls cost more.
+	class RoundTrip
+	{
+		public:
+		typedef std::function<std::vector<char>(std::vector<char> const&)> Handler;
+
+		RoundTrip(Handler handler) : handler(handler), worker(&RoundTrip::run, this) {}
+
+		~RoundTrip()
+		{
+			{
+				std::unique_lock<std::mutex> ulock(mtx);
+				running = false;
+			}
+			cv.notify_all();
+			worker.join();
+		}
+
+		std::vector<char> call(std::vector<char> const& request)
+		{
+			std::unique_lock<std::mutex> ulock(mtx);
+			this->request = &request;
+			answered      = false;
+			cv.notify_all();
+			cv.wait(ulock, [this] { return answered; });
+			return std::move(answer);
+		}
+
+		private:
+		void run()
+		{
+			std::unique_lock<std::mutex> ulock(mtx);
+			while (true) {
+				cv.wait(ulock, [this] { return !running || request; });
+				if (!running)
+					return;
+				std::vector<char> const* pending = request;
+				request                          = nullptr;
+				ulock.unlock();
+				std::vector<char> result = handler(*pending);
+				ulock.lock();
+				answer   = std::move(result);
+				answered = true;
+				cv.notify_all();
+			}
+		}
+
+		Handler                  handler;
+		std::mutex               mtx;
+		std::condition_variable  cv;
+		std::vector<char> const* request  = nullptr;
+		std::vector<char>        answer;
+		bool                     answered = false;
+		bool                     running  = true;
+		std::thread              worker;
+	};
+} // namespace bench
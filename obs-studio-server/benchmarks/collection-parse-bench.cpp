@@ -0,0 +1,178 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+// Standalone benchmark of the parsing stage of Collection.Load. A synthetic
+// collection is either parsed as one document and its sources re-encoded
+// one after the other, or parsed with the streaming callback Load uses,
+// which hands every source to a pool of workers as soon as it is complete.
+// The workers re-encode the source, as Load does before handing it to
+// obs_data_create_from_json. Creating the sources needs libobs and is not
+// part of this benchmark. Build it on its own, nlohmann/json has to be on
+// the include path:
+//
+//   cmake -S obs-studio-server/benchmarks -B build-bench -DCMAKE_BUILD_TYPE=Release
+//   cmake --build build-bench && ./build-bench/collection-parse-bench [sources]
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "nlohmann/json.hpp"
+
+typedef std::chrono::steady_clock clock_type;
+
+namespace
+{
+	std::string make_collection(size_t sources)
+	{
+		nlohmann::json list = nlohmann::json::array();
+		for (size_t idx = 0; idx < sources; idx++) {
+			nlohmann::json source;
+			source["id"]       = "image_source";
+			source["name"]     = "Source " + std::to_string(idx);
+			source["settings"] = {{"file", "C:/Users/user/Pictures/overlay" + std::to_string(idx) + ".png"},
+			                      {"unload", true},
+			                      {"linear_alpha", false}};
+			source["volume"]   = 1.0;
+			source["muted"]    = false;
+			source["flags"]    = 0;
+			source["filters"]  = nlohmann::json::array();
+			for (int filter = 0; filter < 2; filter++) {
+				source["filters"].push_back(
+				    {{"id", "crop_filter"},
+				     {"name", "Crop " + std::to_string(filter)},
+				     {"settings", {{"left", 10}, {"top", 10}, {"right", 10}, {"bottom", 10}}}});
+			}
+			list.push_back(source);
+		}
+
+		nlohmann::json scene;
+		scene["id"]       = "scene";
+		scene["name"]     = "Scene";
+		scene["settings"] = {{"items", nlohmann::json::array()}};
+		for (size_t idx = 0; idx < sources; idx++) {
+			scene["settings"]["items"].push_back(
+			    {{"name", "Source " + std::to_string(idx)},
+			     {"pos", {{"x", double(idx)}, {"y", double(idx)}}},
+			     {"scale", {{"x", 1.0}, {"y", 1.0}}},
+			     {"visible", true}});
+		}
+		list.push_back(scene);
+
+		return nlohmann::json({{"sources", list}, {"current_scene", "Scene"}}).dump();
+	}
+
+	// Sources per second, parsing the whole document first.
+	double whole_document(std::string const& text, size_t sources, int iterations)
+	{
+		size_t bytes = 0;
+		auto   begin = clock_type::now();
+		for (int iteration = 0; iteration < iterations; iteration++) {
+			nlohmann::json document = nlohmann::json::parse(text);
+			for (auto& source : document["sources"])
+				bytes += source.dump().size();
+		}
+		double elapsed = std::chrono::duration<double>(clock_type::now() - begin).count();
+		return bytes ? sources * iterations / elapsed : 0;
+	}
+
+	// Sources per second with the streaming parse and the worker pool of
+	// Collection.Load.
+	double streaming(std::string const& text, size_t sources, int iterations)
+	{
+		size_t threads = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+		auto   begin   = clock_type::now();
+		for (int iteration = 0; iteration < iterations; iteration++) {
+			std::deque<std::shared_ptr<nlohmann::json>> queue;
+			std::mutex                                  mtx;
+			std::condition_variable                     cv;
+			bool                                        done  = false;
+			size_t                                      bytes = 0;
+
+			std::vector<std::thread> workers;
+			for (size_t idx = 0; idx < threads; idx++) {
+				workers.emplace_back([&] {
+					std::unique_lock<std::mutex> lock(mtx);
+					while (true) {
+						cv.wait(lock, [&] { return done || !queue.empty(); });
+						if (queue.empty())
+							return;
+						auto json = std::move(queue.front());
+						queue.pop_front();
+						lock.unlock();
+						size_t size = json->dump().size();
+						lock.lock();
+						bytes += size;
+					}
+				});
+			}
+
+			bool in_sources = false;
+			auto callback   = [&](int depth, nlohmann::json::parse_event_t event, nlohmann::json& parsed) {
+				if (event == nlohmann::json::parse_event_t::key && depth == 1) {
+					in_sources = (parsed == "sources");
+				} else if (event == nlohmann::json::parse_event_t::object_end && depth == 2 && in_sources) {
+					auto json = std::make_shared<nlohmann::json>(std::move(parsed));
+					std::unique_lock<std::mutex> lock(mtx);
+					queue.push_back(json);
+					cv.notify_one();
+					return false;
+				}
+				return true;
+			};
+			nlohmann::json frontend = nlohmann::json::parse(text, callback);
+
+			{
+				std::unique_lock<std::mutex> lock(mtx);
+				done = true;
+				cv.notify_all();
+			}
+			for (auto& worker : workers)
+				worker.join();
+		}
+		return sources * iterations / std::chrono::duration<double>(clock_type::now() - begin).count();
+	}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+	int sources = argc > 1 ? std::atoi(argv[1]) : 1000;
+	if (sources <= 0)
+		sources = 1000;
+
+	std::string text       = make_collection(size_t(sources));
+	int         iterations = std::max(1, 20000 / sources);
+
+	double whole  = whole_document(text, size_t(sources) + 1, iterations);
+	double stream = streaming(text, size_t(sources) + 1, iterations);
+	std::printf(
+	    "%d sources, %.1f KiB  whole document %9.1f sources/s  streaming %9.1f sources/s  x%.1f\n",
+	    sources,
+	    text.size() / 1024.0,
+	    whole,
+	    stream,
+	    stream / whole);
+	return 0;
+}
@@ -0,0 +1,205 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+// Standalone stress benchmark of osn::Dispatch. Simulates the server's
+// connection threads: a main connection carrying slow settings calls and
+// object changes, and polling threads issuing cheap read-only queries. The
+// queries either share the main connection, as before, or use their own
+// connections and run under the dispatch locks. Reports the latency of the
+// cheap queries. Build it on its own:
+//
+//   cmake -S obs-studio-server/benchmarks -B build-bench -DCMAKE_BUILD_TYPE=Release
+//   cmake --build build-bench && ./build-bench/dispatch-latency-bench [seconds]
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "osn-dispatch.hpp"
+
+using osn::Dispatch;
+typedef std::chrono::steady_clock clock_type;
+
+namespace
+{
+	void busy(std::chrono::microseconds duration)
+	{
+		auto end = clock_type::now() + duration;
+		while (clock_type::now() < end)
+			;
+	}
+
+	// One IPC connection: calls are handled one after the other on the
+	// connection's thread, the caller blocks until its call is answered.
+	class Connection
+	{
+		public:
+		Connection() : worker(&Connection::run, this) {}
+
+		~Connection()
+		{
+			{
+				std::unique_lock<std::mutex> ulock(mtx);
+				running = false;
+			}
+			cv.notify_all();
+			worker.join();
+		}
+
+		void call(Dispatch::Access access, std::chrono::microseconds duration)
+		{
+			auto pending = std::make_shared<Call>();
+			pending->access   = access;
+			pending->duration = duration;
+
+			std::unique_lock<std::mutex> ulock(mtx);
+			queue.push_back(pending);
+			cv.notify_all();
+			cv.wait(ulock, [&pending] { return pending->done; });
+		}
+
+		private:
+		struct Call
+		{
+			Dispatch::Access          access;
+			std::chrono::microseconds duration;
+			bool                      done = false;
+		};
+
+		void run()
+		{
+			std::unique_lock<std::mutex> ulock(mtx);
+			while (running) {
+				if (queue.empty()) {
+					cv.wait(ulock);
+					continue;
+				}
+				auto pending = queue.front();
+				queue.pop_front();
+				ulock.unlock();
+				{
+					Dispatch::Scope scope(pending->access);
+					busy(pending->duration);
+				}
+				ulock.lock();
+				pending->done = true;
+				cv.notify_all();
+			}
+		}
+
+		std::mutex                        mtx;
+		std::condition_variable           cv;
+		std::deque<std::shared_ptr<Call>> queue;
+		bool                              running = true;
+		std::thread                       worker;
+	};
+
+	struct Result
+	{
+		std::vector<double> latencies;
+		size_t              slow_calls = 0;
+	};
+
+	Result run(bool dispatch, std::chrono::seconds duration)
+	{
+		Connection        main_connection;
+		Connection        query_connections[2];
+		std::atomic<bool> running{true};
+		std::mutex        results_mtx;
+		Result            result;
+
+		// Main thread of the client: a slow settings call (like building a
+		// settings category), then a few object changes, then a pause.
+		std::thread client([&] {
+			while (running) {
+				main_connection.call(Dispatch::Access::Config, std::chrono::milliseconds(40));
+				for (int i = 0; i < 4; i++)
+					main_connection.call(Dispatch::Access::Write, std::chrono::microseconds(500));
+				result.slow_calls++;
+				std::this_thread::sleep_for(std::chrono::milliseconds(20));
+			}
+		});
+
+		// Polling threads: volume meters, output and auto config events.
+		std::vector<std::thread> pollers;
+		for (size_t idx = 0; idx < 3; idx++) {
+			pollers.emplace_back([&, idx] {
+				Connection&         connection = dispatch ? query_connections[idx % 2] : main_connection;
+				std::vector<double> latencies;
+				while (running) {
+					auto begin = clock_type::now();
+					connection.call(Dispatch::Access::Read, std::chrono::microseconds(20));
+					latencies.push_back(
+					    std::chrono::duration<double, std::milli>(clock_type::now() - begin).count());
+					std::this_thread::sleep_for(std::chrono::milliseconds(2));
+				}
+				std::unique_lock<std::mutex> ulock(results_mtx);
+				result.latencies.insert(result.latencies.end(), latencies.begin(), latencies.end());
+			});
+		}
+
+		std::this_thread::sleep_for(duration);
+		running = false;
+		client.join();
+		for (auto& poller : pollers)
+			poller.join();
+
+		std::sort(result.latencies.begin(), result.latencies.end());
+		return result;
+	}
+
+	double percentile(const std::vector<double>& sorted, double p)
+	{
+		if (sorted.empty())
+			return 0;
+		size_t idx = std::min(sorted.size() - 1, size_t(p * double(sorted.size())));
+		return sorted[idx];
+	}
+
+	void report(const char* name, const Result& result)
+	{
+		const auto& l = result.latencies;
+		std::printf(
+		    "%-22s %7zu queries  p50 %7.3f ms  p95 %7.3f ms  p99 %7.3f ms  max %7.3f ms  (%zu slow rounds)\n",
+		    name,
+		    l.size(),
+		    percentile(l, 0.50),
+		    percentile(l, 0.95),
+		    percentile(l, 0.99),
+		    l.empty() ? 0.0 : l.back(),
+		    result.slow_calls);
+	}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+	int seconds = argc > 1 ? std::atoi(argv[1]) : 3;
+	if (seconds <= 0)
+		seconds = 3;
+
+	report("one connection", run(false, std::chrono::seconds(seconds)));
+	report("query connections", run(true, std::chrono::seconds(seconds)));
+	return 0;
+}
@@ -0,0 +1,138 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+// Standalone benchmark of the Input.CreateBulk wire format. Imports inputs
+// with one filter and one scene item each, either with the four calls the
+// client used to make per input (create the input and the filter, attach
+// the filter, add the input to the scene) or with one CreateBulk request.
+// Calls go through a simulated connection whose server side decodes the
+// request and answers with new ids, like the handlers do. Build it on its
+// own:
+//
+//   cmake -S obs-studio-server/benchmarks -B build-bench -DCMAKE_BUILD_TYPE=Release
+//   cmake --build build-bench && ./build-bench/import-bench [iterations]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+#include <vector>
+#include "bench-round-trip.hpp"
+#include "obs-import.hpp"
+
+typedef std::chrono::steady_clock clock_type;
+
+namespace
+{
+	const std::string settings = "{\"file\":\"C:/Users/user/Pictures/overlay.png\",\"unload\":true}";
+
+	// Single calls carry their strings and get an id back.
+	std::vector<char> single_call(std::vector<char> const& request)
+	{
+		obs::BufferReader in(request);
+		std::string       value;
+		while (in.read(value))
+			;
+		obs::BufferWriter out;
+		out.write<uint64_t>(1);
+		return std::move(out.data());
+	}
+
+	std::vector<char> create_bulk(std::vector<char> const& request)
+	{
+		std::vector<obs::InputDefinition> definitions;
+		obs::read_definitions(request, definitions);
+
+		std::vector<obs::InputImportResult> results(definitions.size());
+		uint64_t                            uid = 0;
+		for (size_t idx = 0; idx < definitions.size(); idx++) {
+			results[idx].uid = uid++;
+			for (size_t fdx = 0; fdx < definitions[idx].filters.size(); fdx++)
+				results[idx].filters.push_back(uid++);
+			for (size_t pdx = 0; pdx < definitions[idx].placements.size(); pdx++)
+				results[idx].items.push_back({uid++, int64_t(pdx)});
+		}
+		return obs::serialize_results(results);
+	}
+
+	std::vector<char> strings(std::initializer_list<std::string> values)
+	{
+		obs::BufferWriter out;
+		for (auto& value : values)
+			out.write(value);
+		return std::move(out.data());
+	}
+
+	// Imports per second when every input takes four calls.
+	double per_call(size_t inputs, int iterations)
+	{
+		bench::RoundTrip connection(single_call);
+		auto             begin = clock_type::now();
+		for (int iteration = 0; iteration < iterations; iteration++) {
+			for (size_t idx = 0; idx < inputs; idx++) {
+				std::string name = "input" + std::to_string(idx);
+				connection.call(strings({"image_source", name, settings}));
+				connection.call(strings({"crop_filter", name + " crop", "{}"}));
+				connection.call(strings({"1", "2"}));
+				connection.call(strings({"3", "1"}));
+			}
+		}
+		return iterations / std::chrono::duration<double>(clock_type::now() - begin).count();
+	}
+
+	// Imports per second when the whole import is one CreateBulk call.
+	double bulk(size_t inputs, int iterations)
+	{
+		bench::RoundTrip connection(create_bulk);
+		auto             begin = clock_type::now();
+		for (int iteration = 0; iteration < iterations; iteration++) {
+			std::vector<obs::InputDefinition> definitions(inputs);
+			for (size_t idx = 0; idx < inputs; idx++) {
+				definitions[idx].type     = "image_source";
+				definitions[idx].name     = "input" + std::to_string(idx);
+				definitions[idx].settings = settings;
+				definitions[idx].filters.push_back({"crop_filter", definitions[idx].name + " crop", "{}", true});
+				definitions[idx].placements.push_back({3, true, obs::Transform()});
+			}
+
+			std::vector<obs::InputImportResult> results;
+			obs::read_results(connection.call(obs::serialize_definitions(definitions)), results);
+		}
+		return iterations / std::chrono::duration<double>(clock_type::now() - begin).count();
+	}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+	int iterations = argc > 1 ? std::atoi(argv[1]) : 100;
+	if (iterations <= 0)
+		iterations = 100;
+
+	for (size_t inputs : {10, 100, 500}) {
+		double calls = per_call(inputs, iterations);
+		double batch = bulk(inputs, iterations);
+		std::printf(
+		    "%4zu inputs  per call %9.1f imports/s (%5zu calls)  bulk %9.1f imports/s (1 call)  x%.1f\n",
+		    inputs,
+		    calls,
+		    inputs * 4,
+		    batch,
+		    batch / calls);
+	}
+	return 0;
+}
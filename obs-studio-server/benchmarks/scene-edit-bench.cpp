@@ -0,0 +1,131 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+// Standalone benchmark of the Scene.CommitEdit wire format. Applies a
+// layout (position, scale and rotation) to every item of a scene, either
+// with one SceneItem.SetTransform call per field and item, or with one
+// batch of obs::SceneItemEdit entries. Calls go through a simulated
+// connection whose server side decodes the request and answers with the
+// resulting transforms, like the handlers do. Build it on its own:
+//
+//   cmake -S obs-studio-server/benchmarks -B build-bench -DCMAKE_BUILD_TYPE=Release
+//   cmake --build build-bench && ./build-bench/scene-edit-bench [iterations]
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+#include "bench-round-trip.hpp"
+#include "obs-transform.hpp"
+
+typedef std::chrono::steady_clock clock_type;
+
+namespace
+{
+	std::vector<char> set_transform(std::vector<char> const& request)
+	{
+		obs::Transform transform;
+		transform.read(request);
+		transform.mask = obs::Transform::All;
+		return transform.serialize();
+	}
+
+	std::vector<char> commit_edit(std::vector<char> const& request)
+	{
+		std::vector<obs::SceneItemEdit> edits;
+		obs::read_list(request, edits);
+
+		std::vector<obs::Transform> transforms(edits.size());
+		for (size_t idx = 0; idx < edits.size(); idx++) {
+			transforms[idx]      = edits[idx].transform;
+			transforms[idx].mask = obs::Transform::All;
+		}
+		return obs::serialize_list(transforms);
+	}
+
+	// Layouts per second when every field of every item is its own call.
+	double per_field(size_t items, int iterations)
+	{
+		bench::RoundTrip connection(set_transform);
+		auto             begin = clock_type::now();
+		for (int iteration = 0; iteration < iterations; iteration++) {
+			for (size_t idx = 0; idx < items; idx++) {
+				obs::Transform position;
+				position.mask       = obs::Transform::Position;
+				position.position_x = float(idx);
+				position.position_y = float(idx);
+				connection.call(position.serialize());
+
+				obs::Transform scale;
+				scale.mask    = obs::Transform::Scale;
+				scale.scale_x = scale.scale_y = 0.5f;
+				connection.call(scale.serialize());
+
+				obs::Transform rotation;
+				rotation.mask     = obs::Transform::Rotation;
+				rotation.rotation = 90.0f;
+				connection.call(rotation.serialize());
+			}
+		}
+		return iterations / std::chrono::duration<double>(clock_type::now() - begin).count();
+	}
+
+	// Layouts per second when the whole layout is one Scene.CommitEdit.
+	double batched(size_t items, int iterations)
+	{
+		bench::RoundTrip connection(commit_edit);
+		auto             begin = clock_type::now();
+		for (int iteration = 0; iteration < iterations; iteration++) {
+			std::vector<obs::SceneItemEdit> edits(items);
+			for (size_t idx = 0; idx < items; idx++) {
+				obs::SceneItemEdit& edit  = edits[idx];
+				edit.item_id              = idx;
+				edit.transform.mask       = obs::Transform::Position | obs::Transform::Scale | obs::Transform::Rotation;
+				edit.transform.position_x = float(idx);
+				edit.transform.position_y = float(idx);
+				edit.transform.scale_x    = 0.5f;
+				edit.transform.scale_y    = 0.5f;
+				edit.transform.rotation   = 90.0f;
+			}
+
+			std::vector<obs::Transform> transforms;
+			obs::read_list(connection.call(obs::serialize_list(edits)), transforms);
+		}
+		return iterations / std::chrono::duration<double>(clock_type::now() - begin).count();
+	}
+} // namespace
+
+int main(int argc, char* argv[])
+{
+	int iterations = argc > 1 ? std::atoi(argv[1]) : 200;
+	if (iterations <= 0)
+		iterations = 200;
+
+	for (size_t items : {10, 100, 500}) {
+		double fields = per_field(items, iterations);
+		double batch  = batched(items, iterations);
+		std::printf(
+		    "%4zu items  per field %9.1f layouts/s (%5zu calls)  batched %9.1f layouts/s (1 call)  x%.1f\n",
+		    items,
+		    fields,
+		    items * 3,
+		    batch,
+		    batch / fields);
+	}
+	return 0;
+}
@@ -0,0 +1,188 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+// Standalone benchmark of the window thumbnail scaler on synthetic BGRA
+// frames. Needs neither libobs nor a display, build it on its own:
+//
+//   cmake -S obs-studio-server/benchmarks -B build-bench -DCMAKE_BUILD_TYPE=Release
+//   cmake --build build-bench && ./build-bench/thumbnail-scale-bench [iterations]
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+#include <thread>
+#include <vector>
+#include "osn-thumbnail-scale.hpp"
+
+namespace
+{
+	struct Case
+	{
+		uint32_t src_width;
+		uint32_t src_height;
+		uint32_t max_width;
+		uint32_t max_height;
+	};
+
+	osn::ThumbnailImage make_frame(uint32_t width, uint32_t height)
+	{
+		osn::ThumbnailImage image;
+		image.width  = width;
+		image.height = height;
+		image.stride = width * 4;
+		image.pixels.resize(size_t(image.stride) * height);
+
+		std::mt19937 rng(width * 31 + height);
+		for (uint32_t y = 0; y < height; y++) {
+			uint8_t* row = image.pixels.data() + size_t(y) * image.stride;
+			for (uint32_t x = 0; x < width; x++) {
+				row[x * 4 + 0] = uint8_t(x * 255 / width);
+				row[x * 4 + 1] = uint8_t(y * 255 / height);
+				row[x * 4 + 2] = uint8_t(rng());
+				row[x * 4 + 3] = 255;
+			}
+		}
+		return image;
+	}
+
+	// Plain reference of the box filter the kernel implements.
+	void reference(const osn::ThumbnailImage& src, osn::ThumbnailImage& dst)
+	{
+		for (uint32_t y = 0; y < dst.height; y++) {
+			uint32_t top    = uint32_t(uint64_t(y) * src.height / dst.height);
+			uint32_t bottom = uint32_t(uint64_t(y + 1) * src.height / dst.height);
+			for (uint32_t x = 0; x < dst.width; x++) {
+				uint32_t left  = uint32_t(uint64_t(x) * src.width / dst.width);
+				uint32_t right = uint32_t(uint64_t(x + 1) * src.width / dst.width);
+				uint32_t sum[4] = {0, 0, 0, 0};
+				for (uint32_t sy = top; sy < bottom; sy++) {
+					const uint8_t* px = src.pixels.data() + size_t(sy) * src.stride + size_t(left) * 4;
+					for (uint32_t sx = left; sx < right; sx++, px += 4) {
+						for (size_t ch = 0; ch < 4; ch++)
+							sum[ch] += px[ch];
+					}
+				}
+				uint32_t count = (right - left) * (bottom - top);
+				uint8_t* out   = dst.pixels.data() + size_t(y) * dst.stride + size_t(x) * 4;
+				for (size_t ch = 0; ch < 4; ch++)
+					out[ch] = uint8_t((sum[ch] + count / 2) / count);
+			}
+		}
+	}
+
+	double seconds_since(std::chrono::steady_clock::time_point start)
+	{
+		return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+	}
+} // namespace
+
+int main(int argc, char** argv)
+{
+	int iterations = argc > 1 ? std::max(1, atoi(argv[1])) : 50;
+	unsigned threads = std::max(1u, std::thread::hardware_concurrency());
+
+	const Case cases[] = {
+	    {1280, 720, 320, 180},
+	    {1920, 1080, 320, 180},
+	    {2560, 1440, 480, 270},
+	    {3840, 2160, 320, 180},
+	    {5120, 2880, 640, 360},
+	};
+
+	printf("kernel: %s, threads: %u, iterations: %d\n", osn::ThumbnailScaler::Kernel(), threads, iterations);
+	printf("%-12s %-10s %10s %10s %12s %12s %8s\n", "source", "thumb", "ref ms", "simd ms", "mt ms", "MPix/s", "maxdiff");
+
+	int failed = 0;
+	for (auto& test : cases) {
+		osn::ThumbnailImage src = make_frame(test.src_width, test.src_height);
+
+		uint32_t width, height;
+		osn::ThumbnailScaler::FitSize(src.width, src.height, test.max_width, test.max_height, width, height);
+
+		osn::ThumbnailImage expected;
+		expected.width  = width;
+		expected.height = height;
+		expected.stride = width * 4;
+		expected.pixels.resize(size_t(expected.stride) * height);
+
+		auto start = std::chrono::steady_clock::now();
+		for (int idx = 0; idx < iterations; idx++)
+			reference(src, expected);
+		double reference_s = seconds_since(start) / iterations;
+
+		osn::ThumbnailImage actual;
+		start = std::chrono::steady_clock::now();
+		for (int idx = 0; idx < iterations; idx++)
+			osn::ThumbnailScaler::Downscale(src, actual, width, height);
+		double simd_s = seconds_since(start) / iterations;
+
+		// Same image split into bands, one per thread.
+		osn::ThumbnailImage banded = actual;
+		start                      = std::chrono::steady_clock::now();
+		for (int idx = 0; idx < iterations; idx++) {
+			std::vector<std::thread> workers;
+			uint32_t                 band = (height + threads - 1) / threads;
+			for (uint32_t begin = 0; begin < height; begin += band) {
+				workers.emplace_back([&, begin] {
+					osn::ThumbnailScaler::Downscale(
+					    src.pixels.data(),
+					    src.width,
+					    src.height,
+					    src.stride,
+					    banded.pixels.data(),
+					    width,
+					    height,
+					    banded.stride,
+					    begin,
+					    begin + band);
+				});
+			}
+			for (auto& worker : workers)
+				worker.join();
+		}
+		double banded_s = seconds_since(start) / iterations;
+
+		int max_diff = 0;
+		for (size_t idx = 0; idx < expected.pixels.size(); idx++) {
+			max_diff = std::max(max_diff, std::abs(int(expected.pixels[idx]) - int(actual.pixels[idx])));
+			max_diff = std::max(max_diff, std::abs(int(expected.pixels[idx]) - int(banded.pixels[idx])));
+		}
+		// Vector paths round halves to even, allow one step.
+		if (max_diff > 1)
+			failed++;
+
+		char source_size[32], thumb_size[32];
+		snprintf(source_size, sizeof(source_size), "%ux%u", src.width, src.height);
+		snprintf(thumb_size, sizeof(thumb_size), "%ux%u", width, height);
+		printf(
+		    "%-12s %-10s %10.3f %10.3f %12.3f %12.1f %8d\n",
+		    source_size,
+		    thumb_size,
+		    reference_s * 1000,
+		    simd_s * 1000,
+		    banded_s * 1000,
+		    double(src.width) * src.height / simd_s / 1e6,
+		    max_diff);
+	}
+
+	if (failed)
+		printf("%d case(s) differ from the reference by more than one step\n", failed);
+	return failed ? 1 : 0;
+}
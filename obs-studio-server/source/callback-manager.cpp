@@ -17,26 +17,69 @@
 ******************************************************************************/
 
 #include "callback-manager.h"
+#include "osn-dispatch.hpp"
+#include "osn-event-log.hpp"
 #include "osn-source.hpp"
 #ifdef WIN32
 #include <windows.h>
 #endif
 #include "error.hpp"
 #include "shared.hpp"
+#include "osn-media-state.hpp"
 #include "osn-source.hpp"
+#include "osn-transition-prepare.hpp"
 #include "osn-volmeter.hpp"
 
 std::mutex                             sources_sizes_mtx;
 std::map<std::string, SourceSizeInfo*> sources;
 
+// Changes are found by whichever client polls first and kept in shared
+// logs until every subscribed client read them.
+struct SourceSizeChange
+{
+	std::string name;
+	uint32_t    width;
+	uint32_t    height;
+	uint32_t    flags;
+};
+
+osn::EventLog<SourceSizeChange>         size_changes;
+osn::EventLog<obs::TransitionReadiness> transition_readiness;
+osn::EventLog<obs::MediaClock>          media_clocks;
+
 void CallbackManager::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("CallbackManager");
 	cls->register_function(
 		std::make_shared<ipc::function>("GlobalQuery",
-		std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Binary},
+		std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64, ipc::type::Binary},
 		GlobalQuery));
-	srv.register_collection(cls);
+	cls->register_function(std::make_shared<ipc::function>("Subscribe", std::vector<ipc::type>{}, Subscribe));
+	cls->register_function(
+	    std::make_shared<ipc::function>("Unsubscribe", std::vector<ipc::type>{ipc::type::UInt64}, Unsubscribe));
+	osn::Dispatch::Register(srv, cls);
+}
+
+void CallbackManager::Subscribe(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(osn::EventSubscribers::Subscribe()));
+	AUTO_DEBUG;
+}
+
+void CallbackManager::Unsubscribe(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	osn::EventSubscribers::Unsubscribe(args[0].value_union.ui64);
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
 }
 
 void CallbackManager::GlobalQuery(
@@ -45,11 +88,13 @@ void CallbackManager::GlobalQuery(
     const std::vector<ipc::value>& args,
     std::vector<ipc::value>&       rval)
 {	
+	uint64_t subscriber = args[0].value_union.ui64;
+
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 
 	if (!sources.empty()) {
 		sources_sizes_mtx.lock();
-		uint32_t size = 0;
+		std::vector<SourceSizeChange> changes;
 
 		for (auto item : sources) {
 			SourceSizeInfo* si = item.second;
@@ -63,26 +108,28 @@ void CallbackManager::GlobalQuery(
 				si->height = newHeight;
 				si->flags  = newFlags;
 
-				rval.push_back(ipc::value(obs_source_get_name(si->source)));
-				rval.push_back(ipc::value(si->width));
-				rval.push_back(ipc::value(si->height));
-				rval.push_back(ipc::value(si->flags));
-
-				size++;
+				changes.push_back({obs_source_get_name(si->source), si->width, si->height, si->flags});
 			}
 		}
 
-		rval.insert(rval.begin() + 1, ipc::value(size));
 		sources_sizes_mtx.unlock();
-	} else {
-		rval.insert(rval.begin() + 1, ipc::value((uint32_t)0));
+		size_changes.Push(std::move(changes));
+	}
+
+	std::vector<SourceSizeChange> changes = size_changes.Read(subscriber);
+	rval.push_back(ipc::value((uint32_t)changes.size()));
+	for (auto& change : changes) {
+		rval.push_back(ipc::value(change.name));
+		rval.push_back(ipc::value(change.width));
+		rval.push_back(ipc::value(change.height));
+		rval.push_back(ipc::value(change.flags));
 	}
 	
-	uint64_t size_buffer = args[0].value_union.ui64;
+	uint64_t size_buffer = args[1].value_union.ui64;
 
 	std::vector<char> buffer;
 	buffer.resize(size_buffer);
-	memcpy(buffer.data(), args[1].value_bin.data(), size_buffer);
+	memcpy(buffer.data(), args[2].value_bin.data(), size_buffer);
 
 	uint64_t nb_volmeters = size_buffer / sizeof(uint64_t);
 	uint64_t index = 0;
@@ -93,6 +140,13 @@ void CallbackManager::GlobalQuery(
 		index += sizeof(uint64_t);
 	}
 
+	// Transition readiness and media clocks always come last, the client
+	// reads them from the back.
+	transition_readiness.Push(osn::TransitionPrepare::Collect());
+	media_clocks.Push(osn::MediaState::Collect());
+	rval.push_back(ipc::value(obs::serialize_list(transition_readiness.Read(subscriber))));
+	rval.push_back(ipc::value(obs::serialize_list(media_clocks.Read(subscriber))));
+
 	AUTO_DEBUG;
 }
 
@@ -55,6 +55,16 @@ class CallbackManager
         const int64_t id,
         const std::vector<ipc::value>& args,
         std::vector<ipc::value>& rval);
+	static void Subscribe(
+	    void*                          data,
+	    const int64_t                  id,
+	    const std::vector<ipc::value>& args,
+	    std::vector<ipc::value>&       rval);
+	static void Unsubscribe(
+	    void*                          data,
+	    const int64_t                  id,
+	    const std::vector<ipc::value>& args,
+	    std::vector<ipc::value>&       rval);
 
 	static void addSource(obs_source_t* source);
 	static void removeSource(obs_source_t* source);
@@ -17,6 +17,7 @@
 ******************************************************************************/
 
 #include <chrono>
+#include <condition_variable>
 #include <inttypes.h>
 #include <iostream>
 #include <ipc-class.hpp>
@@ -32,6 +33,7 @@
 #include "nodeobs_content.h"
 #include "nodeobs_service.h"
 #include "nodeobs_settings.h"
+#include "osn-collection.hpp"
 #include "osn-fader.hpp"
 #include "osn-filter.hpp"
 #include "osn-global.hpp"
@@ -40,6 +42,7 @@
 #include "osn-properties.hpp"
 #include "osn-scene.hpp"
 #include "osn-sceneitem.hpp"
+#include "osn-shutdown-timings.hpp"
 #include "osn-source.hpp"
 #include "osn-transition.hpp"
 #include "osn-video.hpp"
@@ -116,17 +119,22 @@ extern "C" __declspec(dllexport) DWORD NvOptimusEnablement = [] {
 
 struct ServerData
 {
-	std::mutex                                     mtx;
-	std::chrono::high_resolution_clock::time_point last_connect, last_disconnect;
-	size_t                                         count_connected = 0;
+	std::mutex                            mtx;
+	std::condition_variable               cv;
+	std::chrono::steady_clock::time_point last_connect, last_disconnect;
+	size_t                                count_connected = 0;
+	bool                                  shutdown        = false;
+	// How long the server stays up without any client before shutting down.
+	std::chrono::milliseconds grace_period = std::chrono::milliseconds(5000);
 };
 
 bool ServerConnectHandler(void* data, int64_t)
 {
 	ServerData*                  sd = reinterpret_cast<ServerData*>(data);
 	std::unique_lock<std::mutex> ulock(sd->mtx);
-	sd->last_connect = std::chrono::high_resolution_clock::now();
+	sd->last_connect = std::chrono::steady_clock::now();
 	sd->count_connected++;
+	sd->cv.notify_all();
 	return true;
 }
 
@@ -134,8 +142,9 @@ void ServerDisconnectHandler(void* data, int64_t)
 {
 	ServerData*                  sd = reinterpret_cast<ServerData*>(data);
 	std::unique_lock<std::mutex> ulock(sd->mtx);
-	sd->last_disconnect = std::chrono::high_resolution_clock::now();
+	sd->last_disconnect = std::chrono::steady_clock::now();
 	sd->count_connected--;
+	sd->cv.notify_all();
 }
 
 namespace System
@@ -143,14 +152,34 @@ namespace System
 	static void
 	    Shutdown(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval)
 	{
-		bool* shutdown = (bool*)data;
-		*shutdown      = true;
+		ServerData* sd = reinterpret_cast<ServerData*>(data);
+		{
+			std::unique_lock<std::mutex> ulock(sd->mtx);
+			sd->shutdown = true;
+			sd->cv.notify_all();
+		}
 #ifdef __APPLE__
 		g_util_osx->stopApplication();
 #endif
 		rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 		return;
 	}
+
+	static void SetShutdownGracePeriod(
+	    void*                          data,
+	    const int64_t                  id,
+	    const std::vector<ipc::value>& args,
+	    std::vector<ipc::value>&       rval)
+	{
+		ServerData* sd = reinterpret_cast<ServerData*>(data);
+		{
+			std::unique_lock<std::mutex> ulock(sd->mtx);
+			sd->grace_period = std::chrono::milliseconds(args[0].value_union.ui32);
+			sd->cv.notify_all();
+		}
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+		return;
+	}
 } // namespace System
 
 int main(int argc, char* argv[])
@@ -205,9 +234,8 @@ int main(int argc, char* argv[])
 
 	// Instance
 	ipc::server myServer;
-	bool        doShutdown = false;
 	ServerData  sd;
-	sd.last_disconnect = sd.last_connect = std::chrono::high_resolution_clock::now();
+	sd.last_disconnect = sd.last_connect = std::chrono::steady_clock::now();
 	sd.count_connected                   = 0;
 	OBS_API::SetCrashHandlerPipe(std::wstring(socketPath.begin(), socketPath.end()));
 
@@ -216,7 +244,9 @@ int main(int argc, char* argv[])
 	{
 		std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("System");
 		cls->register_function(
-		    std::make_shared<ipc::function>("Shutdown", std::vector<ipc::type>{}, System::Shutdown, &doShutdown));
+		    std::make_shared<ipc::function>("Shutdown", std::vector<ipc::type>{}, System::Shutdown, &sd));
+		cls->register_function(std::make_shared<ipc::function>(
+		    "SetShutdownGracePeriod", std::vector<ipc::type>{ipc::type::UInt32}, System::SetShutdownGracePeriod, &sd));
 		myServer.register_collection(cls);
 	};
 
@@ -233,6 +263,7 @@ int main(int argc, char* argv[])
 	osn::Properties::Register(myServer);
 	osn::Video::Register(myServer);
 	osn::Module::Register(myServer);
+	osn::Collection::Register(myServer);
 	CallbackManager::Register(myServer);
 	OBS_API::Register(myServer);
 	OBS_content::Register(myServer);
@@ -259,7 +290,10 @@ int main(int argc, char* argv[])
 	}
 
 	// Reset Connect/Disconnect time.
-	sd.last_disconnect = sd.last_connect = std::chrono::high_resolution_clock::now();
+	{
+		std::unique_lock<std::mutex> ulock(sd.mtx);
+		sd.last_disconnect = sd.last_connect = std::chrono::steady_clock::now();
+	}
 
 #ifdef __APPLE__
 	// WARNING: Blocking function -> this won't return until the application
@@ -267,29 +301,49 @@ int main(int argc, char* argv[])
 	g_util_osx->runApplication();
 #endif
 #ifdef WIN32
+	// Sleep until a client connects or disconnects, the grace period changes
+	// or System.Shutdown is called, shutting down once no client has been
+	// connected for the whole grace period.
 	bool waitBeforeClosing = false;
-	while (!doShutdown) {
-		if (sd.count_connected == 0) {
-			auto tp    = std::chrono::high_resolution_clock::now();
-			auto delta = tp - sd.last_disconnect;
-			if (std::chrono::duration_cast<std::chrono::milliseconds>(delta).count() > 5000) {
-				doShutdown = true;
+	{
+		std::unique_lock<std::mutex> ulock(sd.mtx);
+		while (!sd.shutdown) {
+			if (sd.count_connected > 0) {
+				sd.cv.wait(ulock);
+				continue;
+			}
+
+			auto deadline = sd.last_disconnect + sd.grace_period;
+			if (std::chrono::steady_clock::now() >= deadline) {
+				sd.shutdown       = true;
 				waitBeforeClosing = true;
+				break;
 			}
+			sd.cv.wait_until(ulock, deadline);
 		}
-		std::this_thread::sleep_for(std::chrono::milliseconds(50));
 	}
 	// Wait for crash handler listening thread to finish.
 	// flag waitBeforeClosing: server process expect to receive the exit message from the crash-handler 
 	// before going further with shutdown. It needed for usecase where obs64 process stay alive and 
 	// continue streaming till user confirms exit in crash-handler.
-	OBS_API::WaitCrashHandlerClose(waitBeforeClosing);
+	{
+		osn::ShutdownTimings::Phase phase("crash handler");
+		OBS_API::WaitCrashHandlerClose(waitBeforeClosing);
+	}
 #endif
-	osn::Source::finalize_global_signals();
+	{
+		osn::ShutdownTimings::Phase phase("collections");
+		osn::Collection::Finalize();
+		osn::Source::finalize_global_signals();
+	}
 	OBS_API::destroyOBS_API();
 
 	// Finalize Server
-	myServer.finalize();
+	{
+		osn::ShutdownTimings::Phase phase("ipc server");
+		myServer.finalize();
+	}
+	osn::ShutdownTimings::Report();
 #ifdef __APPLE__
 	if (override_std_fd) {
 		close(out_pid);
@@ -17,9 +17,14 @@
 ******************************************************************************/
 
 #include "nodeobs_api.h"
+#include "osn-dispatch.hpp"
+#include "osn-frame-stats.hpp"
+#include "osn-render-timing.hpp"
 #include "osn-source.hpp"
+#include "osn-source-types.hpp"
 #include "osn-scene.hpp"
 #include "osn-sceneitem.hpp"
+#include "osn-shutdown-timings.hpp"
 #include "osn-input.hpp"
 #include "osn-transition.hpp"
 #include "osn-filter.hpp"
@@ -80,6 +85,7 @@
 #include "shared.hpp"
 
 #include <fstream>
+#include <future>
 
 #define BUFFSIZE 512
 #define CONNECTING_STATE 0
@@ -136,7 +142,7 @@ void OBS_API::Register(ipc::server& srv)
 	cls->register_function(std::make_shared<ipc::function>(
 	    "SetUsername", std::vector<ipc::type>{ipc::type::String}, SetUsername));
 
-	srv.register_collection(cls);
+	osn::Dispatch::Register(srv, cls);
 	g_server = &srv;
 }
 
@@ -757,6 +763,10 @@ void OBS_API::OBS_API_initAPI(
 #endif
 	}
 
+	// Before the video reset below, so the graphics thread times its frames
+	// from the first one.
+	osn::RenderTiming::Start();
+
 	/* Logging */
 	std::string filename = GenerateTimeDateFilename("txt");
 	std::string log_path = appdata;
@@ -858,6 +868,8 @@ void OBS_API::OBS_API_initAPI(
 
 	util::CrashManager::setAppState("idle");
 
+	osn::FrameStats::Start();
+
 	// We are returning a video result here because the frontend needs to know if we sucessfully
 	// initialized the Dx11 API
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
@@ -1398,6 +1410,16 @@ void OBS_API::destroyOBS_API(void)
 {
 	blog(LOG_DEBUG, "OBS_API::destroyOBS_API started, objects allocated %d", bnum_allocs());
 
+	osn::FrameStats::Stop();
+	osn::RenderTiming::Stop();
+
+	// Pending auto config tests also flush their config saves, let them
+	// finish while the displays are torn down.
+	auto pendingTests = std::async(std::launch::async, [] {
+		osn::ShutdownTimings::Phase phase("auto config");
+		autoConfig::WaitPendingTests();
+	});
+
 	os_cpu_usage_info_destroy(cpuUsageInfo);
 
 #ifdef _WIN32
@@ -1408,60 +1430,74 @@ void OBS_API::destroyOBS_API(void)
 			DisableAudioDucking(false);
 	}
 #endif
-	OBS_content::OBS_content_shutdownDisplays();
-
-	autoConfig::WaitPendingTests();
-
-	OBS_service::stopAllOutputs();
-
-	obs_encoder_t* streamingEncoder = OBS_service::getStreamingEncoder();
-	if (streamingEncoder != NULL)
-		obs_encoder_release(streamingEncoder);
-
-	obs_encoder_t* recordingEncoder = OBS_service::getRecordingEncoder();
-	if (recordingEncoder != NULL && (OBS_service::useRecordingPreset() || obs_get_multiple_rendering()))
-		obs_encoder_release(recordingEncoder);
-
-	obs_encoder_t* audioStreamingEncoder = OBS_service::getAudioSimpleStreamingEncoder();
-	if (audioStreamingEncoder != NULL)
-		obs_encoder_release(audioStreamingEncoder);
-
-	obs_encoder_t* audioRecordingEncoder = OBS_service::getAudioSimpleRecordingEncoder();
-	if (audioRecordingEncoder != NULL && (OBS_service::useRecordingPreset() || obs_get_multiple_rendering()))
-		obs_encoder_release(audioRecordingEncoder);
-
-	obs_encoder_t* archiveEncoder = OBS_service::getArchiveEncoder();
-	if (archiveEncoder != NULL)
-		obs_encoder_release(archiveEncoder);
+	{
+		osn::ShutdownTimings::Phase phase("displays");
+		OBS_content::OBS_content_shutdownDisplays();
+	}
 
-	obs_output_t* streamingOutput = OBS_service::getStreamingOutput();
-	if (streamingOutput != NULL)
-		obs_output_release(streamingOutput);
+	pendingTests.wait();
 
-	obs_output_t* recordingOutput = OBS_service::getRecordingOutput();
-	if (recordingOutput != NULL)
-		obs_output_release(recordingOutput);
+	{
+		osn::ShutdownTimings::Phase phase("outputs");
+
+		OBS_service::stopAllOutputs();
+
+		obs_encoder_t* streamingEncoder = OBS_service::getStreamingEncoder();
+		if (streamingEncoder != NULL)
+			obs_encoder_release(streamingEncoder);
+
+		obs_encoder_t* recordingEncoder = OBS_service::getRecordingEncoder();
+		if (recordingEncoder != NULL && (OBS_service::useRecordingPreset() || obs_get_multiple_rendering()))
+			obs_encoder_release(recordingEncoder);
+
+		obs_encoder_t* audioStreamingEncoder = OBS_service::getAudioSimpleStreamingEncoder();
+		if (audioStreamingEncoder != NULL)
+			obs_encoder_release(audioStreamingEncoder);
+
+		obs_encoder_t* audioRecordingEncoder = OBS_service::getAudioSimpleRecordingEncoder();
+		if (audioRecordingEncoder != NULL && (OBS_service::useRecordingPreset() || obs_get_multiple_rendering()))
+			obs_encoder_release(audioRecordingEncoder);
+
+		obs_encoder_t* archiveEncoder = OBS_service::getArchiveEncoder();
+		if (archiveEncoder != NULL)
+			obs_encoder_release(archiveEncoder);
+
+		// Outputs are independent of each other and destroying one joins its
+		// threads, so release them side by side.
+		std::vector<std::future<void>> outputReleases;
+		auto releaseOutput = [&outputReleases](obs_output_t* output) {
+			if (output != NULL)
+				outputReleases.push_back(std::async(std::launch::async, obs_output_release, output));
+		};
+		releaseOutput(OBS_service::getStreamingOutput());
+		releaseOutput(OBS_service::getRecordingOutput());
+		releaseOutput(OBS_service::getReplayBufferOutput());
+
+		obs_output* virtualWebcamOutput = OBS_service::getVirtualWebcamOutput();
+		if (virtualWebcamOutput != NULL) {
+			outputReleases.push_back(std::async(std::launch::async, [virtualWebcamOutput] {
+				if (obs_output_active(virtualWebcamOutput))
+					obs_output_stop(virtualWebcamOutput);
+
+				obs_output_release(virtualWebcamOutput);
+			}));
+		}
 
-	obs_output_t* replayBufferOutput = OBS_service::getReplayBufferOutput();
-	if (replayBufferOutput != NULL)
-		obs_output_release(replayBufferOutput);
+		for (auto& release : outputReleases)
+			release.wait();
 
-	obs_output* virtualWebcamOutput = OBS_service::getVirtualWebcamOutput();
-	if (virtualWebcamOutput != NULL) {
-		if (obs_output_active(virtualWebcamOutput))
-			obs_output_stop(virtualWebcamOutput);
+		obs_service_t* service = OBS_service::getService();
+		if (service != NULL)
+			obs_service_release(service);
 
-		obs_output_release(virtualWebcamOutput);
+		OBS_service::waitReleaseWorker();
+		OBS_service::clearAudioEncoder();
+		osn::Volmeter::ClearVolmeters();
+		osn::Fader::ClearFaders();
 	}
 
-	obs_service_t* service = OBS_service::getService();
-	if (service != NULL)
-		obs_service_release(service);
-
-    OBS_service::waitReleaseWorker();
-    OBS_service::clearAudioEncoder();
-    osn::Volmeter::ClearVolmeters();
-    osn::Fader::ClearFaders();
+	// Runs until the end of the sequence, obs_shutdown included.
+	osn::ShutdownTimings::Phase libobsPhase("libobs");
 
 	// Check if the frontend was able to shutdown correctly:
 	// If there are some sources here it's because it ended unexpectedly, this represents a 
@@ -1707,6 +1743,7 @@ bool OBS_API::openAllModules(int& video_err)
 		os_closedir(plugin_dir);
 	}
 
+	osn::SourceTypes::Invalidate();
 	return true;
 }
 
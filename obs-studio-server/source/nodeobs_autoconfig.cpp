@@ -20,6 +20,7 @@
 #include <array>
 #include <future>
 #include "error.hpp"
+#include "osn-dispatch.hpp"
 #include "shared.hpp"
 
 enum class Type
@@ -246,28 +247,20 @@ void autoConfig::Register(ipc::server& srv)
 	    "TerminateAutoConfig", std::vector<ipc::type>{}, autoConfig::TerminateAutoConfig));
 	cls->register_function(std::make_shared<ipc::function>("Query", std::vector<ipc::type>{}, autoConfig::Query));
 
-	srv.register_collection(cls);
+	osn::Dispatch::Register(srv, cls);
 }
 
 void autoConfig::WaitPendingTests(double timeout)
 {
-	clock_t start_time = clock();
-	while ((float(clock() - start_time) / CLOCKS_PER_SEC) < timeout) {
-
-		bool all_finished = true;
-		for (auto& async_test : asyncTests) {
-			if (async_test.valid()) {
-				auto status = async_test.wait_for(std::chrono::milliseconds(0));
-				if (status != std::future_status::ready) {
-					all_finished = false;
-				}			
-			}
-		}
-
-		if (all_finished)
+	// Wall clock deadline, clock() only counts cpu time and barely advances
+	// while the tests are blocked on the network or encoders.
+	auto deadline = std::chrono::steady_clock::now()
+	                + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+	                    std::chrono::duration<double>(timeout));
+
+	for (auto& async_test : asyncTests) {
+		if (async_test.valid() && async_test.wait_until(deadline) != std::future_status::ready)
 			break;
-
-		std::this_thread::sleep_for(std::chrono::milliseconds(50));
 	}
 }
 
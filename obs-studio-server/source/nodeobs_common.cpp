@@ -25,6 +25,9 @@
 #include <graphics/matrix4.h>
 
 #include "error.hpp"
+#include "obs-window.hpp"
+#include "osn-dispatch.hpp"
+#include "osn-window-thumbs.hpp"
 #include "shared.hpp"
 
 #include <thread>
@@ -228,10 +231,11 @@ void OBS_content::Register(ipc::server& srv)
 
 	cls->register_function(std::make_shared<ipc::function>(
 	    "LONGISLAND_content_getWindowThumbs",
-	    std::vector<ipc::type>{ipc::type::String},
+	    std::vector<ipc::type>{
+	        ipc::type::String, ipc::type::Binary, ipc::type::UInt32, ipc::type::UInt32, ipc::type::UInt32},
 	    LONGISLAND_content_getWindowThumbs));
 
-	srv.register_collection(cls);
+	osn::Dispatch::Register(srv, cls);
 	g_srv = &srv;
 }
 
@@ -688,25 +692,37 @@ void OBS_content::LONGISLAND_content_getWindowThumbs(
     const std::vector<ipc::value>& args,
     std::vector<ipc::value>&       rval)
 {
+	std::vector<obs::WindowThumbKnown> known_list;
+	if (!obs::read_list(args[1].value_bin, known_list)) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Known thumbnail list is malformed.");
+	}
+	std::map<int64_t, uint64_t> known;
+	for (auto& entry : known_list)
+		known[entry.window_id] = entry.hash;
+
+	osn::WindowThumbs::Options options;
+	options.max_width  = args[2].value_union.ui32;
+	options.max_height = args[3].value_union.ui32;
+	options.format     = obs::ThumbFormat(args[4].value_union.ui32);
+	if (options.format > obs::ThumbFormat::JPEG) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Thumbnail format is not valid.");
+	}
 
-	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-	std::string windowIds = args[0].value_str;
-	if (rval.size() <= 1)
-		rval.push_back(ipc::value((uint64_t) 0));
-	struct longisland_window_thumb * thumbs = enumerate_windows_images_json(windowIds.c_str());
-	struct longisland_window_thumb * head = thumbs;
-	int index;
-	while (thumbs) {
-		if (thumbs->image_base64) {
-			rval.push_back(ipc::value(std::to_string(thumbs->window_id)));
-			rval.push_back(ipc::value(std::to_string(thumbs->width)));
-			rval.push_back(ipc::value(std::to_string(thumbs->height)));
-			rval.push_back(ipc::value(thumbs->image_base64));
-			rval[1].value_union.ui64++;
-		}
-		thumbs = thumbs->next;
-		index ++;
+	std::vector<osn::WindowThumbs::Result> results = osn::WindowThumbs::Capture(args[0].value_str, known, options);
+
+	std::vector<obs::WindowThumb> headers;
+	std::vector<ipc::value>       images;
+	headers.reserve(results.size());
+	for (auto& result : results) {
+		headers.push_back(result.header);
+		if (result.header.changed)
+			images.push_back(ipc::value(std::move(result.bytes)));
 	}
-	longisland_window_thumb_free(head);
-//	rval.push_back(ipc::value((uint32_t)surfaceID));
+
+	rval.reserve(images.size() + 2);
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(obs::serialize_list(headers)));
+	for (auto& image : images)
+		rval.push_back(std::move(image));
+	AUTO_DEBUG;
 }
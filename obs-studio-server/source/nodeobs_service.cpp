@@ -23,6 +23,8 @@
 #include <filesystem>
 #endif
 #include "error.hpp"
+#include "osn-dispatch.hpp"
+#include "osn-event-log.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
 
@@ -35,6 +37,11 @@ obs_output_t* streamingOutput    = nullptr;
 obs_output_t* recordingOutput    = nullptr;
 obs_output_t* replayBufferOutput = nullptr;
 
+// Follows streamingOutput for threads other than the IPC thread, which
+// releases and replaces the output at any time.
+std::mutex         streamingOutputWeakMtx;
+obs_weak_output_t* streamingOutputWeak = nullptr;
+
 obs_output_t* virtualWebcamOutput = nullptr;
 
 obs_encoder_t* audioSimpleStreamingEncoder   = nullptr;
@@ -63,8 +70,8 @@ bool        isReplayBufferActive = false;
 bool        rpUsesRec            = false;
 bool        rpUsesStream         = false;
 
-std::mutex             signalMutex;
-std::queue<SignalInfo> outputSignal;
+// Read by every subscribed client, see osn::EventLog.
+osn::EventLog<SignalInfo> outputSignal;
 std::thread            releaseWorker;
 
 static constexpr int kSoundtrackArchiveEncoderIdx = 1;
@@ -97,7 +104,7 @@ void OBS_service::Register(ipc::server& srv)
 	    "OBS_service_stopReplayBuffer", std::vector<ipc::type>{ipc::type::Int32}, OBS_service_stopReplayBuffer));
 	cls->register_function(std::make_shared<ipc::function>(
 	    "OBS_service_connectOutputSignals", std::vector<ipc::type>{}, OBS_service_connectOutputSignals));
-	cls->register_function(std::make_shared<ipc::function>("Query", std::vector<ipc::type>{}, Query));
+	cls->register_function(std::make_shared<ipc::function>("Query", std::vector<ipc::type>{ipc::type::UInt64}, Query));
 	cls->register_function(std::make_shared<ipc::function>(
 	    "OBS_service_processReplayBufferHotkey", std::vector<ipc::type>{}, OBS_service_processReplayBufferHotkey));
 	cls->register_function(std::make_shared<ipc::function>(
@@ -112,7 +119,7 @@ void OBS_service::Register(ipc::server& srv)
 	cls->register_function(std::make_shared<ipc::function>(
 	    "OBS_service_stopVirtualWebcan", std::vector<ipc::type>{}, OBS_service_stopVirtualWebcan));
 
-	srv.register_collection(cls);
+	osn::Dispatch::Register(srv, cls);
 }
 
 void OBS_service::OBS_service_resetAudioContext(
@@ -844,6 +851,15 @@ bool OBS_service::createService()
 	return true;
 }
 
+static void updateStreamingOutputWeak(void)
+{
+	obs_weak_output_t* weak = streamingOutput ? obs_output_get_weak_output(streamingOutput) : nullptr;
+
+	std::unique_lock<std::mutex> lock(streamingOutputWeakMtx);
+	obs_weak_output_release(streamingOutputWeak);
+	streamingOutputWeak = weak;
+}
+
 bool OBS_service::createStreamingOutput(void)
 {
 	const char* type = obs_service_get_output_type(service);
@@ -851,6 +867,7 @@ bool OBS_service::createStreamingOutput(void)
 		type = "rtmp_output";
 
 	streamingOutput = obs_output_create(type, "simple_stream", nullptr, nullptr);
+	updateStreamingOutputWeak();
 	if (streamingOutput == nullptr) {
 		return false;
 	}
@@ -917,6 +934,7 @@ bool OBS_service::startStreaming(void)
 		obs_output_release(streamingOutput);
 
 	streamingOutput = obs_output_create(type, "simple_stream", nullptr, nullptr);
+	updateStreamingOutputWeak();
 	if (!streamingOutput)
 		return false;
 
@@ -958,8 +976,7 @@ bool OBS_service::startStreaming(void)
 			signal.setCode(OBS_OUTPUT_ERROR);
 		}
 
-		std::unique_lock<std::mutex> ulock(signalMutex);
-		outputSignal.push(signal);
+		outputSignal.Push(signal);
 	}
 	return isStreaming;
 }
@@ -1202,8 +1219,7 @@ bool OBS_service::startRecording(void)
 			}
 			signal.setCode(OBS_OUTPUT_ERROR);
 		}
-		std::unique_lock<std::mutex> ulock(signalMutex);
-		outputSignal.push(signal);
+		outputSignal.Push(signal);
 	}
 	return isRecording;
 }
@@ -1378,8 +1394,7 @@ bool OBS_service::startReplayBuffer(void)
 			}
 			signal.setCode(OBS_OUTPUT_ERROR);
 		}
-		std::unique_lock<std::mutex> ulock(signalMutex);
-		outputSignal.push(signal);
+		outputSignal.Push(signal);
 	} else {
 		isReplayBufferActive = true;
 	}
@@ -2071,10 +2086,17 @@ obs_output_t* OBS_service::getStreamingOutput(void)
 	return streamingOutput;
 }
 
+obs_output_t* OBS_service::getStreamingOutputRef(void)
+{
+	std::unique_lock<std::mutex> lock(streamingOutputWeakMtx);
+	return obs_weak_output_get_output(streamingOutputWeak);
+}
+
 void OBS_service::setStreamingOutput(obs_output_t* output)
 {
 	obs_output_release(streamingOutput);
 	streamingOutput = output;
+	updateStreamingOutputWeak();
 }
 
 obs_output_t* OBS_service::getRecordingOutput(void)
@@ -2202,8 +2224,8 @@ void OBS_service::Query(
     const std::vector<ipc::value>& args,
     std::vector<ipc::value>&       rval)
 {
-	std::unique_lock<std::mutex> ulock(signalMutex);
-	if (outputSignal.empty()) {
+	std::vector<SignalInfo> signals = outputSignal.Read(args[0].value_union.ui64, 1);
+	if (signals.empty()) {
 		rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 		AUTO_DEBUG;
 		return;
@@ -2211,12 +2233,10 @@ void OBS_service::Query(
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 
-	rval.push_back(ipc::value(outputSignal.front().getOutputType()));
-	rval.push_back(ipc::value(outputSignal.front().getSignal()));
-	rval.push_back(ipc::value(outputSignal.front().getCode()));
-	rval.push_back(ipc::value(outputSignal.front().getErrorMessage()));
-
-	outputSignal.pop();
+	rval.push_back(ipc::value(signals.front().getOutputType()));
+	rval.push_back(ipc::value(signals.front().getSignal()));
+	rval.push_back(ipc::value(signals.front().getCode()));
+	rval.push_back(ipc::value(signals.front().getErrorMessage()));
 
 	AUTO_DEBUG;
 }
@@ -2251,8 +2271,7 @@ void OBS_service::JSCallbackOutputSignal(void* data, calldata_t* params)
 		}
 	}
 
-	std::unique_lock<std::mutex> ulock(signalMutex);
-	outputSignal.push(signal);
+	outputSignal.Push(signal);
 }
 
 void OBS_service::connectOutputSignals(void)
@@ -2390,6 +2409,7 @@ void OBS_service::releaseStreamingOutput()
 
 	obs_output_release(streamingOutput);
 	streamingOutput = nullptr;
+	updateStreamingOutputWeak();
 }
 
 void OBS_service::waitReleaseWorker()
@@ -251,6 +251,8 @@ class OBS_service
 	static bool          createRecordingOutput(void);
 	static void          createReplayBufferOutput(void);
 	static obs_output_t* getStreamingOutput(void);
+	// New reference to the streaming output, safe to call from any thread.
+	static obs_output_t* getStreamingOutputRef(void);
 	static void          setStreamingOutput(obs_output_t* output);
 	static obs_output_t* getRecordingOutput(void);
 	static void          setRecordingOutput(obs_output_t* output);
@@ -19,11 +19,10 @@
 #include "nodeobs_settings.h"
 #include "error.hpp"
 #include "nodeobs_api.h"
+#include "osn-dispatch.hpp"
 #include "shared.hpp"
 #include "memory-manager.h"
-extern "C" {
-#include "window-utils.h"
-}
+#include "osn-window-list.hpp"
 
 #ifdef WIN32
 #include <windows.h>
@@ -70,9 +69,11 @@ void OBS_settings::Register(ipc::server& srv)
 	cls->register_function(std::make_shared<ipc::function>(
 	    "OBS_settings_getVideoDevices", std::vector<ipc::type>{}, OBS_settings_getVideoDevices));
 	cls->register_function(std::make_shared<ipc::function>(
-	    "LONGISLAND_settings_getWindowLists", std::vector<ipc::type>{}, LONGISLAND_settings_getWindowLists));
+	    "LONGISLAND_settings_getWindowLists",
+	    std::vector<ipc::type>{ipc::type::UInt64},
+	    LONGISLAND_settings_getWindowLists));
 
-	srv.register_collection(cls);
+	osn::Dispatch::Register(srv, cls);
 }
 
 void OBS_settings::OBS_settings_getSettings(
@@ -4282,25 +4283,12 @@ void OBS_settings::LONGISLAND_settings_getWindowLists(
     const std::vector<ipc::value>& args,
     std::vector<ipc::value>&       rval)
 {
-	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	osn::WindowList::Answer answer = osn::WindowList::Query(args[0].value_union.ui64);
 
-	struct longisland_cocoa_window *windows = enumerate_windows_json();
-
-	struct longisland_cocoa_window * head = windows;
-	if (rval.size() <= 1)
-		rval.push_back(ipc::value((uint64_t) 0));
-	int index = 0;
-	while (windows) {
-		rval.push_back(ipc::value(windows->window_name));
-		rval.push_back(ipc::value(std::to_string(windows->window_id)));
-		rval.push_back(ipc::value(std::to_string(windows->window_frame.x)));
-		rval.push_back(ipc::value(std::to_string(windows->window_frame.y)));
-		rval.push_back(ipc::value(std::to_string(windows->window_frame.width)));
-		rval.push_back(ipc::value(std::to_string(windows->window_frame.height)));
-		rval.push_back(ipc::value(windows->owner_name));
-		windows = windows->next;
-		rval[1].value_union.ui64++;
-		index ++;
-	}
-	longisland_cocoa_window_free(head);
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(answer.revision));
+	rval.push_back(ipc::value((uint32_t)answer.full));
+	rval.push_back(ipc::value(obs::serialize_list(answer.entries)));
+	rval.push_back(ipc::value(answer.strings));
+	AUTO_DEBUG;
 }
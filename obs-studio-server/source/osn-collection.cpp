@@ -0,0 +1,511 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-collection.hpp"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <thread>
+#include <obs-buffer.hpp>
+#include <util/platform.h>
+#include "error.hpp"
+#include "nlohmann/json.hpp"
+#include "osn-dispatch.hpp"
+#include "osn-snapshot.hpp"
+#include "osn-source.hpp"
+#include "shared.hpp"
+
+// Input and filter types known to only read their settings and files when
+// created, without devices, COM or other global state. Sources of these
+// types, with only such filters, are created by the load pool. Everything
+// else, including third party plugins, is created on the IPC thread.
+static const std::set<std::string> parallel_input_types = {
+    "image_source",
+    "color_source",
+    "color_source_v2",
+    "color_source_v3",
+};
+
+static const std::set<std::string> parallel_filter_types = {
+    "crop_filter",
+    "scale_filter",
+    "color_filter",
+    "color_key_filter",
+    "chroma_key_filter",
+    "sharpness_filter",
+    "gain_filter",
+    "noise_gate_filter",
+    "compressor_filter",
+};
+
+namespace
+{
+	struct LoadEntry
+	{
+		obs_data_t*   data   = nullptr;
+		obs_source_t* source = nullptr;
+	};
+
+	bool CanLoadInParallel(obs_data_t* data)
+	{
+		if (!parallel_input_types.count(obs_data_get_string(data, "id")))
+			return false;
+
+		obs_data_array_t* filters  = obs_data_get_array(data, "filters");
+		bool              parallel = true;
+		for (size_t idx = 0; filters && parallel && idx < obs_data_array_count(filters); idx++) {
+			obs_data_t* filter = obs_data_array_item(filters, idx);
+			parallel           = parallel_filter_types.count(obs_data_get_string(filter, "id")) != 0;
+			obs_data_release(filter);
+		}
+		obs_data_array_release(filters);
+		return parallel;
+	}
+
+	// Sources of one Collection.Load or Collection.RestoreSnapshot, decoded
+	// and created by a pool of workers while the reader is still going.
+	// Each job returns the obs_data of its source.
+	class LoadPool
+	{
+		std::deque<std::pair<LoadEntry*, std::function<obs_data_t*()>>> queue;
+		std::mutex                                                      mtx;
+		std::condition_variable                                         cv;
+		bool                                                            done = false;
+		std::vector<std::thread>                                        workers;
+
+		void work()
+		{
+			std::unique_lock<std::mutex> lock(mtx);
+			while (true) {
+				cv.wait(lock, [this] { return done || !queue.empty(); });
+				if (queue.empty())
+					return;
+
+				auto job = std::move(queue.front());
+				queue.pop_front();
+				lock.unlock();
+
+				LoadEntry* entry = job.first;
+				entry->data      = job.second();
+				if (entry->data && CanLoadInParallel(entry->data))
+					entry->source = obs_load_source(entry->data);
+
+				lock.lock();
+			}
+		}
+
+		public:
+		LoadPool()
+		{
+			size_t threads = std::max(std::thread::hardware_concurrency(), 2u) - 1;
+			for (size_t idx = 0; idx < threads; idx++)
+				workers.emplace_back(&LoadPool::work, this);
+		}
+
+		~LoadPool()
+		{
+			finish();
+		}
+
+		void push(LoadEntry* entry, std::function<obs_data_t*()>&& job)
+		{
+			std::unique_lock<std::mutex> lock(mtx);
+			queue.emplace_back(entry, std::move(job));
+			cv.notify_one();
+		}
+
+		void finish()
+		{
+			{
+				std::unique_lock<std::mutex> lock(mtx);
+				done = true;
+				cv.notify_all();
+			}
+			for (auto& worker : workers) {
+				if (worker.joinable())
+					worker.join();
+			}
+		}
+	};
+
+	// Writes `contents` into a temporary file, which then replaces `path`
+	// so a crash never leaves a truncated file.
+	bool WriteFile(std::string const& path, std::vector<char> const& contents, std::string& error)
+	{
+		std::string tmp_path = path + ".tmp";
+		FILE*       file     = os_fopen(tmp_path.c_str(), "wb");
+		if (!file) {
+			error = "Failed to open " + tmp_path + " for writing.";
+			return false;
+		}
+
+		bool ok = fwrite(contents.data(), 1, contents.size(), file) == contents.size();
+		ok      = (fclose(file) == 0) && ok;
+		if (!ok) {
+			os_unlink(tmp_path.c_str());
+			error = "Failed to write " + tmp_path + ".";
+			return false;
+		}
+
+		std::string backup_path = path + ".bak";
+		if (os_safe_replace(path.c_str(), tmp_path.c_str(), backup_path.c_str()) != 0) {
+			error = "Failed to replace " + path + ".";
+			return false;
+		}
+		return true;
+	}
+
+	// Writes collections and snapshots in the background. Their contents are
+	// produced by the IPC handlers, as obs_data is not thread safe, the writer
+	// thread only does the file I/O. Only the most recent contents of a path
+	// are kept, a newer request replaces a queued one.
+	class SaveWriter
+	{
+		std::thread                              worker;
+		std::mutex                               mtx;
+		std::condition_variable                  cv;
+		std::map<std::string, std::vector<char>> pending;
+		bool                                     busy    = false;
+		bool                                     running = false;
+		std::string                              error;
+
+		void work()
+		{
+			std::unique_lock<std::mutex> lock(mtx);
+			while (true) {
+				cv.wait(lock, [this] { return !running || !pending.empty(); });
+				if (pending.empty())
+					return;
+
+				auto job = pending.extract(pending.begin());
+				busy     = true;
+				lock.unlock();
+				std::string job_error;
+				WriteFile(job.key(), job.mapped(), job_error);
+				lock.lock();
+
+				busy = false;
+				if (!job_error.empty())
+					error = job_error;
+				cv.notify_all();
+			}
+		}
+
+		public:
+		static SaveWriter& GetInstance()
+		{
+			static SaveWriter instance;
+			return instance;
+		}
+
+		void queue(std::string const& path, std::vector<char>&& contents)
+		{
+			std::unique_lock<std::mutex> lock(mtx);
+			if (!running) {
+				running = true;
+				worker  = std::thread(&SaveWriter::work, this);
+			}
+			pending[path] = std::move(contents);
+			cv.notify_all();
+		}
+
+		// Blocks until nothing is queued or being written, and returns the
+		// error of the last failed write since the previous wait, if any.
+		std::string wait()
+		{
+			std::unique_lock<std::mutex> lock(mtx);
+			cv.wait(lock, [this] { return pending.empty() && !busy; });
+			std::string last_error;
+			std::swap(last_error, error);
+			return last_error;
+		}
+
+		// Writes what is still queued, then stops the thread.
+		void stop()
+		{
+			{
+				std::unique_lock<std::mutex> lock(mtx);
+				if (!running)
+					return;
+				running = false;
+				cv.notify_all();
+			}
+			worker.join();
+		}
+	};
+
+	// Periodic snapshots, only used by Write handlers and Finalize, which
+	// hold the exclusive dispatch lock.
+	struct SnapshotSchedule
+	{
+		std::string                           path;
+		std::chrono::milliseconds             interval{0};
+		std::chrono::steady_clock::time_point next;
+	} snapshot_schedule;
+
+	// Runs after every Write handler. Sources only change through those, so
+	// a snapshot is taken by the first one once the interval has passed and
+	// an idle server writes none.
+	void TakeDueSnapshot()
+	{
+		if (snapshot_schedule.path.empty())
+			return;
+
+		auto now = std::chrono::steady_clock::now();
+		if (now < snapshot_schedule.next)
+			return;
+
+		snapshot_schedule.next = now + snapshot_schedule.interval;
+		SaveWriter::GetInstance().queue(snapshot_schedule.path, osn::Snapshot::Capture());
+	}
+
+	// Releases everything a failed load has created so far.
+	void DiscardLoad(std::vector<std::unique_ptr<LoadEntry>>& entries)
+	{
+		for (auto& entry : entries) {
+			if (entry->source) {
+				obs_source_remove(entry->source);
+				obs_source_release(entry->source);
+			}
+			obs_data_release(entry->data);
+		}
+		entries.clear();
+	}
+
+	// Creates the sources the pool left to the IPC thread, then lets every
+	// source load and describes the result for the client.
+	std::vector<char> FinishLoad(std::vector<std::unique_ptr<LoadEntry>>& entries)
+	{
+		// Scenes, transitions and all other input types are created in file order.
+		for (auto& entry : entries) {
+			if (entry->data && !entry->source)
+				entry->source = obs_load_source(entry->data);
+		}
+
+		// Now that every source exists, let them load. This is where scenes
+		// resolve their items, which reference other sources by name.
+		obs::BufferWriter out;
+		out.write<uint32_t>(0);
+		uint32_t count = 0;
+		for (auto& entry : entries) {
+			obs_source_t* source = entry->source;
+			if (source) {
+				if (obs_source_get_type(source) == OBS_SOURCE_TYPE_TRANSITION)
+					obs_transition_load(source, entry->data);
+				obs_source_load(source);
+
+				uint64_t uid = osn::Source::Manager::GetInstance().find(source);
+				if (uid != UINT64_MAX) {
+					out.write(uid);
+					out.write<uint32_t>(obs_source_get_type(source));
+					out.write(std::string(obs_source_get_id(source)));
+					out.write(std::string(obs_source_get_name(source)));
+					count++;
+				}
+			}
+			obs_data_release(entry->data);
+		}
+		std::memcpy(out.data().data(), &count, sizeof(count));
+		return std::move(out.data());
+	}
+} // namespace
+
+void osn::Collection::Register(ipc::server& srv)
+{
+	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Collection");
+	cls->register_function(std::make_shared<ipc::function>("Load", std::vector<ipc::type>{ipc::type::String}, Load));
+	cls->register_function(std::make_shared<ipc::function>("Save", std::vector<ipc::type>{ipc::type::String}, Save));
+	cls->register_function(std::make_shared<ipc::function>("Flush", std::vector<ipc::type>{}, Flush));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "SetSnapshot", std::vector<ipc::type>{ipc::type::String, ipc::type::UInt32}, SetSnapshot));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "RestoreSnapshot", std::vector<ipc::type>{ipc::type::String}, RestoreSnapshot));
+	osn::Dispatch::Register(srv, cls);
+	osn::Dispatch::SetWriteEpilogue(TakeDueSnapshot);
+}
+
+void osn::Collection::Finalize()
+{
+	SaveWriter::GetInstance().stop();
+
+	// Leave an up to date snapshot behind on a clean shutdown.
+	osn::Dispatch::Scope scope(osn::Dispatch::Access::Write);
+	std::string          error;
+	if (!snapshot_schedule.path.empty()
+	    && !WriteFile(snapshot_schedule.path, osn::Snapshot::Capture(), error))
+		blog(LOG_ERROR, "Failed to write the final snapshot: %s", error.c_str());
+}
+
+void osn::Collection::Load(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	FILE* file = os_fopen(args[0].value_str.c_str(), "rb");
+	if (!file) {
+		PRETTY_ERROR_RETURN(ErrorCode::NotFound, "Collection file could not be opened.");
+	}
+
+	// Every element of the top level "sources" array is handed to the pool
+	// as soon as it is parsed and then dropped from the document, so memory
+	// use does not grow with the size of the collection.
+	std::vector<std::unique_ptr<LoadEntry>> entries;
+	bool                                    malformed = false;
+	{
+		LoadPool pool;
+		bool     in_sources = false;
+		auto     callback   = [&](int depth, nlohmann::json::parse_event_t event, nlohmann::json& parsed) {
+			if (event == nlohmann::json::parse_event_t::key && depth == 1) {
+				in_sources = (parsed == "sources");
+			} else if (event == nlohmann::json::parse_event_t::object_end && depth == 2 && in_sources) {
+				auto json = std::make_shared<nlohmann::json>(std::move(parsed));
+				entries.emplace_back(new LoadEntry);
+				pool.push(entries.back().get(), [json]() {
+					return obs_data_create_from_json(json->dump().c_str());
+				});
+				return false;
+			}
+			return true;
+		};
+
+		try {
+			// Top level keys other than "sources" belong to the frontend.
+			nlohmann::json frontend = nlohmann::json::parse(file, callback);
+		} catch (nlohmann::json::exception&) {
+			malformed = true;
+		}
+		pool.finish();
+	}
+	fclose(file);
+
+	if (malformed) {
+		DiscardLoad(entries);
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Collection file is malformed.");
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(FinishLoad(entries)));
+	AUTO_DEBUG;
+}
+
+void osn::Collection::Save(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	// Sources are serialized here, as obs_data is not thread safe and the
+	// next handlers keep changing it. Only the file is written by the writer
+	// thread.
+	std::string text    = "{\"sources\":[";
+	auto        enum_cb = [](void* data, obs_source_t* source) {
+		std::string* text = static_cast<std::string*>(data);
+		obs_data_t*  save = obs_save_source(source);
+		if (text->back() != '[')
+			text->push_back(',');
+		text->append(obs_data_get_json(save));
+		obs_data_release(save);
+		return true;
+	};
+	obs_enum_sources(enum_cb, &text);
+	obs_enum_scenes(enum_cb, &text);
+	text.append("]}");
+
+	SaveWriter::GetInstance().queue(args[0].value_str, std::vector<char>(text.begin(), text.end()));
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void osn::Collection::Flush(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	std::string error = SaveWriter::GetInstance().wait();
+	if (!error.empty()) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, error);
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void osn::Collection::SetSnapshot(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	std::string path     = args[0].value_str;
+	uint32_t    interval = args[1].value_union.ui32;
+	if (!path.empty() && interval == 0) {
+		PRETTY_ERROR_RETURN(ErrorCode::OutOfBounds, "Snapshot interval must be greater than zero.");
+	}
+
+	// The first snapshot is taken right after this handler.
+	snapshot_schedule.path     = path;
+	snapshot_schedule.interval = std::chrono::milliseconds(interval);
+	snapshot_schedule.next     = std::chrono::steady_clock::now();
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void osn::Collection::RestoreSnapshot(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	osn::Snapshot::Reader reader;
+	if (!reader.open(args[0].value_str)) {
+		PRETTY_ERROR_RETURN(ErrorCode::NotFound, "Snapshot could not be opened.");
+	}
+
+	// Records are decoded straight out of the mapping by the pool.
+	std::vector<std::unique_ptr<LoadEntry>> entries;
+	{
+		LoadPool pool;
+		for (size_t idx = 0; idx < reader.count(); idx++) {
+			entries.emplace_back(new LoadEntry);
+			pool.push(entries.back().get(), [&reader, idx]() { return reader.read(idx); });
+		}
+		pool.finish();
+	}
+
+	for (auto& entry : entries) {
+		if (!entry->data) {
+			DiscardLoad(entries);
+			PRETTY_ERROR_RETURN(ErrorCode::Error, "Snapshot is corrupt.");
+		}
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(FinishLoad(entries)));
+	AUTO_DEBUG;
+}
@@ -0,0 +1,150 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-dispatch.hpp"
+#include <ipc-class.hpp>
+#include <ipc-function.hpp>
+#include <ipc-server.hpp>
+#include <map>
+#include <set>
+#include <vector>
+
+namespace
+{
+	typedef std::map<std::string, std::set<std::string>> FunctionTable;
+
+	// Getters that only look objects up through the managers and read them.
+	// The event queues (Query, GlobalQuery) and the render timing have their
+	// own mutex. Getters with side effects stay exclusive: Source.GetSettings
+	// rewrites the cached json of the settings, Source.GetProperties runs
+	// plugin code and updates the source, the Scene item lookups allocate
+	// item ids and the device lists create a temporary source.
+	const FunctionTable read_functions = {
+	    {"CallbackManager", {"GlobalQuery", "Subscribe", "Unsubscribe"}},
+	    {"AutoConfig", {"Query"}},
+	    {"Service", {"Query"}},
+	    {"API", {"OBS_API_QueryHotkeys"}},
+	    {"Fader", {"GetDeziBel", "GetDeflection", "GetMultiplier"}},
+	    {"Filter", {"Types"}},
+	    {"Global",
+	     {"GetOutputSource", "GetOutputFlagsFromId", "LaggedFrames", "TotalFrames", "GetLocale",
+	      "GetMultipleRendering"}},
+	    {"Input",
+	     {"Types", "GetPublicSources", "GetActive", "GetShowing", "GetWidth", "GetHeight", "GetVolume",
+	      "GetSyncOffset", "GetAudioMixers", "GetMonitoringType", "GetDeInterlaceFieldOrder",
+	      "GetDeInterlaceMode", "GetFilters", "FindFilter", "GetDuration", "GetTime", "GetMediaState"}},
+	    {"Module",
+	     {"Modules", "GetName", "GetFileName", "GetAuthor", "GetDescription", "GetBinaryPath", "GetDataPath"}},
+	    {"Properties", {"GetListItems"}},
+	    {"Scene", {"AsSource"}},
+	    {"SceneItem",
+	     {"GetSource", "GetScene", "IsVisible", "IsSelected", "IsStreamVisible", "IsRecordingVisible",
+	      "GetPosition", "GetRotation", "GetScale", "GetScaleFilter", "GetAlignment", "GetBounds",
+	      "GetBoundsAlignment", "GetBoundsType", "GetCrop", "GetId", "GetTransform"}},
+	    {"Settings", {"LONGISLAND_settings_getWindowLists"}},
+	    {"Source",
+	     {"GetDefaults", "GetTypes", "IsConfigurable", "GetType", "GetName", "GetOutputFlags", "GetFlags",
+	      "GetStatus", "GetId", "GetMuted", "GetEnabled"}},
+	    {"Transition", {"Types", "GetActiveSource"}},
+	    {"Video", {"GetSkippedFrames", "GetTotalFrames", "GetStatsPage", "GetRenderTiming"}},
+	    {"Volmeter", {"Query"}},
+	};
+
+	// Building the settings categories fills in missing defaults of the
+	// basic config, so it is ordered against other config writers but not
+	// against the getters above.
+	const FunctionTable config_functions = {
+	    {"Settings", {"OBS_settings_getSettings"}},
+	};
+
+	typedef osn::Dispatch::Access (*Refinement)(const std::vector<ipc::value>& args);
+
+	// The Output category creates the streaming and recording encoders when
+	// they are missing and swaps them into the service, so it runs alone.
+	osn::Dispatch::Access settings_access(const std::vector<ipc::value>& args)
+	{
+		if (args.empty() || args[0].value_str == "Output")
+			return osn::Dispatch::Access::Write;
+		return osn::Dispatch::Access::Config;
+	}
+
+	// Functions whose access depends on their arguments.
+	const std::map<std::pair<std::string, std::string>, Refinement> refined_functions = {
+	    {{"Settings", "OBS_settings_getSettings"}, settings_access},
+	};
+
+	bool listed(const FunctionTable& table, const std::string& collection, const std::string& function)
+	{
+		auto it = table.find(collection);
+		return it != table.end() && it->second.count(function) != 0;
+	}
+
+	struct Guarded
+	{
+		osn::Dispatch::Access          access;
+		Refinement                     refine = nullptr;
+		std::shared_ptr<ipc::function> original;
+	};
+
+	// Wrappers live as long as the server, which is the process.
+	std::vector<std::unique_ptr<Guarded>> guarded;
+
+	void (*write_epilogue)() = nullptr;
+
+	void call_guarded(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval)
+	{
+		Guarded*              entry  = static_cast<Guarded*>(data);
+		osn::Dispatch::Access access = entry->refine ? entry->refine(args) : entry->access;
+		osn::Dispatch::Scope  scope(access);
+		entry->original->call(id, args, rval);
+		if (access == osn::Dispatch::Access::Write && write_epilogue)
+			write_epilogue();
+	}
+} // namespace
+
+osn::Dispatch::Access osn::Dispatch::Classify(const std::string& collection, const std::string& function)
+{
+	if (listed(read_functions, collection, function))
+		return Access::Read;
+	if (listed(config_functions, collection, function))
+		return Access::Config;
+	return Access::Write;
+}
+
+void osn::Dispatch::SetWriteEpilogue(void (*epilogue)())
+{
+	write_epilogue = epilogue;
+}
+
+void osn::Dispatch::Register(ipc::server& srv, std::shared_ptr<ipc::collection> cls)
+{
+	for (size_t idx = 0; idx < cls->count_functions(); idx++) {
+		std::shared_ptr<ipc::function> fn = cls->get_function(idx);
+
+		auto entry      = std::make_unique<Guarded>();
+		entry->access   = Classify(cls->get_name(), fn->get_name());
+
+		auto refined = refined_functions.find({cls->get_name(), fn->get_name()});
+		if (refined != refined_functions.end())
+			entry->refine = refined->second;
+		entry->original = std::make_shared<ipc::function>(*fn);
+		fn->set_call_handler(call_guarded, entry.get());
+		guarded.push_back(std::move(entry));
+	}
+	srv.register_collection(cls);
+}
@@ -0,0 +1,89 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <string>
+
+namespace ipc
+{
+	class server;
+	class collection;
+} // namespace ipc
+
+namespace osn
+{
+	// The IPC server runs the calls of each connection on that connection's
+	// thread, so handlers of different connections run side by side. Every
+	// handler is wrapped to hold the locks its access level asks for.
+	class Dispatch
+	{
+		public:
+		enum class Access
+		{
+			// Only reads libobs objects or state guarded by its own mutex,
+			// runs next to other Read and Config handlers.
+			Read,
+			// Reads libobs objects and changes the configuration files but
+			// never a libobs object. Runs next to Read handlers, ordered
+			// against other Config and all Write handlers.
+			Config,
+			// Creates, changes or destroys libobs objects, runs alone.
+			Write,
+		};
+
+		// Locks held while a handler of the given access runs.
+		class Scope
+		{
+			public:
+			Scope(Access access)
+			{
+				if (access == Access::Write) {
+					objects = std::unique_lock<std::shared_mutex>(objects_mtx);
+					return;
+				}
+
+				shared_objects = std::shared_lock<std::shared_mutex>(objects_mtx);
+				if (access == Access::Config)
+					config = std::unique_lock<std::mutex>(config_mtx);
+			}
+
+			private:
+			inline static std::shared_mutex objects_mtx;
+			inline static std::mutex        config_mtx;
+
+			std::unique_lock<std::shared_mutex> objects;
+			std::shared_lock<std::shared_mutex> shared_objects;
+			std::unique_lock<std::mutex>        config;
+		};
+
+		// Access of `collection`.`function`, Write unless listed otherwise.
+		// A few functions refine it per call from their arguments, e.g. the
+		// Output settings category is Write.
+		static Access Classify(const std::string& collection, const std::string& function);
+
+		// Called after every Write handler, on its thread and with its
+		// exclusive lock still held.
+		static void SetWriteEpilogue(void (*epilogue)());
+
+		// Wraps every function of `cls` in a Scope and registers it on `srv`.
+		static void Register(ipc::server& srv, std::shared_ptr<ipc::collection> cls);
+	};
+} // namespace osn
@@ -0,0 +1,84 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-event-log.hpp"
+#include <set>
+
+namespace
+{
+	struct Registry
+	{
+		std::mutex                      mtx;
+		std::vector<osn::EventLogBase*> logs;
+		std::set<uint64_t>              subscribers;
+		uint64_t                        next = 1;
+	};
+
+	// Logs are globals of several translation units, the registry has to
+	// exist before the first of them.
+	Registry& registry()
+	{
+		static Registry instance;
+		return instance;
+	}
+} // namespace
+
+osn::EventLogBase::EventLogBase()
+{
+	EventSubscribers::Add(this);
+}
+
+osn::EventLogBase::~EventLogBase()
+{
+	EventSubscribers::Remove(this);
+}
+
+uint64_t osn::EventSubscribers::Subscribe()
+{
+	Registry&                    reg = registry();
+	std::unique_lock<std::mutex> ulock(reg.mtx);
+	uint64_t                     subscriber = reg.next++;
+	reg.subscribers.insert(subscriber);
+	for (EventLogBase* log : reg.logs)
+		log->Attach(subscriber);
+	return subscriber;
+}
+
+void osn::EventSubscribers::Unsubscribe(uint64_t subscriber)
+{
+	Registry&                    reg = registry();
+	std::unique_lock<std::mutex> ulock(reg.mtx);
+	if (!reg.subscribers.erase(subscriber))
+		return;
+	for (EventLogBase* log : reg.logs)
+		log->Detach(subscriber);
+}
+
+void osn::EventSubscribers::Add(EventLogBase* log)
+{
+	Registry&                    reg = registry();
+	std::unique_lock<std::mutex> ulock(reg.mtx);
+	reg.logs.push_back(log);
+}
+
+void osn::EventSubscribers::Remove(EventLogBase* log)
+{
+	Registry&                    reg = registry();
+	std::unique_lock<std::mutex> ulock(reg.mtx);
+	reg.logs.erase(std::remove(reg.logs.begin(), reg.logs.end(), log), reg.logs.end());
+}
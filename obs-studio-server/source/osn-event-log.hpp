@@ -0,0 +1,141 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <algorithm>
+#include <deque>
+#include <inttypes.h>
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace osn
+{
+	// Base of the event logs a subscriber gets a cursor in.
+	class EventLogBase
+	{
+		public:
+		EventLogBase();
+		virtual ~EventLogBase();
+
+		virtual void Attach(uint64_t subscriber) = 0;
+		virtual void Detach(uint64_t subscriber) = 0;
+	};
+
+	// Clients polling for events, see CallbackManager.Subscribe. Every
+	// client takes one subscription and passes it with each query, so all
+	// of them see every event no matter who polls first.
+	class EventSubscribers
+	{
+		public:
+		static uint64_t Subscribe();
+		static void     Unsubscribe(uint64_t subscriber);
+
+		private:
+		friend class EventLogBase;
+		static void Add(EventLogBase* log);
+		static void Remove(EventLogBase* log);
+	};
+
+	// Events kept once, with one read position per subscriber. An event is
+	// dropped when every subscriber read it, or when a subscriber stops
+	// polling and the log grows past `capacity`; that subscriber then
+	// resumes at the oldest event still kept.
+	template<typename T>
+	class EventLog : public EventLogBase
+	{
+		public:
+		EventLog(size_t capacity = 4096) : capacity(capacity) {}
+
+		void Attach(uint64_t subscriber) override
+		{
+			std::unique_lock<std::mutex> ulock(mtx);
+			cursors[subscriber] = first + events.size();
+		}
+
+		void Detach(uint64_t subscriber) override
+		{
+			std::unique_lock<std::mutex> ulock(mtx);
+			cursors.erase(subscriber);
+			trim();
+		}
+
+		void Push(T event)
+		{
+			std::unique_lock<std::mutex> ulock(mtx);
+			if (cursors.empty())
+				return;
+			events.push_back(std::move(event));
+			trim();
+		}
+
+		void Push(std::vector<T> batch)
+		{
+			std::unique_lock<std::mutex> ulock(mtx);
+			if (cursors.empty())
+				return;
+			for (T& event : batch)
+				events.push_back(std::move(event));
+			trim();
+		}
+
+		// Events `subscriber` has not read yet, at most `limit` of them.
+		std::vector<T> Read(uint64_t subscriber, size_t limit = SIZE_MAX)
+		{
+			std::vector<T>               result;
+			std::unique_lock<std::mutex> ulock(mtx);
+			auto                         cursor = cursors.find(subscriber);
+			if (cursor == cursors.end())
+				return result;
+
+			size_t begin = size_t(cursor->second - first);
+			size_t end   = begin + std::min(limit, events.size() - begin);
+			result.assign(events.begin() + begin, events.begin() + end);
+			cursor->second = first + end;
+			trim();
+			return result;
+		}
+
+		private:
+		void trim()
+		{
+			uint64_t oldest = first + events.size();
+			for (auto& cursor : cursors)
+				oldest = std::min(oldest, cursor.second);
+
+			while (!events.empty() && first < oldest) {
+				events.pop_front();
+				first++;
+			}
+
+			// Past capacity the slowest readers lose their oldest events.
+			while (events.size() > capacity) {
+				events.pop_front();
+				first++;
+			}
+			for (auto& cursor : cursors)
+				cursor.second = std::max(cursor.second, first);
+		}
+
+		std::mutex                   mtx;
+		std::deque<T>                events;
+		uint64_t                     first = 0;
+		size_t                       capacity;
+		std::map<uint64_t, uint64_t> cursors;
+	};
+} // namespace osn
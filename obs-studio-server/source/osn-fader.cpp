@@ -19,6 +19,7 @@
 #include "osn-fader.hpp"
 #include "error.hpp"
 #include "obs.h"
+#include "osn-dispatch.hpp"
 #include "osn-source.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
@@ -55,7 +56,7 @@ void osn::Fader::Register(ipc::server& srv)
 	    std::make_shared<ipc::function>("AddCallback", std::vector<ipc::type>{ipc::type::UInt64}, AddCallback));
 	cls->register_function(
 	    std::make_shared<ipc::function>("RemoveCallback", std::vector<ipc::type>{ipc::type::UInt64}, RemoveCallback));
-	srv.register_collection(cls);
+	osn::Dispatch::Register(srv, cls);
 }
 
 void osn::Fader::ClearFaders()
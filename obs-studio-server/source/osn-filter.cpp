@@ -21,6 +21,8 @@
 #include <memory>
 #include <obs.h>
 #include "error.hpp"
+#include "osn-dispatch.hpp"
+#include "osn-source-types.hpp"
 #include "osn-source.hpp"
 #include "shared.hpp"
 
@@ -32,7 +34,7 @@ void osn::Filter::Register(ipc::server& srv)
 	    "Create", std::vector<ipc::type>{ipc::type::String, ipc::type::String}, Create));
 	cls->register_function(std::make_shared<ipc::function>(
 	    "Create", std::vector<ipc::type>{ipc::type::String, ipc::type::String, ipc::type::String}, Create));
-	srv.register_collection(cls);
+	osn::Dispatch::Register(srv, cls);
 }
 
 void osn::Filter::Types(
@@ -41,11 +43,11 @@ void osn::Filter::Types(
     const std::vector<ipc::value>& args,
     std::vector<ipc::value>&       rval)
 {
+	auto catalog = osn::SourceTypes::Get();
+
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-	const char* typeId = nullptr;
-	for (size_t idx = 0; obs_enum_filter_types(idx, &typeId); idx++) {
-		rval.push_back(ipc::value(typeId ? typeId : ""));
-	}
+	for (auto& type : catalog->ids[obs::SourceTypeEntry::Filter])
+		rval.push_back(ipc::value(type));
 	AUTO_DEBUG;
 }
 
@@ -0,0 +1,134 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-frame-stats.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <new>
+#include <obs.h>
+#include <thread>
+#include <util/platform.h>
+#include "nodeobs_service.h"
+#include "obs-frame-stats.hpp"
+#include "obs-shared-memory.hpp"
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace
+{
+	// Roughly one frame at 60 fps, readers never see data older than that.
+	const std::chrono::milliseconds publish_interval(16);
+
+	std::mutex              publisher_mtx;
+	std::condition_variable publisher_cv;
+	std::thread             publisher;
+	bool                    publishing = false;
+	obs::SharedMemory       memory;
+	obs::FrameStatsPage*    page = nullptr;
+	std::string             page_name;
+
+	obs::FrameStats sample()
+	{
+		obs::FrameStats stats;
+		stats.render_total  = obs_get_total_frames();
+		stats.render_lagged = obs_get_lagged_frames();
+
+		video_t* video = obs_get_video();
+		if (video) {
+			stats.video_total   = video_output_get_total_frames(video);
+			stats.video_skipped = video_output_get_skipped_frames(video);
+		}
+
+		// The IPC thread may replace the output meanwhile, the reference
+		// keeps the one being sampled alive.
+		obs_output_t* output = OBS_service::getStreamingOutputRef();
+		if (output && obs_output_active(output)) {
+			stats.output_total      = uint64_t(obs_output_get_total_frames(output));
+			stats.output_dropped    = uint64_t(obs_output_get_frames_dropped(output));
+			stats.output_congestion = obs_output_get_congestion(output);
+		}
+		obs_output_release(output);
+
+		stats.active_fps         = obs_get_active_fps();
+		stats.average_frame_time = obs_get_average_frame_time_ns();
+		stats.updated            = os_gettime_ns();
+		return stats;
+	}
+
+	void publish()
+	{
+		std::unique_lock<std::mutex> ulock(publisher_mtx);
+		while (publishing) {
+			ulock.unlock();
+			page->write(sample());
+			ulock.lock();
+			publisher_cv.wait_for(ulock, publish_interval, [] { return !publishing; });
+		}
+	}
+} // namespace
+
+void osn::FrameStats::Start()
+{
+	std::unique_lock<std::mutex> ulock(publisher_mtx);
+	if (publishing)
+		return;
+
+#ifdef WIN32
+	std::string name = "osn-stats-" + std::to_string(GetCurrentProcessId());
+#else
+	std::string name = "osn-stats-" + std::to_string(getpid());
+#endif
+	if (!memory.create(name, sizeof(obs::FrameStatsPage))) {
+		blog(LOG_WARNING, "Failed to create the frame stats page, clients fall back to IPC.");
+		return;
+	}
+
+	page       = new (memory.data()) obs::FrameStatsPage();
+	page_name  = name;
+	publishing = true;
+	publisher  = std::thread(publish);
+}
+
+void osn::FrameStats::Stop()
+{
+	{
+		std::unique_lock<std::mutex> ulock(publisher_mtx);
+		if (!publishing)
+			return;
+		publishing = false;
+	}
+	publisher_cv.notify_all();
+	if (publisher.joinable())
+		publisher.join();
+
+	std::unique_lock<std::mutex> ulock(publisher_mtx);
+	page->~FrameStatsPage();
+	page = nullptr;
+	page_name.clear();
+	memory.close();
+}
+
+std::string osn::FrameStats::PageName()
+{
+	std::unique_lock<std::mutex> ulock(publisher_mtx);
+	return page_name;
+}
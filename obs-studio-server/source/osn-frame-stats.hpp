@@ -0,0 +1,35 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <string>
+
+namespace osn
+{
+	// Publishes obs::FrameStats into a shared memory page about once per
+	// frame, see Video.GetStatsPage.
+	class FrameStats
+	{
+		public:
+		static void Start();
+		static void Stop();
+
+		// Name of the page, empty while not publishing.
+		static std::string PageName();
+	};
+} // namespace osn
@@ -19,6 +19,7 @@
 #include "osn-global.hpp"
 #include <error.hpp>
 #include <obs.h>
+#include "osn-dispatch.hpp"
 #include "osn-source.hpp"
 #include "shared.hpp"
 
@@ -40,7 +41,7 @@ void osn::Global::Register(ipc::server& srv)
 	    std::make_shared<ipc::function>("GetMultipleRendering", std::vector<ipc::type>{}, GetMultipleRendering));
 	cls->register_function(std::make_shared<ipc::function>(
 	    "SetMultipleRendering", std::vector<ipc::type>{ipc::type::Int32}, SetMultipleRendering));
-	srv.register_collection(cls);
+	osn::Dispatch::Register(srv, cls);
 }
 
 void osn::Global::GetOutputSource(
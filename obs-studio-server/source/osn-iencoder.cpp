@@ -18,6 +18,7 @@
 
 #include "osn-IEncoder.hpp"
 #include "error.hpp"
+#include "osn-dispatch.hpp"
 #include "utility.hpp"
 #include <obs.h>
 
@@ -43,7 +44,7 @@ void osn::IEncoder::Register(ipc::server& srv)
 	    std::make_shared<ipc::function>("GetSettings", std::vector<ipc::type>{ipc::type::String}, &GetSettings));
 	cls->register_function(
 	    std::make_shared<ipc::function>("Release", std::vector<ipc::type>{ipc::type::String}, &Release));
-	srv.register_collection(cls);
+	osn::Dispatch::Register(srv, cls);
 }
 
 void osn::IEncoder::GetId(
@@ -17,11 +17,19 @@
 ******************************************************************************/
 
 #include "osn-Input.hpp"
+#include <algorithm>
+#include <atomic>
 #include <iostream>
 #include <ipc-server.hpp>
+#include <map>
 #include <memory>
+#include <obs-import.hpp>
 #include <obs.h>
+#include <thread>
 #include "error.hpp"
+#include "osn-dispatch.hpp"
+#include "osn-sceneitem.hpp"
+#include "osn-source-types.hpp"
 #include "osn-source.hpp"
 #include "shared.hpp"
 
@@ -47,6 +55,8 @@ void osn::Input::Register(ipc::server& srv)
 	    std::make_shared<ipc::function>("FromName", std::vector<ipc::type>{ipc::type::String}, FromName));
 	cls->register_function(
 	    std::make_shared<ipc::function>("GetPublicSources", std::vector<ipc::type>{}, GetPublicSources));
+	cls->register_function(
+	    std::make_shared<ipc::function>("CreateBulk", std::vector<ipc::type>{ipc::type::Binary}, CreateBulk));
 
 	cls->register_function(
 	    std::make_shared<ipc::function>("Duplicate", std::vector<ipc::type>{ipc::type::UInt64}, Duplicate));
@@ -99,6 +109,8 @@ void osn::Input::Register(ipc::server& srv)
 	    "MoveFilter", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64, ipc::type::UInt32}, MoveFilter));
 	cls->register_function(std::make_shared<ipc::function>(
 	    "FindFilter", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String}, FindFilter));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "SetFilterChain", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Binary}, SetFilterChain));
 	cls->register_function(std::make_shared<ipc::function>(
 	    "CopyFiltersTo", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, CopyFiltersTo));
 
@@ -119,16 +131,16 @@ void osn::Input::Register(ipc::server& srv)
 	cls->register_function(std::make_shared<ipc::function>(
 	    "GetMediaState", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int64}, GetMediaState));
 
-	srv.register_collection(cls);
+	osn::Dispatch::Register(srv, cls);
 }
 
 void osn::Input::Types(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval)
 {
+	auto catalog = osn::SourceTypes::Get();
+
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-	const char* typeId = nullptr;
-	for (size_t idx = 0; obs_enum_input_types(idx, &typeId); idx++) {
-		rval.push_back(ipc::value(typeId ? typeId : ""));
-	}
+	for (auto& type : catalog->ids[obs::SourceTypeEntry::Input])
+		rval.push_back(ipc::value(type));
 	AUTO_DEBUG;
 }
 
@@ -296,6 +308,135 @@ void osn::Input::GetPublicSources(
 	AUTO_DEBUG;
 }
 
+// Parses every non-empty JSON document of `json` into `parsed`, spreading
+// the work over a few threads. obs_data_create_from_json only touches the
+// object it returns, so the documents can be parsed independently.
+static void ParseSettingsParallel(std::vector<const std::string*> const& json, std::vector<obs_data_t*>& parsed)
+{
+	parsed.assign(json.size(), nullptr);
+
+	std::atomic<size_t> next(0);
+	auto                worker = [&]() {
+		for (size_t idx = next++; idx < json.size(); idx = next++) {
+			if (!json[idx]->empty())
+				parsed[idx] = obs_data_create_from_json(json[idx]->c_str());
+		}
+	};
+
+	// Small documents parse faster than a thread starts, keep a few per worker.
+	size_t threads = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), json.size() / 8 + 1);
+
+	std::vector<std::thread> workers;
+	for (size_t idx = 1; idx < threads; idx++)
+		workers.emplace_back(worker);
+	worker();
+	for (auto& thread : workers)
+		thread.join();
+}
+
+void osn::Input::CreateBulk(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	std::vector<obs::InputDefinition> definitions;
+	if (!obs::read_definitions(args[0].value_bin, definitions)) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Input definitions are malformed.");
+	}
+
+	// Resolve every target scene before anything is created, so that a bad
+	// reference does not leave a partially imported collection behind.
+	std::map<uint64_t, obs_scene_t*> scenes;
+	for (auto& input : definitions) {
+		for (auto& placement : input.placements) {
+			if (scenes.count(placement.scene))
+				continue;
+			obs_scene_t* scene = obs_scene_from_source(osn::Source::Manager::GetInstance().find(placement.scene));
+			if (!scene) {
+				PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Scene reference is not valid.");
+			}
+			scenes.emplace(placement.scene, scene);
+		}
+	}
+
+	// Settings, hotkeys and filter settings of all inputs in one flat list.
+	std::vector<const std::string*> json;
+	for (auto& input : definitions) {
+		json.push_back(&input.settings);
+		json.push_back(&input.hotkeys);
+		for (auto& filter : input.filters)
+			json.push_back(&filter.settings);
+	}
+	std::vector<obs_data_t*> parsed;
+	ParseSettingsParallel(json, parsed);
+
+	std::vector<obs::InputImportResult> results(definitions.size());
+	size_t                              next = 0;
+	for (size_t idx = 0; idx < definitions.size(); idx++) {
+		obs::InputDefinition&   input    = definitions[idx];
+		obs::InputImportResult& result   = results[idx];
+		obs_data_t*             settings = parsed[next++];
+		obs_data_t*             hotkeys  = parsed[next++];
+
+		obs_source_t* source = obs_source_create(input.type.c_str(), input.name.c_str(), settings, hotkeys);
+		obs_data_release(hotkeys);
+		obs_data_release(settings);
+
+		uint64_t uid = source ? osn::Source::Manager::GetInstance().find(source) : UINT64_MAX;
+		if (uid == UINT64_MAX) {
+			for (size_t fdx = 0; fdx < input.filters.size(); fdx++)
+				obs_data_release(parsed[next++]);
+			continue;
+		}
+		result.uid          = uid;
+		result.audio_mixers = obs_source_get_audio_mixers(source);
+
+		for (auto& definition : input.filters) {
+			obs_data_t*   filter_settings = parsed[next++];
+			obs_source_t* filter =
+			    obs_source_create_private(definition.type.c_str(), definition.name.c_str(), filter_settings);
+			obs_data_release(filter_settings);
+
+			uint64_t filter_uid = filter ? osn::Source::Manager::GetInstance().allocate(filter) : UINT64_MAX;
+			result.filters.push_back(filter_uid);
+			if (filter_uid == UINT64_MAX)
+				continue;
+
+			osn::Source::attach_source_signals(filter);
+			obs_source_set_enabled(filter, definition.enabled);
+			obs_source_filter_add(source, filter);
+		}
+
+		for (auto& placement : input.placements) {
+			obs_sceneitem_t* item = obs_scene_add(scenes[placement.scene], source);
+			if (!item) {
+				result.items.push_back({UINT64_MAX, 0});
+				continue;
+			}
+
+			utility::unique_id::id_t item_uid = osn::SceneItem::Manager::GetInstance().allocate(item);
+			if (item_uid == UINT64_MAX) {
+				obs_sceneitem_remove(item);
+				result.items.push_back({UINT64_MAX, 0});
+				continue;
+			}
+
+			obs_sceneitem_defer_update_begin(item);
+			osn::SceneItem::ApplyTransform(item, placement.transform);
+			obs_sceneitem_set_visible(item, placement.visible);
+			obs_sceneitem_defer_update_end(item);
+
+			obs_sceneitem_addref(item);
+			result.items.push_back({item_uid, obs_sceneitem_get_id(item)});
+		}
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(obs::serialize_results(results)));
+	AUTO_DEBUG;
+}
+
 void osn::Input::GetActive(
     void*                          data,
     const int64_t                  id,
@@ -686,6 +827,96 @@ void osn::Input::GetFilters(
 	AUTO_DEBUG;
 }
 
+void osn::Input::SetFilterChain(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	obs_source_t* input = osn::Source::Manager::GetInstance().find(args[0].value_union.ui64);
+	if (!input) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Input reference is not valid.");
+	}
+
+	std::vector<obs::FilterChainEntry> entries;
+	if (!obs::read_list(args[1].value_bin, entries)) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Filter chain is malformed.");
+	}
+
+	// Resolve and validate the whole chain before touching the input, so a
+	// bad entry leaves the current chain as it is.
+	std::vector<obs_source_t*> chain;
+	chain.reserve(entries.size());
+	for (auto& entry : entries) {
+		obs_source_t* filter = osn::Source::Manager::GetInstance().find(entry.uid);
+		if (!filter || obs_source_get_type(filter) != OBS_SOURCE_TYPE_FILTER) {
+			PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Filter reference is not valid.");
+		}
+		if (std::find(chain.begin(), chain.end(), filter) != chain.end()) {
+			PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Filter is listed more than once.");
+		}
+		obs_source_t* parent = obs_filter_get_parent(filter);
+		if (parent && parent != input) {
+			PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Filter is attached to another source.");
+		}
+		chain.push_back(filter);
+	}
+
+	auto enum_cb = [](obs_source_t* parent, obs_source_t* filter, void* data) {
+		reinterpret_cast<std::vector<obs_source_t*>*>(data)->push_back(filter);
+	};
+	std::vector<obs_source_t*> current;
+	obs_source_enum_filters(input, enum_cb, &current);
+
+	// Drop what is no longer wanted, then attach the new filters. Added
+	// filters land at the bottom of the chain in the order they are given.
+	for (obs_source_t* filter : current) {
+		if (std::find(chain.begin(), chain.end(), filter) == chain.end())
+			obs_source_filter_remove(input, filter);
+	}
+	current.erase(
+	    std::remove_if(
+	        current.begin(),
+	        current.end(),
+	        [&chain](obs_source_t* filter) { return std::find(chain.begin(), chain.end(), filter) == chain.end(); }),
+	    current.end());
+	for (obs_source_t* filter : chain) {
+		if (std::find(current.begin(), current.end(), filter) == current.end()) {
+			obs_source_filter_add(input, filter);
+			current.push_back(filter);
+		}
+	}
+
+	// The longest prefix of the wanted chain that already appears in order
+	// stays where it is; everything after it is moved to the bottom once.
+	size_t kept = 0;
+	for (obs_source_t* filter : current) {
+		if (kept < chain.size() && chain[kept] == filter)
+			kept++;
+	}
+	for (size_t idx = kept; idx < chain.size(); idx++)
+		obs_source_filter_set_order(input, chain[idx], OBS_ORDER_MOVE_BOTTOM);
+
+	for (size_t idx = 0; idx < chain.size(); idx++) {
+		bool enabled = entries[idx].enabled != 0;
+		if (obs_source_enabled(chain[idx]) != enabled)
+			obs_source_set_enabled(chain[idx], enabled);
+	}
+
+	std::vector<uint64_t> order;
+	order.reserve(chain.size());
+	auto order_cb = [](obs_source_t* parent, obs_source_t* filter, void* data) {
+		uint64_t uid = osn::Source::Manager::GetInstance().find(filter);
+		if (uid != UINT64_MAX)
+			reinterpret_cast<std::vector<uint64_t>*>(data)->push_back(uid);
+	};
+	obs_source_enum_filters(input, order_cb, &order);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(obs::serialize_list(order)));
+	AUTO_DEBUG;
+}
+
 void osn::Input::CopyFiltersTo(
     void*                          data,
     const int64_t                  id,
@@ -0,0 +1,155 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-media-state.hpp"
+#include <map>
+#include <mutex>
+#include <util/platform.h>
+#include "osn-source.hpp"
+
+namespace
+{
+	const uint64_t clock_interval_ns = 1000000000;
+
+	const char* media_signals[] = {"media_play",
+	                               "media_pause",
+	                               "media_restart",
+	                               "media_stopped",
+	                               "media_next",
+	                               "media_previous",
+	                               "media_started",
+	                               "media_ended"};
+
+	struct TrackedMedia
+	{
+		uint64_t           uid       = UINT64_MAX;
+		obs_weak_source_t* weak      = nullptr;
+		obs_media_state    state     = OBS_MEDIA_STATE_NONE;
+		uint64_t           published = 0;
+		bool               signalled = true;
+	};
+
+	std::mutex                            tracked_mtx;
+	std::map<obs_source_t*, TrackedMedia> tracked;
+
+	// Media signals come from the media thread of the source, only flag the
+	// input here and sample it on the next Collect.
+	void on_media_signal(void* data, calldata_t*)
+	{
+		std::unique_lock<std::mutex> ulock(tracked_mtx);
+		auto                         found = tracked.find(static_cast<obs_source_t*>(data));
+		if (found != tracked.end())
+			found->second.signalled = true;
+	}
+} // namespace
+
+void osn::MediaState::Track(obs_source_t* source)
+{
+	if (!source || obs_source_get_type(source) != OBS_SOURCE_TYPE_INPUT)
+		return;
+	if ((obs_source_get_output_flags(source) & OBS_SOURCE_CONTROLLABLE_MEDIA) == 0)
+		return;
+
+	uint64_t uid = osn::Source::Manager::GetInstance().find(source);
+	if (uid == UINT64_MAX)
+		return;
+
+	{
+		std::unique_lock<std::mutex> ulock(tracked_mtx);
+		TrackedMedia&                media = tracked[source];
+		media.uid                          = uid;
+		media.weak                         = obs_source_get_weak_source(source);
+	}
+
+	signal_handler_t* sh = obs_source_get_signal_handler(source);
+	for (const char* signal : media_signals)
+		signal_handler_connect(sh, signal, on_media_signal, source);
+}
+
+void osn::MediaState::Untrack(obs_source_t* source)
+{
+	obs_weak_source_t* weak = nullptr;
+	{
+		std::unique_lock<std::mutex> ulock(tracked_mtx);
+		auto                         found = tracked.find(source);
+		if (found == tracked.end())
+			return;
+		weak = found->second.weak;
+		tracked.erase(found);
+	}
+
+	signal_handler_t* sh = obs_source_get_signal_handler(source);
+	for (const char* signal : media_signals)
+		signal_handler_disconnect(sh, signal, on_media_signal, source);
+	obs_weak_source_release(weak);
+}
+
+std::vector<obs::MediaClock> osn::MediaState::Collect()
+{
+	struct Candidate
+	{
+		obs_source_t* source;
+		bool          signalled;
+	};
+
+	// Take strong references under the lock and sample outside of it, the
+	// media calls go into the plugin which may raise signals of its own.
+	std::vector<Candidate> candidates;
+	{
+		std::unique_lock<std::mutex> ulock(tracked_mtx);
+		candidates.reserve(tracked.size());
+		for (auto& entry : tracked) {
+			obs_source_t* source = obs_weak_source_get_source(entry.second.weak);
+			if (!source)
+				continue;
+			candidates.push_back({source, entry.second.signalled});
+			entry.second.signalled = false;
+		}
+	}
+
+	std::vector<obs::MediaClock> clocks;
+	uint64_t                     now = os_gettime_ns();
+	for (auto& candidate : candidates) {
+		obs_media_state state    = obs_source_media_get_state(candidate.source);
+		int64_t         time     = obs_source_media_get_time(candidate.source);
+		int64_t         duration = obs_source_media_get_duration(candidate.source);
+
+		std::unique_lock<std::mutex> ulock(tracked_mtx);
+		auto                         found = tracked.find(candidate.source);
+		if (found != tracked.end()) {
+			TrackedMedia& media = found->second;
+			bool          tick  = state == OBS_MEDIA_STATE_PLAYING && now - media.published >= clock_interval_ns;
+			if (candidate.signalled || state != media.state || tick) {
+				media.state     = state;
+				media.published = now;
+
+				obs::MediaClock clock;
+				clock.uid      = media.uid;
+				clock.state    = int32_t(state);
+				clock.time     = time;
+				clock.duration = duration;
+				clocks.push_back(clock);
+			}
+		}
+		ulock.unlock();
+
+		obs_source_release(candidate.source);
+	}
+
+	return clocks;
+}
@@ -0,0 +1,40 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <obs.h>
+#include <vector>
+#include "obs-media.hpp"
+
+namespace osn
+{
+	// Follows the playback state of inputs with controllable media through
+	// their media signals, so clients learn about it from the callback poll
+	// instead of querying every input several times a second.
+	class MediaState
+	{
+		public:
+		static void Track(obs_source_t* source);
+		static void Untrack(obs_source_t* source);
+
+		// Clocks due for publishing: inputs that changed state or raised a
+		// media signal since the last call, and playing inputs whose last
+		// clock is older than a second.
+		static std::vector<obs::MediaClock> Collect();
+	};
+} // namespace osn
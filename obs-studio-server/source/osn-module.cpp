@@ -18,6 +18,8 @@
 
 #include "osn-module.hpp"
 #include "error.hpp"
+#include "osn-dispatch.hpp"
+#include "osn-source-types.hpp"
 #include "shared.hpp"
 
 void osn::Module::Register(ipc::server& srv)
@@ -45,7 +47,7 @@ void osn::Module::Register(ipc::server& srv)
 	cls->register_function(
 	    std::make_shared<ipc::function>("GetDataPath", std::vector<ipc::type>{ipc::type::UInt64}, GetDataPath));
 
-	srv.register_collection(cls);
+	osn::Dispatch::Register(srv, cls);
 }
 
 void osn::Module::Open(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval)
@@ -101,8 +103,11 @@ void osn::Module::Initialize(
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Module reference is not valid.");
 	}
 	
+	bool initialized = obs_init_module(module);
+	osn::SourceTypes::Invalidate();
+
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-	rval.push_back(ipc::value(obs_init_module(module)));
+	rval.push_back(ipc::value(initialized));
 	AUTO_DEBUG;
 }
 
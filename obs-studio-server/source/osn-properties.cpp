@@ -17,11 +17,118 @@
 ******************************************************************************/
 
 #include "osn-Properties.hpp"
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <map>
+#include <mutex>
 #include "error.hpp"
+#include "memory-manager.h"
+#include "obs-property.hpp"
 #include "obs.h"
+#include "osn-dispatch.hpp"
 #include "osn-source.hpp"
 #include "shared.hpp"
 
+namespace
+{
+	// Sessions the client never closed are dropped oldest first.
+	const size_t max_sessions = 32;
+
+	struct PropertySession
+	{
+		obs_weak_source_t* source = nullptr;
+		obs_properties_t*  props  = nullptr;
+
+		// Longer lists are sent without their items, see GetListItems.
+		uint32_t max_inline_list_items = 0;
+
+		// What the client was last sent, in order.
+		std::vector<std::string>                 names;
+		std::map<std::string, std::vector<char>> sent;
+
+		std::chrono::steady_clock::time_point last_use;
+
+		~PropertySession()
+		{
+			obs_properties_destroy(props);
+			obs_weak_source_release(source);
+		}
+	};
+
+	std::mutex                                           sessions_mtx;
+	std::map<uint64_t, std::unique_ptr<PropertySession>> sessions;
+	uint64_t                                             next_session = 1;
+
+	// Looks up a session and a strong reference to its source. Sessions are
+	// closed when the client releases or removes their source, one whose
+	// source was destroyed otherwise is dropped here. The source must be
+	// released by the caller.
+	PropertySession* find_session(uint64_t id, obs_source_t*& source)
+	{
+		source   = nullptr;
+		auto itr = sessions.find(id);
+		if (itr == sessions.end())
+			return nullptr;
+
+		source = obs_weak_source_get_source(itr->second->source);
+		if (!source) {
+			sessions.erase(itr);
+			return nullptr;
+		}
+
+		itr->second->last_use = std::chrono::steady_clock::now();
+		return itr->second.get();
+	}
+
+	// Walks the retained properties against the current settings and answers
+	// with whatever differs from what the client was sent last.
+	void push_changes(PropertySession* session, obs_source_t* source, std::vector<ipc::value>& rval)
+	{
+		obs_data_t* settings     = obs_source_get_settings(source);
+		bool        updateSource = false;
+
+		std::vector<std::shared_ptr<obs::Property>> props;
+		osn::Source::ProcessProperties(session->props, settings, updateSource, props, session->max_inline_list_items);
+
+		if (updateSource) {
+			obs_source_update(source, settings);
+			MemoryManager::GetInstance().updateSourceCache(source);
+		}
+		obs_data_release(settings);
+
+		std::vector<std::string>                 names;
+		std::map<std::string, std::vector<char>> sent;
+		std::vector<std::vector<char>*>          changed;
+		for (auto& prop : props) {
+			std::vector<char> buf(prop->size());
+			if (!prop->serialize(buf))
+				continue;
+
+			names.push_back(prop->name);
+			auto& entry = sent[prop->name];
+			entry       = std::move(buf);
+
+			auto last = session->sent.find(prop->name);
+			if (last == session->sent.end() || last->second != entry)
+				changed.push_back(&entry);
+		}
+
+		bool rebuilt = names != session->names;
+		rval.push_back(ipc::value((uint32_t)rebuilt));
+		if (rebuilt) {
+			for (auto& name : names)
+				rval.push_back(ipc::value(sent[name]));
+		} else {
+			for (auto entry : changed)
+				rval.push_back(ipc::value(*entry));
+		}
+
+		session->names = std::move(names);
+		session->sent  = std::move(sent);
+	}
+} // namespace
+
 void osn::Properties::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Properties");
@@ -29,7 +136,24 @@ void osn::Properties::Register(ipc::server& srv)
 	    "Modified", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String, ipc::type::String}, Modified));
 	cls->register_function(std::make_shared<ipc::function>(
 	    "Clicked", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String}, Clicked));
-	srv.register_collection(cls);
+	cls->register_function(std::make_shared<ipc::function>(
+	    "OpenSession", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32}, OpenSession));
+	cls->register_function(
+	    std::make_shared<ipc::function>("CloseSession", std::vector<ipc::type>{ipc::type::UInt64}, CloseSession));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "SessionModified",
+	    std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String, ipc::type::String},
+	    SessionModified));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "SessionClicked", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::String}, SessionClicked));
+	cls->register_function(
+	    std::make_shared<ipc::function>("RefreshSession", std::vector<ipc::type>{ipc::type::UInt64}, RefreshSession));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "GetListItems",
+	    std::vector<ipc::type>{
+	        ipc::type::UInt64, ipc::type::String, ipc::type::UInt32, ipc::type::UInt32, ipc::type::String},
+	    GetListItems));
+	osn::Dispatch::Register(srv, cls);
 }
 
 void osn::Properties::Modified(
@@ -90,3 +214,218 @@ void osn::Properties::Clicked(
 
 	AUTO_DEBUG;
 }
+
+void osn::Properties::OpenSession(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	obs_source_t* source = osn::Source::Manager::GetInstance().find(args[0].value_union.ui64);
+	if (!source) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Invalid reference.");
+	}
+
+	// Sources without properties get an empty session so the client can
+	// treat every source the same.
+	obs_properties_t* props = obs_source_properties(source);
+	if (!props)
+		props = obs_properties_create();
+
+	std::unique_lock<std::mutex> ulock(sessions_mtx);
+	if (sessions.size() >= max_sessions) {
+		auto oldest = sessions.begin();
+		for (auto itr = sessions.begin(); itr != sessions.end(); itr++) {
+			if (itr->second->last_use < oldest->second->last_use)
+				oldest = itr;
+		}
+		sessions.erase(oldest);
+	}
+
+	uint64_t session_id            = next_session++;
+	auto     session               = std::make_unique<PropertySession>();
+	session->source                = obs_source_get_weak_source(source);
+	session->props                 = props;
+	session->max_inline_list_items = args[1].value_union.ui32;
+	session->last_use              = std::chrono::steady_clock::now();
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(session_id));
+	push_changes(session.get(), source, rval);
+	sessions.emplace(session_id, std::move(session));
+	AUTO_DEBUG;
+}
+
+void osn::Properties::CloseSession(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	std::unique_lock<std::mutex> ulock(sessions_mtx);
+	sessions.erase(args[0].value_union.ui64);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
+void osn::Properties::CloseSessions(obs_source_t* source)
+{
+	std::unique_lock<std::mutex> ulock(sessions_mtx);
+	for (auto itr = sessions.begin(); itr != sessions.end();) {
+		if (obs_weak_source_references_source(itr->second->source, source))
+			itr = sessions.erase(itr);
+		else
+			itr++;
+	}
+}
+
+void osn::Properties::SessionModified(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	std::unique_lock<std::mutex> ulock(sessions_mtx);
+	obs_source_t*                source  = nullptr;
+	PropertySession*             session = find_session(args[0].value_union.ui64, source);
+	if (!session) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Invalid property session.");
+	}
+
+	obs_property_t* prop = obs_properties_get(session->props, args[1].value_str.c_str());
+	if (!prop) {
+		obs_source_release(source);
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Failed to find property in source.");
+	}
+
+	// Without explicit settings the callback works on the source's own
+	// settings, like the properties view in OBS does.
+	obs_data_t* settings = args[2].value_str.empty() ? obs_source_get_settings(source)
+	                                                 : obs_data_create_from_json(args[2].value_str.c_str());
+	bool        refresh  = obs_property_modified(prop, settings);
+	obs_data_release(settings);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value((int32_t)refresh));
+	push_changes(session, source, rval);
+	obs_source_release(source);
+	AUTO_DEBUG;
+}
+
+void osn::Properties::SessionClicked(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	std::unique_lock<std::mutex> ulock(sessions_mtx);
+	obs_source_t*                source  = nullptr;
+	PropertySession*             session = find_session(args[0].value_union.ui64, source);
+	if (!session) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Invalid property session.");
+	}
+
+	obs_property_t* prop = obs_properties_get(session->props, args[1].value_str.c_str());
+	if (!prop) {
+		obs_source_release(source);
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Failed to find property in source.");
+	}
+
+	bool refresh = obs_property_button_clicked(prop, source);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value((int32_t)refresh));
+	push_changes(session, source, rval);
+	obs_source_release(source);
+	AUTO_DEBUG;
+}
+
+void osn::Properties::RefreshSession(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	std::unique_lock<std::mutex> ulock(sessions_mtx);
+	obs_source_t*                source  = nullptr;
+	PropertySession*             session = find_session(args[0].value_union.ui64, source);
+	if (!session) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Invalid property session.");
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value((int32_t)1));
+	push_changes(session, source, rval);
+	obs_source_release(source);
+	AUTO_DEBUG;
+}
+
+static bool contains_nocase(const std::string& haystack, const std::string& needle)
+{
+	auto itr = std::search(haystack.begin(), haystack.end(), needle.begin(), needle.end(), [](char a, char b) {
+		return std::tolower((unsigned char)a) == std::tolower((unsigned char)b);
+	});
+	return itr != haystack.end();
+}
+
+void osn::Properties::GetListItems(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	uint32_t           offset = args[2].value_union.ui32;
+	uint32_t           count  = args[3].value_union.ui32;
+	const std::string& filter = args[4].value_str;
+
+	std::unique_lock<std::mutex> ulock(sessions_mtx);
+	obs_source_t*                source  = nullptr;
+	PropertySession*             session = find_session(args[0].value_union.ui64, source);
+	if (!session) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Invalid property session.");
+	}
+	obs_source_release(source);
+
+	obs_property_t* prop = obs_properties_get(session->props, args[1].value_str.c_str());
+	if (!prop || obs_property_get_type(prop) != OBS_PROPERTY_LIST) {
+		PRETTY_ERROR_RETURN(ErrorCode::NotFound, "Failed to find list property in source.");
+	}
+
+	obs::ListProperty list;
+	list.name                = obs_property_name(prop);
+	list.description         = "";
+	list.long_description    = "";
+	list.enabled             = obs_property_enabled(prop);
+	list.visible             = obs_property_visible(prop);
+	list.field_type          = obs::ListProperty::ListType(obs_property_list_type(prop));
+	list.format              = obs::ListProperty::Format(obs_property_list_format(prop));
+	list.current_value_int   = 0;
+	list.current_value_float = 0;
+	osn::Source::ReadListItems(prop, list);
+
+	// Keep the page of items that match the filter, item_count becomes the
+	// number of matches.
+	uint64_t matches = 0;
+	for (auto itr = list.items.begin(); itr != list.items.end();) {
+		if (!filter.empty() && !contains_nocase(itr->name, filter)) {
+			itr = list.items.erase(itr);
+			continue;
+		}
+		if (matches < offset || matches - offset >= count)
+			itr = list.items.erase(itr);
+		else
+			itr++;
+		matches++;
+	}
+	list.item_count = matches;
+
+	std::vector<char> buf(list.size());
+	if (!list.serialize(buf)) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Failed to serialize list items.");
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(buf));
+	AUTO_DEBUG;
+}
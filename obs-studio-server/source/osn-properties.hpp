@@ -18,6 +18,7 @@
 
 #pragma once
 #include <ipc-server.hpp>
+#include <obs.h>
 
 namespace osn
 {
@@ -30,5 +31,52 @@ namespace osn
 		    Modified(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
 		static void
 		    Clicked(void* data, const int64_t id, const std::vector<ipc::value>& args, std::vector<ipc::value>& rval);
+
+		// Property sessions keep the obs_properties_t of a source alive while
+		// its properties are being edited. OpenSession takes the source and
+		// the longest list sent with its items, and answers with Ok, the
+		// session id and the full list. SessionModified, SessionClicked and
+		// RefreshSession answer with Ok, the callback result, whether the list
+		// was rebuilt, then the properties that changed since the last answer
+		// (all of them when rebuilt).
+		static void OpenSession(
+		    void*                          data,
+		    const int64_t                  id,
+		    const std::vector<ipc::value>& args,
+		    std::vector<ipc::value>&       rval);
+		static void CloseSession(
+		    void*                          data,
+		    const int64_t                  id,
+		    const std::vector<ipc::value>& args,
+		    std::vector<ipc::value>&       rval);
+		static void SessionModified(
+		    void*                          data,
+		    const int64_t                  id,
+		    const std::vector<ipc::value>& args,
+		    std::vector<ipc::value>&       rval);
+		static void SessionClicked(
+		    void*                          data,
+		    const int64_t                  id,
+		    const std::vector<ipc::value>& args,
+		    std::vector<ipc::value>&       rval);
+		static void RefreshSession(
+		    void*                          data,
+		    const int64_t                  id,
+		    const std::vector<ipc::value>& args,
+		    std::vector<ipc::value>&       rval);
+
+		// Drops the sessions of a source, called when the client releases or
+		// removes it.
+		static void CloseSessions(obs_source_t* source);
+
+		// Lists longer than a page are sent by sessions with only their
+		// selected item. GetListItems answers with Ok and an obs::ListProperty
+		// holding the requested page of the items whose name contains the
+		// filter, item_count being the number of matches.
+		static void GetListItems(
+		    void*                          data,
+		    const int64_t                  id,
+		    const std::vector<ipc::value>& args,
+		    std::vector<ipc::value>&       rval);
 	};
-} // namespace osn
\ No newline at end of file
+} // namespace osn
@@ -0,0 +1,206 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-render-timing.hpp"
+#include <chrono>
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <obs.h>
+#include <string>
+#include <thread>
+#include <vector>
+#include <util/platform.h>
+#include <util/profiler.h>
+
+namespace
+{
+	// Root the graphics thread registers with the profiler, followed by the
+	// frame interval, e.g. "obs_graphics_thread(16.6667 ms)".
+	const char*                graphics_root = "obs_graphics_thread";
+	const std::chrono::seconds sample_interval(1);
+
+	struct Sample
+	{
+		uint64_t usec;
+		uint64_t count;
+		uint64_t budget_usec;
+	};
+
+	// Frame times seen within one sample interval, kept sparse since a
+	// second only holds a few distinct values.
+	struct Second
+	{
+		uint64_t            start = 0;
+		uint64_t            end   = 0;
+		std::vector<Sample> samples;
+	};
+
+	std::mutex              sampler_mtx;
+	std::condition_variable sampler_cv;
+	std::thread             sampler;
+	bool                    sampling = false;
+
+	// The profiler keeps cumulative counts per root and frame time, only
+	// the growth since the previous snapshot is new.
+	std::map<std::string, std::map<uint64_t, uint64_t>> seen;
+	std::deque<Second>                                  window;
+	obs::TimingHistogram                                since_reset;
+	uint64_t                                            reset_time  = 0;
+	uint64_t                                            last_sample = 0;
+
+	bool enum_root(void* param, profiler_snapshot_entry_t* entry)
+	{
+		Second*     second = static_cast<Second*>(param);
+		const char* name   = profiler_snapshot_entry_name(entry);
+		if (!name || strncmp(name, graphics_root, strlen(graphics_root)) != 0)
+			return true;
+
+		profiler_time_entries_t* times = profiler_snapshot_entry_times(entry);
+		if (!times)
+			return true;
+
+		uint64_t budget_usec = obs_get_frame_interval_ns() / 1000;
+		auto&    counts      = seen[name];
+		for (size_t idx = 0; idx < times->num; idx++) {
+			const profiler_time_entry& time     = times->array[idx];
+			uint64_t&                  previous = counts[time.time_delta];
+			if (time.count > previous)
+				second->samples.push_back({time.time_delta, time.count - previous, budget_usec});
+			previous = time.count;
+		}
+		return true;
+	}
+
+	// Caller holds sampler_mtx. Queries sample as well, their frames join the
+	// second that is still open instead of starting a new one.
+	void sample()
+	{
+		uint64_t now = os_gettime_ns();
+		uint64_t interval =
+		    uint64_t(std::chrono::duration_cast<std::chrono::nanoseconds>(sample_interval).count());
+		if (window.empty() || now - window.back().start >= interval) {
+			Second second;
+			second.start = last_sample;
+			window.push_back(std::move(second));
+		}
+
+		Second& second = window.back();
+		size_t  first  = second.samples.size();
+
+		profiler_snapshot_t* snap = profile_snapshot_create();
+		if (snap) {
+			profiler_snapshot_enumerate(snap, enum_root, &second);
+			profile_snapshot_free(snap);
+		}
+		second.end  = now;
+		last_sample = now;
+
+		for (size_t idx = first; idx < second.samples.size(); idx++) {
+			const Sample& entry = second.samples[idx];
+			since_reset.add(entry.usec, entry.count, entry.budget_usec);
+		}
+
+		uint64_t horizon = uint64_t(osn::RenderTiming::max_window) * 1000000000;
+		while (!window.empty() && now - window.front().end > horizon)
+			window.pop_front();
+	}
+
+	void run()
+	{
+		std::unique_lock<std::mutex> ulock(sampler_mtx);
+		while (sampling) {
+			sampler_cv.wait_for(ulock, sample_interval, [] { return !sampling; });
+			if (sampling)
+				sample();
+		}
+	}
+} // namespace
+
+void osn::RenderTiming::Start()
+{
+	std::unique_lock<std::mutex> ulock(sampler_mtx);
+	if (sampling)
+		return;
+
+	// The graphics thread only times its frames while the profiler runs.
+	profiler_start();
+
+	seen.clear();
+	window.clear();
+	since_reset.clear();
+	reset_time  = os_gettime_ns();
+	last_sample = reset_time;
+	sampling    = true;
+	sampler     = std::thread(run);
+}
+
+void osn::RenderTiming::Stop()
+{
+	{
+		std::unique_lock<std::mutex> ulock(sampler_mtx);
+		if (!sampling)
+			return;
+		sampling = false;
+	}
+	sampler_cv.notify_all();
+	if (sampler.joinable())
+		sampler.join();
+
+	// Started again on the next init, with a new name store.
+	profiler_stop();
+	profiler_free();
+}
+
+obs::RenderTiming osn::RenderTiming::Collect(bool reset)
+{
+	std::unique_lock<std::mutex> ulock(sampler_mtx);
+	if (sampling)
+		sample();
+
+	uint64_t          now    = last_sample;
+	obs::RenderTiming timing = since_reset.summary(obs_get_frame_interval_ns(), now - reset_time);
+	if (reset) {
+		since_reset.clear();
+		reset_time = now;
+	}
+	return timing;
+}
+
+obs::RenderTiming osn::RenderTiming::CollectWindow(uint32_t seconds)
+{
+	if (seconds > max_window)
+		seconds = max_window;
+
+	std::unique_lock<std::mutex> ulock(sampler_mtx);
+	if (sampling)
+		sample();
+
+	uint64_t             now     = last_sample;
+	uint64_t             horizon = uint64_t(seconds) * 1000000000;
+	uint64_t             start   = now;
+	obs::TimingHistogram histogram;
+	for (auto it = window.rbegin(); it != window.rend() && now - it->start <= horizon; ++it) {
+		for (const Sample& entry : it->samples)
+			histogram.add(entry.usec, entry.count, entry.budget_usec);
+		start = it->start;
+	}
+	return histogram.summary(obs_get_frame_interval_ns(), now - start);
+}
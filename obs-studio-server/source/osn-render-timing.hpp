@@ -0,0 +1,43 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <inttypes.h>
+#include "obs-render-timing.hpp"
+
+namespace osn
+{
+	// Collects the per frame time of the graphics thread from the libobs
+	// profiler about once a second, see Video.GetRenderTiming.
+	class RenderTiming
+	{
+		public:
+		// Longest window CollectWindow can answer for.
+		static const uint32_t max_window = 300;
+
+		static void Start();
+		static void Stop();
+
+		// Frames rendered since the previous reset, `reset` starts a new
+		// period once the answer is taken.
+		static obs::RenderTiming Collect(bool reset);
+
+		// Frames rendered in the last `seconds` seconds.
+		static obs::RenderTiming CollectWindow(uint32_t seconds);
+	};
+} // namespace osn
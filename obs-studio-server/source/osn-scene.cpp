@@ -18,10 +18,102 @@
 
 #include "osn-scene.hpp"
 #include <list>
+#include <map>
+#include <mutex>
+#include <util/platform.h>
 #include "error.hpp"
+#include "osn-dispatch.hpp"
 #include "osn-sceneitem.hpp"
+#include "osn-spatial-index.hpp"
 #include "shared.hpp"
 
+// Uid of an item, allocating one on first use. UINT64_MAX if the list is full.
+static utility::unique_id::id_t ItemUid(obs_sceneitem_t* item)
+{
+	utility::unique_id::id_t uid = osn::SceneItem::Manager::GetInstance().find(item);
+	if (uid == UINT64_MAX) {
+		uid = osn::SceneItem::Manager::GetInstance().allocate(item);
+		if (uid != UINT64_MAX)
+			obs_sceneitem_addref(item);
+	}
+	return uid;
+}
+
+static bool PushItem(obs_sceneitem_t* item, std::vector<ipc::value>& rval)
+{
+	utility::unique_id::id_t uid = ItemUid(item);
+	if (uid == UINT64_MAX)
+		return false;
+	rval.push_back(ipc::value((uint64_t)uid));
+	rval.push_back(ipc::value(obs_sceneitem_get_id(item)));
+	return true;
+}
+
+static bool PackItems(std::vector<obs_sceneitem_t*> const& items, std::vector<obs::SceneItemRef>& refs)
+{
+	refs.resize(items.size());
+	for (size_t idx = 0; idx < items.size(); idx++) {
+		refs[idx].uid     = ItemUid(items[idx]);
+		refs[idx].item_id = obs_sceneitem_get_id(items[idx]);
+		if (refs[idx].uid == UINT64_MAX)
+			return false;
+	}
+	return true;
+}
+
+// Revision of the item list of every scene a client asked for, changed
+// whenever an item is added, removed or reordered. Revisions come from a
+// single counter so a destroyed scene never hands out a stale one.
+class ItemRevisions
+{
+	std::mutex                        mtx;
+	std::map<obs_source_t*, uint64_t> revisions;
+	uint64_t                          next = 0;
+
+	static void on_change(void* data, calldata_t* cd)
+	{
+		obs_scene_t* scene = nullptr;
+		calldata_get_ptr(cd, "scene", &scene);
+		if (!scene)
+			return;
+
+		ItemRevisions&               self = *static_cast<ItemRevisions*>(data);
+		std::unique_lock<std::mutex> lock(self.mtx);
+		self.revisions[obs_scene_get_source(scene)] = self.next++;
+	}
+
+	static void on_destroy(void* data, calldata_t* cd)
+	{
+		obs_source_t* source = nullptr;
+		calldata_get_ptr(cd, "source", &source);
+
+		ItemRevisions&               self = *static_cast<ItemRevisions*>(data);
+		std::unique_lock<std::mutex> lock(self.mtx);
+		self.revisions.erase(source);
+	}
+
+	public:
+	static ItemRevisions& GetInstance()
+	{
+		static ItemRevisions instance;
+		return instance;
+	}
+
+	uint64_t get(obs_source_t* source)
+	{
+		std::unique_lock<std::mutex> lock(mtx);
+		auto                         found = revisions.find(source);
+		if (found != revisions.end())
+			return found->second;
+
+		signal_handler_t* sh = obs_source_get_signal_handler(source);
+		for (const char* signal : {"item_add", "item_remove", "reorder", "refresh"})
+			signal_handler_connect(sh, signal, on_change, this);
+		signal_handler_connect(sh, "destroy", on_destroy, this);
+		return revisions[source] = next++;
+	}
+};
+
 void osn::Scene::Register(ipc::server& srv)
 {
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Scene");
@@ -60,18 +152,39 @@ void osn::Scene::Register(ipc::server& srv)
 	    "OrderItems", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Binary}, OrderItems));
 	cls->register_function(std::make_shared<ipc::function>(
 	    "GetItem", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32}, GetItem));
-	cls->register_function(
-	    std::make_shared<ipc::function>("GetItems", std::vector<ipc::type>{ipc::type::UInt64}, GetItems));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "GetItems", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, GetItems));
 	cls->register_function(std::make_shared<ipc::function>(
 	    "GetItemsInRange",
 	    std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Int32, ipc::type::Int32},
 	    GetItemsInRange));
 
+	cls->register_function(std::make_shared<ipc::function>(
+	    "CommitEdit", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Binary}, CommitEdit));
+
+	cls->register_function(std::make_shared<ipc::function>(
+	    "HitTest", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Float, ipc::type::Float}, HitTest));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "SelectItems",
+	    std::vector<ipc::type>{
+	        ipc::type::UInt64, ipc::type::Float, ipc::type::Float, ipc::type::Float, ipc::type::Float},
+	    SelectItems));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "SnapRect",
+	    std::vector<ipc::type>{ipc::type::UInt64,
+	                           ipc::type::UInt64,
+	                           ipc::type::Float,
+	                           ipc::type::Float,
+	                           ipc::type::Float,
+	                           ipc::type::Float,
+	                           ipc::type::Float},
+	    SnapRect));
+
 	cls->register_function(
 	    std::make_shared<ipc::function>("Connect", std::vector<ipc::type>{ipc::type::UInt64}, Connect));
 	cls->register_function(
 	    std::make_shared<ipc::function>("Disconnect", std::vector<ipc::type>{ipc::type::UInt64}, Disconnect));
-	srv.register_collection(cls);
+	osn::Dispatch::Register(srv, cls);
 }
 
 void osn::Scene::Create(
@@ -255,11 +368,16 @@ void osn::Scene::Duplicate(
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not a scene.");
 	}
 
+	// The duplication time is returned so that the client can tell which
+	// type suits its scenes.
+	uint64_t start = os_gettime_ns();
+
 	obs_scene_t* scene2 =
 	    obs_scene_duplicate(scene, args[1].value_str.c_str(), (obs_scene_duplicate_type)args[2].value_union.i32);
 	if (!scene2) {
 		PRETTY_ERROR_RETURN(ErrorCode::Error, "Failed to duplicate scene.");
 	}
+	uint64_t elapsed = os_gettime_ns() - start;
 
 	obs_source_t* source2 = obs_scene_get_source(scene2);
 	if (!source2) {
@@ -273,6 +391,7 @@ void osn::Scene::Duplicate(
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(uid));
+	rval.push_back(ipc::value(elapsed));
 	AUTO_DEBUG;
 }
 
@@ -603,27 +722,30 @@ void osn::Scene::GetItems(
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not a scene.");
 	}
 
-	std::list<obs_sceneitem_t*> items;
-	auto                        cb = [](obs_scene_t* scene, obs_sceneitem_t* item, void* data) {
-        std::list<obs_sceneitem_t*>* items = reinterpret_cast<std::list<obs_sceneitem_t*>*>(data);
-        items->push_back(item);
-        return true;
+	// The caller already holds the list at this revision.
+	uint64_t revision = ItemRevisions::GetInstance().get(source);
+	if (revision == args[1].value_union.ui64) {
+		rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+		rval.push_back(ipc::value(revision));
+		AUTO_DEBUG;
+		return;
+	}
+
+	std::vector<obs_sceneitem_t*> items;
+	auto                          cb = [](obs_scene_t* scene, obs_sceneitem_t* item, void* data) {
+		static_cast<std::vector<obs_sceneitem_t*>*>(data)->push_back(item);
+		return true;
 	};
 	obs_scene_enum_items(scene, cb, &items);
 
-	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-	for (obs_sceneitem_t* item : items) {
-		utility::unique_id::id_t uid = osn::SceneItem::Manager::GetInstance().find(item);
-		if (uid == UINT64_MAX) {
-			uid = osn::SceneItem::Manager::GetInstance().allocate(item);
-			if (uid == UINT64_MAX) {
-				PRETTY_ERROR_RETURN(ErrorCode::CriticalError, "Index list is full.");
-			}
-			obs_sceneitem_addref(item);
-		}
-		rval.push_back(ipc::value((uint64_t)uid));
-		rval.push_back(ipc::value(obs_sceneitem_get_id(item)));
+	std::vector<obs::SceneItemRef> refs;
+	if (!PackItems(items, refs)) {
+		PRETTY_ERROR_RETURN(ErrorCode::CriticalError, "Index list is full.");
 	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(revision));
+	rval.push_back(ipc::value(obs::serialize_list(refs)));
 	AUTO_DEBUG;
 }
 
@@ -645,12 +767,12 @@ void osn::Scene::GetItemsInRange(
 
 	struct EnumData
 	{
-		std::list<obs_sceneitem_t*> items;
-		size_t                      index_from = 0, index_to = 0;
-		size_t                      index = 0;
+		std::vector<obs_sceneitem_t*> items;
+		size_t                        index_from = 0, index_to = 0;
+		size_t                        index = 0;
 	} ed;
-	ed.index_from = args[1].value_union.ui64;
-	ed.index_to   = args[1].value_union.ui64;
+	ed.index_from = args[1].value_union.i32;
+	ed.index_to   = args[2].value_union.i32;
 
 	auto cb = [](obs_scene_t* scene, obs_sceneitem_t* item, void* data) {
 		EnumData* ed = reinterpret_cast<EnumData*>(data);
@@ -664,18 +786,174 @@ void osn::Scene::GetItemsInRange(
 	};
 	obs_scene_enum_items(scene, cb, &ed);
 
+	std::vector<obs::SceneItemRef> refs;
+	if (!PackItems(ed.items, refs)) {
+		PRETTY_ERROR_RETURN(ErrorCode::CriticalError, "Index list is full.");
+	}
+
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-	for (obs_sceneitem_t* item : ed.items) {
-		utility::unique_id::id_t uid = osn::SceneItem::Manager::GetInstance().find(item);
-		if (uid == UINT64_MAX) {
-			uid = osn::SceneItem::Manager::GetInstance().allocate(item);
-			if (uid == UINT64_MAX) {
-				PRETTY_ERROR_RETURN(ErrorCode::CriticalError, "Index list is full.");
-			}
-			obs_sceneitem_addref(item);
+	rval.push_back(ipc::value(obs::serialize_list(refs)));
+	AUTO_DEBUG;
+}
+
+void osn::Scene::CommitEdit(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	obs_source_t* source = osn::Source::Manager::GetInstance().find(args[0].value_union.ui64);
+	if (!source) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not valid.");
+	}
+
+	obs_scene_t* scene = obs_scene_from_source(source);
+	if (!scene) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not a scene.");
+	}
+
+	struct EditData
+	{
+		std::vector<obs::SceneItemEdit> edits;
+		std::vector<obs_sceneitem_t*>   items;
+	} ed;
+
+	if (!obs::read_list(args[1].value_bin, ed.edits)) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Edit data is malformed.");
+	}
+
+	// Resolve every item before touching anything so a bad reference
+	// leaves the scene untouched.
+	ed.items.reserve(ed.edits.size());
+	for (auto& edit : ed.edits) {
+		obs_sceneitem_t* item = osn::SceneItem::Manager::GetInstance().find(edit.item_id);
+		if (!item || obs_sceneitem_get_scene(item) != scene) {
+			PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Item reference is not valid.");
 		}
-		rval.push_back(ipc::value((uint64_t)uid));
+		ed.items.push_back(item);
+	}
+
+	// The atomic update holds the scene locks for the whole batch, the
+	// render thread only ever sees the scene before or after the edit.
+	auto cb = [](void* data, obs_scene_t* scene) {
+		EditData* ed = reinterpret_cast<EditData*>(data);
+
+		for (auto item : ed->items)
+			obs_sceneitem_defer_update_begin(item);
+
+		for (size_t idx = 0; idx < ed->edits.size(); idx++) {
+			const obs::SceneItemEdit& edit = ed->edits[idx];
+			obs_sceneitem_t*          item = ed->items[idx];
+
+			osn::SceneItem::ApplyTransform(item, edit.transform);
+
+			if (edit.has(obs::SceneItemEdit::Visible))
+				obs_sceneitem_set_visible(item, !!edit.visible);
+			if (edit.has(obs::SceneItemEdit::Order))
+				obs_sceneitem_set_order_position(item, edit.order_position);
+		}
+
+		for (auto item : ed->items)
+			obs_sceneitem_defer_update_end(item);
+	};
+	obs_scene_atomic_update(scene, cb, &ed);
+
+	std::vector<obs::Transform> transforms(ed.items.size());
+	for (size_t idx = 0; idx < ed.items.size(); idx++)
+		osn::SceneItem::ReadTransform(ed.items[idx], transforms[idx]);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(obs::serialize_list(transforms)));
+	AUTO_DEBUG;
+}
+
+void osn::Scene::HitTest(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	obs_source_t* source = osn::Source::Manager::GetInstance().find(args[0].value_union.ui64);
+	if (!source || !obs_scene_from_source(source)) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not a valid scene.");
 	}
+
+	obs_sceneitem_t* item =
+	    osn::SpatialIndex::Get(source)->HitTest(args[1].value_union.fp32, args[2].value_union.fp32);
+
+	// An empty answer means nothing is under the point.
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	if (item && !PushItem(item, rval)) {
+		rval.clear();
+		PRETTY_ERROR_RETURN(ErrorCode::CriticalError, "Index list is full.");
+	}
+	AUTO_DEBUG;
+}
+
+void osn::Scene::SelectItems(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	obs_source_t* source = osn::Source::Manager::GetInstance().find(args[0].value_union.ui64);
+	if (!source || !obs_scene_from_source(source)) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not a valid scene.");
+	}
+
+	osn::SpatialIndex::Rect rect;
+	rect.left   = args[1].value_union.fp32;
+	rect.top    = args[2].value_union.fp32;
+	rect.right  = rect.left + args[3].value_union.fp32;
+	rect.bottom = rect.top + args[4].value_union.fp32;
+	if (rect.right < rect.left)
+		std::swap(rect.left, rect.right);
+	if (rect.bottom < rect.top)
+		std::swap(rect.top, rect.bottom);
+
+	std::vector<obs_sceneitem_t*> items = osn::SpatialIndex::Get(source)->Select(rect);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	for (obs_sceneitem_t* item : items) {
+		if (!PushItem(item, rval)) {
+			rval.clear();
+			PRETTY_ERROR_RETURN(ErrorCode::CriticalError, "Index list is full.");
+		}
+	}
+	AUTO_DEBUG;
+}
+
+void osn::Scene::SnapRect(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	obs_source_t* source = osn::Source::Manager::GetInstance().find(args[0].value_union.ui64);
+	if (!source || !obs_scene_from_source(source)) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not a valid scene.");
+	}
+
+	// UINT64_MAX snaps to every item.
+	obs_sceneitem_t* exclude = nullptr;
+	if (args[1].value_union.ui64 != UINT64_MAX) {
+		exclude = osn::SceneItem::Manager::GetInstance().find(args[1].value_union.ui64);
+		if (!exclude) {
+			PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Item reference is not valid.");
+		}
+	}
+
+	osn::SpatialIndex::Rect rect;
+	rect.left   = args[2].value_union.fp32;
+	rect.top    = args[3].value_union.fp32;
+	rect.right  = rect.left + args[4].value_union.fp32;
+	rect.bottom = rect.top + args[5].value_union.fp32;
+
+	vec2 offset = osn::SpatialIndex::Get(source)->Snap(rect, exclude, args[6].value_union.fp32);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(offset.x));
+	rval.push_back(ipc::value(offset.y));
 	AUTO_DEBUG;
 }
 
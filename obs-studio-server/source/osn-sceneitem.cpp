@@ -18,6 +18,8 @@
 
 #include "osn-sceneitem.hpp"
 #include <error.hpp>
+#include <obs-transform.hpp>
+#include "osn-dispatch.hpp"
 #include "osn-source.hpp"
 #include "shared.hpp"
 
@@ -100,7 +102,11 @@ void osn::SceneItem::Register(ipc::server& srv)
 	    "DeferUpdateBegin", std::vector<ipc::type>{ipc::type::UInt64}, DeferUpdateBegin));
 	cls->register_function(
 	    std::make_shared<ipc::function>("DeferUpdateEnd", std::vector<ipc::type>{ipc::type::UInt64}, DeferUpdateEnd));
-	srv.register_collection(cls);
+	cls->register_function(
+	    std::make_shared<ipc::function>("GetTransform", std::vector<ipc::type>{ipc::type::UInt64}, GetTransform));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "SetTransform", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::Binary}, SetTransform));
+	osn::Dispatch::Register(srv, cls);
 }
 
 void osn::SceneItem::GetSource(
@@ -802,6 +808,128 @@ void osn::SceneItem::DeferUpdateEnd(
 	AUTO_DEBUG;
 }
 
+void osn::SceneItem::ReadTransform(obs_sceneitem_t* item, obs::Transform& tf)
+{
+	obs_transform_info info;
+	obs_sceneitem_get_info(item, &info);
+
+	obs_sceneitem_crop crop;
+	obs_sceneitem_get_crop(item, &crop);
+
+	tf.mask             = obs::Transform::All;
+	tf.position_x       = info.pos.x;
+	tf.position_y       = info.pos.y;
+	tf.rotation         = info.rot;
+	tf.scale_x          = info.scale.x;
+	tf.scale_y          = info.scale.y;
+	tf.alignment        = info.alignment;
+	tf.bounds_x         = info.bounds.x;
+	tf.bounds_y         = info.bounds.y;
+	tf.bounds_type      = info.bounds_type;
+	tf.bounds_alignment = info.bounds_alignment;
+	tf.crop_left        = crop.left;
+	tf.crop_top         = crop.top;
+	tf.crop_right       = crop.right;
+	tf.crop_bottom      = crop.bottom;
+	tf.scale_filter     = obs_sceneitem_get_scale_filter(item);
+}
+
+void osn::SceneItem::ApplyTransform(obs_sceneitem_t* item, const obs::Transform& tf)
+{
+	if (tf.has(obs::Transform::Position)) {
+		vec2 pos;
+		pos.x = tf.position_x;
+		pos.y = tf.position_y;
+		obs_sceneitem_set_pos(item, &pos);
+	}
+
+	if (tf.has(obs::Transform::Rotation))
+		obs_sceneitem_set_rot(item, tf.rotation);
+
+	if (tf.has(obs::Transform::Scale)) {
+		vec2 scale;
+		scale.x = tf.scale_x;
+		scale.y = tf.scale_y;
+		obs_sceneitem_set_scale(item, &scale);
+	}
+
+	if (tf.has(obs::Transform::Alignment))
+		obs_sceneitem_set_alignment(item, tf.alignment);
+
+	if (tf.has(obs::Transform::BoundsType))
+		obs_sceneitem_set_bounds_type(item, (obs_bounds_type)tf.bounds_type);
+
+	if (tf.has(obs::Transform::BoundsAlignment))
+		obs_sceneitem_set_bounds_alignment(item, tf.bounds_alignment);
+
+	if (tf.has(obs::Transform::Bounds)) {
+		vec2 bounds;
+		bounds.x = tf.bounds_x;
+		bounds.y = tf.bounds_y;
+		obs_sceneitem_set_bounds(item, &bounds);
+	}
+
+	if (tf.has(obs::Transform::Crop)) {
+		obs_sceneitem_crop crop;
+		crop.left   = tf.crop_left;
+		crop.top    = tf.crop_top;
+		crop.right  = tf.crop_right;
+		crop.bottom = tf.crop_bottom;
+		obs_sceneitem_set_crop(item, &crop);
+	}
+
+	if (tf.has(obs::Transform::ScaleFilter))
+		obs_sceneitem_set_scale_filter(item, (obs_scale_type)tf.scale_filter);
+}
+
+void osn::SceneItem::GetTransform(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	obs_sceneitem_t* item = osn::SceneItem::Manager::GetInstance().find(args[0].value_union.ui64);
+	if (!item) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Item reference is not valid.");
+	}
+
+	obs::Transform tf;
+	ReadTransform(item, tf);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(tf.serialize()));
+	AUTO_DEBUG;
+}
+
+void osn::SceneItem::SetTransform(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	obs_sceneitem_t* item = osn::SceneItem::Manager::GetInstance().find(args[0].value_union.ui64);
+	if (!item) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Item reference is not valid.");
+	}
+
+	obs::Transform tf;
+	if (!tf.read(args[1].value_bin)) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Transform data is malformed.");
+	}
+
+	// All fields land in a single transform update, so the render thread
+	// never sees a partially applied transform.
+	obs_sceneitem_defer_update_begin(item);
+	ApplyTransform(item, tf);
+	obs_sceneitem_defer_update_end(item);
+
+	ReadTransform(item, tf);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(tf.serialize()));
+	AUTO_DEBUG;
+}
+
 osn::SceneItem::Manager& osn::SceneItem::Manager::GetInstance()
 {
 	// Thread Safe since C++13 (Visual Studio 2015, GCC 4.3).
@@ -19,6 +19,7 @@
 #pragma once
 #include <ipc-server.hpp>
 #include <obs.h>
+#include <obs-transform.hpp>
 #include <utility.hpp>
 
 namespace osn
@@ -189,5 +190,19 @@ namespace osn
 		    const int64_t                  id,
 		    const std::vector<ipc::value>& args,
 		    std::vector<ipc::value>&       rval);
+
+		static void GetTransform(
+		    void*                          data,
+		    const int64_t                  id,
+		    const std::vector<ipc::value>& args,
+		    std::vector<ipc::value>&       rval);
+		static void SetTransform(
+		    void*                          data,
+		    const int64_t                  id,
+		    const std::vector<ipc::value>& args,
+		    std::vector<ipc::value>&       rval);
+
+		static void ReadTransform(obs_sceneitem_t* item, obs::Transform& tf);
+		static void ApplyTransform(obs_sceneitem_t* item, const obs::Transform& tf);
 	};
 } // namespace osn
@@ -0,0 +1,75 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-shutdown-timings.hpp"
+#include <cstdio>
+#include <mutex>
+#include <string>
+#include <vector>
+#include <util/base.h>
+
+namespace
+{
+	struct PhaseTime
+	{
+		const char* name;
+		double      ms;
+	};
+
+	std::mutex                            timings_mtx;
+	std::vector<PhaseTime>                timings;
+	bool                                  timings_started = false;
+	std::chrono::steady_clock::time_point timings_start;
+} // namespace
+
+osn::ShutdownTimings::Phase::Phase(const char* name) : name(name), start(std::chrono::steady_clock::now())
+{
+	std::unique_lock<std::mutex> ulock(timings_mtx);
+	if (!timings_started) {
+		timings_started = true;
+		timings_start   = start;
+	}
+}
+
+osn::ShutdownTimings::Phase::~Phase()
+{
+	auto elapsed = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start);
+
+	std::unique_lock<std::mutex> ulock(timings_mtx);
+	timings.push_back({name, elapsed.count()});
+}
+
+void osn::ShutdownTimings::Report()
+{
+	std::unique_lock<std::mutex> ulock(timings_mtx);
+	if (!timings_started)
+		return;
+
+	auto total = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - timings_start);
+
+	std::string breakdown;
+	for (auto& phase : timings) {
+		char buf[128];
+		snprintf(buf, sizeof(buf), "%s%s %.1f ms", breakdown.empty() ? "" : ", ", phase.name, phase.ms);
+		breakdown += buf;
+	}
+	blog(LOG_INFO, "Server shutdown took %.1f ms (%s)", total.count(), breakdown.c_str());
+
+	timings.clear();
+	timings_started = false;
+}
@@ -0,0 +1,345 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-snapshot.hpp"
+#include <cstring>
+#include <obs-buffer.hpp>
+#include <util/bmem.h>
+#include <util/platform.h>
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+static const char     snapshot_magic[8] = {'O', 'S', 'N', 'S', 'N', 'A', 'P', '\0'};
+static const uint32_t snapshot_version  = 1;
+static const int      snapshot_depth    = 64;
+
+namespace
+{
+	enum class ItemType : uint8_t
+	{
+		End,
+		String,
+		Int,
+		Double,
+		Bool,
+		Object,
+		Array,
+	};
+
+	// Only user values are written, defaults are restored by the sources.
+	void EncodeData(obs::BufferWriter& out, obs_data_t* data)
+	{
+		for (obs_data_item_t* item = obs_data_first(data); item; obs_data_item_next(&item)) {
+			if (!obs_data_item_has_user_value(item))
+				continue;
+
+			std::string name = obs_data_item_get_name(item);
+			switch (obs_data_item_gettype(item)) {
+			case OBS_DATA_STRING: {
+				const char* value = obs_data_item_get_string(item);
+				out.write(ItemType::String);
+				out.write(name);
+				out.write(std::string(value ? value : ""));
+				break;
+			}
+			case OBS_DATA_NUMBER:
+				if (obs_data_item_numtype(item) == OBS_DATA_NUM_DOUBLE) {
+					out.write(ItemType::Double);
+					out.write(name);
+					out.write<double>(obs_data_item_get_double(item));
+				} else {
+					out.write(ItemType::Int);
+					out.write(name);
+					out.write<int64_t>(obs_data_item_get_int(item));
+				}
+				break;
+			case OBS_DATA_BOOLEAN:
+				out.write(ItemType::Bool);
+				out.write(name);
+				out.write<uint8_t>(obs_data_item_get_bool(item));
+				break;
+			case OBS_DATA_OBJECT: {
+				obs_data_t* obj = obs_data_item_get_obj(item);
+				out.write(ItemType::Object);
+				out.write(name);
+				EncodeData(out, obj);
+				obs_data_release(obj);
+				break;
+			}
+			case OBS_DATA_ARRAY: {
+				obs_data_array_t* array = obs_data_item_get_array(item);
+				size_t            count = obs_data_array_count(array);
+				out.write(ItemType::Array);
+				out.write(name);
+				out.write<uint32_t>(uint32_t(count));
+				for (size_t idx = 0; idx < count; idx++) {
+					obs_data_t* obj = obs_data_array_item(array, idx);
+					EncodeData(out, obj);
+					obs_data_release(obj);
+				}
+				obs_data_array_release(array);
+				break;
+			}
+			default:
+				break;
+			}
+		}
+		out.write(ItemType::End);
+	}
+
+	bool DecodeData(obs::BufferReader& in, obs_data_t* data, int depth)
+	{
+		if (depth > snapshot_depth)
+			return false;
+
+		while (true) {
+			ItemType    type = ItemType::End;
+			std::string name;
+			if (!in.read(type))
+				return false;
+			if (type == ItemType::End)
+				return true;
+			if (!in.read(name))
+				return false;
+
+			switch (type) {
+			case ItemType::String: {
+				std::string value;
+				if (!in.read(value))
+					return false;
+				obs_data_set_string(data, name.c_str(), value.c_str());
+				break;
+			}
+			case ItemType::Int: {
+				int64_t value = 0;
+				if (!in.read(value))
+					return false;
+				obs_data_set_int(data, name.c_str(), value);
+				break;
+			}
+			case ItemType::Double: {
+				double value = 0;
+				if (!in.read(value))
+					return false;
+				obs_data_set_double(data, name.c_str(), value);
+				break;
+			}
+			case ItemType::Bool: {
+				uint8_t value = 0;
+				if (!in.read(value))
+					return false;
+				obs_data_set_bool(data, name.c_str(), !!value);
+				break;
+			}
+			case ItemType::Object: {
+				obs_data_t* obj = obs_data_create();
+				bool        ok  = DecodeData(in, obj, depth + 1);
+				if (ok)
+					obs_data_set_obj(data, name.c_str(), obj);
+				obs_data_release(obj);
+				if (!ok)
+					return false;
+				break;
+			}
+			case ItemType::Array: {
+				uint32_t count = 0;
+				if (!in.read(count))
+					return false;
+
+				obs_data_array_t* array = obs_data_array_create();
+				bool              ok    = true;
+				for (uint32_t idx = 0; idx < count && ok; idx++) {
+					obs_data_t* obj = obs_data_create();
+					ok              = DecodeData(in, obj, depth + 1);
+					if (ok)
+						obs_data_array_push_back(array, obj);
+					obs_data_release(obj);
+				}
+				if (ok)
+					obs_data_set_array(data, name.c_str(), array);
+				obs_data_array_release(array);
+				if (!ok)
+					return false;
+				break;
+			}
+			default:
+				return false;
+			}
+		}
+	}
+} // namespace
+
+std::vector<char> osn::Snapshot::Capture()
+{
+	std::vector<obs_source_t*> sources;
+	auto                       enum_cb = [](void* data, obs_source_t* source) {
+		obs_source_addref(source);
+		static_cast<std::vector<obs_source_t*>*>(data)->push_back(source);
+		return true;
+	};
+	obs_enum_sources(enum_cb, &sources);
+	obs_enum_scenes(enum_cb, &sources);
+
+	obs::BufferWriter     records;
+	std::vector<uint64_t> offsets;
+	for (obs_source_t* source : sources) {
+		offsets.push_back(records.size());
+		obs_data_t* data = obs_save_source(source);
+		EncodeData(records, data);
+		obs_data_release(data);
+		obs_source_release(source);
+	}
+	offsets.push_back(records.size());
+
+	uint64_t header = sizeof(snapshot_magic) + sizeof(uint32_t) * 2 + sizeof(uint64_t) * offsets.size();
+	for (uint64_t& offset : offsets)
+		offset += header;
+
+	obs::BufferWriter out;
+	out.write(snapshot_magic);
+	out.write(snapshot_version);
+	out.write<uint32_t>(uint32_t(sources.size()));
+	for (uint64_t offset : offsets)
+		out.write(offset);
+
+	std::vector<char> image = std::move(out.data());
+	image.insert(image.end(), records.data().begin(), records.data().end());
+	return image;
+}
+
+osn::Snapshot::Reader::~Reader()
+{
+	close();
+}
+
+bool osn::Snapshot::Reader::open(std::string const& path)
+{
+	close();
+
+#ifdef WIN32
+	wchar_t* wpath = nullptr;
+	os_utf8_to_wcs_ptr(path.c_str(), 0, &wpath);
+	HANDLE file = CreateFileW(wpath, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	bfree(wpath);
+	if (file == INVALID_HANDLE_VALUE)
+		return false;
+	handle = file;
+
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0) {
+		close();
+		return false;
+	}
+	size = size_t(file_size.QuadPart);
+
+	mapping = CreateFileMappingW(file, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (mapping)
+		view = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+#else
+	int fd = ::open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return false;
+
+	struct stat st;
+	if (fstat(fd, &st) == 0 && st.st_size > 0) {
+		size       = size_t(st.st_size);
+		void* addr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+		if (addr != MAP_FAILED)
+			view = static_cast<const char*>(addr);
+	}
+	::close(fd);
+#endif
+	if (!view) {
+		close();
+		return false;
+	}
+
+	obs::BufferReader in(view, size);
+	char              magic[sizeof(snapshot_magic)];
+	uint32_t          version = 0;
+	uint32_t          count   = 0;
+	if (!in.read(magic) || std::memcmp(magic, snapshot_magic, sizeof(magic)) != 0 || !in.read(version)
+	    || version != snapshot_version || !in.read(count)) {
+		close();
+		return false;
+	}
+
+	// The offset table has to fit in the file before it is allocated.
+	if (uint64_t(count) + 1 > in.remaining() / sizeof(uint64_t)) {
+		close();
+		return false;
+	}
+
+	offsets.resize(size_t(count) + 1);
+	for (uint64_t& offset : offsets)
+		in.read(offset);
+
+	bool valid = in.ok();
+	for (size_t idx = 0; valid && idx < count; idx++)
+		valid = offsets[idx] <= offsets[idx + 1];
+	if (!valid || offsets.back() > size) {
+		close();
+		return false;
+	}
+	return true;
+}
+
+void osn::Snapshot::Reader::close()
+{
+#ifdef WIN32
+	if (view)
+		UnmapViewOfFile(view);
+	if (mapping)
+		CloseHandle(mapping);
+	if (handle)
+		CloseHandle(handle);
+#else
+	if (view)
+		munmap(const_cast<char*>(view), size);
+#endif
+	handle  = nullptr;
+	mapping = nullptr;
+	view    = nullptr;
+	size    = 0;
+	offsets.clear();
+}
+
+size_t osn::Snapshot::Reader::count() const
+{
+	return offsets.empty() ? 0 : offsets.size() - 1;
+}
+
+obs_data_t* osn::Snapshot::Reader::read(size_t idx) const
+{
+	if (idx >= count())
+		return nullptr;
+
+	obs::BufferReader in(view + offsets[idx], size_t(offsets[idx + 1] - offsets[idx]));
+	obs_data_t*       data = obs_data_create();
+	if (!DecodeData(in, data, 0) || !in.eof()) {
+		obs_data_release(data);
+		return nullptr;
+	}
+	return data;
+}
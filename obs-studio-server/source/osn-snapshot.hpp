@@ -0,0 +1,66 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <obs.h>
+#include <string>
+#include <vector>
+
+namespace osn
+{
+	// Binary image of every public input and scene, as returned by
+	// obs_save_source, used to restore a collection after a restart of the
+	// server without going through the client.
+	//
+	// Layout: magic, version, record count, a table of count + 1 record
+	// offsets, then the records. Each record is one obs_data object.
+	class Snapshot
+	{
+		public:
+		// Encodes every public input and scene. This runs their save
+		// callbacks and reads their settings, so it has to be called with
+		// the exclusive dispatch lock held. The result can be written to
+		// disk from any thread.
+		static std::vector<char> Capture();
+
+		// Maps a snapshot into memory. Records are independent of each
+		// other and can be decoded from several threads at once.
+		class Reader
+		{
+			void*       handle  = nullptr;
+			void*       mapping = nullptr;
+			const char* view    = nullptr;
+			size_t      size    = 0;
+
+			std::vector<uint64_t> offsets;
+
+			public:
+			Reader() {}
+			~Reader();
+			Reader(Reader const&) = delete;
+			Reader operator=(Reader const&) = delete;
+
+			bool open(std::string const& path);
+			void close();
+
+			size_t count() const;
+			// Returns a new obs_data for the record, or nullptr if it is corrupt.
+			obs_data_t* read(size_t idx) const;
+		};
+	};
+} // namespace osn
@@ -0,0 +1,75 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-source-types.hpp"
+#include <mutex>
+#include <obs.h>
+#include "obs-string-table.hpp"
+
+namespace
+{
+	std::mutex                                       catalog_mtx;
+	std::shared_ptr<const osn::SourceTypes::Catalog> catalog;
+
+	void add_types(
+	    osn::SourceTypes::Catalog& result,
+	    obs::StringTable&          strings,
+	    obs::SourceTypeEntry::Kind kind,
+	    bool (*enum_types)(size_t, const char**))
+	{
+		const char* type_id = nullptr;
+		for (size_t idx = 0; enum_types(idx, &type_id); idx++) {
+			std::string id = type_id ? type_id : "";
+			result.ids[kind].push_back(id);
+
+			obs::SourceTypeEntry entry;
+			entry.kind = kind;
+			entry.id   = strings.intern(id);
+			if (type_id) {
+				const char* display_name = obs_source_get_display_name(type_id);
+				entry.display_name       = strings.intern(display_name ? display_name : "");
+				entry.output_flags       = obs_get_source_output_flags(type_id);
+				entry.icon_type          = int32_t(obs_source_get_icon_type(type_id));
+			}
+			result.entries.push_back(entry);
+		}
+	}
+} // namespace
+
+std::shared_ptr<const osn::SourceTypes::Catalog> osn::SourceTypes::Get()
+{
+	std::unique_lock<std::mutex> ulock(catalog_mtx);
+	if (catalog)
+		return catalog;
+
+	auto             result = std::make_shared<Catalog>();
+	obs::StringTable strings;
+	add_types(*result, strings, obs::SourceTypeEntry::Input, obs_enum_input_types);
+	add_types(*result, strings, obs::SourceTypeEntry::Filter, obs_enum_filter_types);
+	add_types(*result, strings, obs::SourceTypeEntry::Transition, obs_enum_transition_types);
+	result->strings = std::move(strings.data);
+
+	catalog = result;
+	return catalog;
+}
+
+void osn::SourceTypes::Invalidate()
+{
+	std::unique_lock<std::mutex> ulock(catalog_mtx);
+	catalog.reset();
+}
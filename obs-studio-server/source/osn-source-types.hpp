@@ -0,0 +1,48 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+#include "obs-source-type.hpp"
+
+namespace osn
+{
+	// Catalogue of the registered input, filter and transition types with
+	// their display names, output flags and icons. It is built on first use
+	// and kept until modules change, so Input.Types, Filter.Types,
+	// Transition.Types and Source.GetTypes never walk libobs again.
+	class SourceTypes
+	{
+		public:
+		struct Catalog
+		{
+			std::vector<obs::SourceTypeEntry> entries;
+			std::vector<char>                 strings;
+
+			// Type ids per obs::SourceTypeEntry::Kind, in registration order.
+			std::vector<std::string> ids[3];
+		};
+
+		static std::shared_ptr<const Catalog> Get();
+
+		// Called whenever a module was initialized.
+		static void Invalidate();
+	};
+} // namespace osn
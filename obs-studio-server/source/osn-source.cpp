@@ -29,9 +29,13 @@
 #include "error.hpp"
 #include "obs-property.hpp"
 #include "osn-common.hpp"
+#include "osn-dispatch.hpp"
 #include "shared.hpp"
 #include "callback-manager.h"
 #include "memory-manager.h"
+#include "osn-media-state.hpp"
+#include "osn-properties.hpp"
+#include "osn-source-types.hpp"
 
 void osn::Source::initialize_global_signals()
 {
@@ -73,6 +77,7 @@ void osn::Source::global_source_create_cb(void* ptr, calldata_t* cd)
 	osn::Source::Manager::GetInstance().allocate(source);
 	osn::Source::attach_source_signals(source);
 	CallbackManager::addSource(source);
+	osn::MediaState::Track(source);
 	MemoryManager::GetInstance().registerSource(source);
 }
 
@@ -102,6 +107,7 @@ void osn::Source::global_source_destroy_cb(void* ptr, calldata_t* cd)
 	}
 
 	CallbackManager::removeSource(source);
+	osn::MediaState::Untrack(source);
 	detach_source_signals(source);
 	osn::Source::Manager::GetInstance().free(source);
 	MemoryManager::GetInstance().unregisterSource(source);
@@ -112,6 +118,7 @@ void osn::Source::Register(ipc::server& srv)
 	std::shared_ptr<ipc::collection> cls = std::make_shared<ipc::collection>("Source");
 	cls->register_function(
 	    std::make_shared<ipc::function>("GetDefaults", std::vector<ipc::type>{ipc::type::String}, GetTypeDefaults));
+	cls->register_function(std::make_shared<ipc::function>("GetTypes", std::vector<ipc::type>{}, GetTypes));
 
 	cls->register_function(
 	    std::make_shared<ipc::function>("Remove", std::vector<ipc::type>{ipc::type::UInt64}, Remove));
@@ -191,7 +198,21 @@ void osn::Source::Register(ipc::server& srv)
 	                           ipc::type::Int32},
 		SendKeyClick));
 
-	srv.register_collection(cls);
+	osn::Dispatch::Register(srv, cls);
+}
+
+void osn::Source::GetTypes(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	auto catalog = osn::SourceTypes::Get();
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(obs::serialize_list(catalog->entries)));
+	rval.push_back(ipc::value(catalog->strings));
+	AUTO_DEBUG;
 }
 
 void osn::Source::GetTypeDefaults(
@@ -228,6 +249,7 @@ void osn::Source::Remove(
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not valid.");
 	}
 
+	osn::Properties::CloseSessions(src);
 	obs_source_remove(src);
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
@@ -246,6 +268,7 @@ void osn::Source::Release(
 		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not valid.");
 	}
 
+	osn::Properties::CloseSessions(src);
 	obs_source_release(src);
 
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
@@ -304,6 +327,68 @@ void osn::Source::ProcessProperties(
 	obs_data*                   settings,
 	bool&                       updateSource,
 	std::vector<ipc::value>&    rval)
+{
+	std::vector<std::shared_ptr<obs::Property>> props;
+	ProcessProperties(prp, settings, updateSource, props);
+
+	for (auto& prop : props) {
+		std::vector<char> buf(prop->size());
+		if (prop->serialize(buf)) {
+			rval.push_back(ipc::value(buf));
+		}
+	}
+}
+
+static inline void hash_bytes(uint64_t& hash, const void* data, size_t size)
+{
+	// FNV-1a
+	const uint8_t* bytes = reinterpret_cast<const uint8_t*>(data);
+	for (size_t idx = 0; idx < size; idx++) {
+		hash ^= bytes[idx];
+		hash *= 1099511628211ull;
+	}
+}
+
+void osn::Source::ReadListItems(obs_property_t* p, obs::ListProperty& list)
+{
+	const char* buf   = nullptr;
+	size_t      items = obs_property_list_item_count(p);
+	uint64_t    hash  = 14695981039346656037ull;
+
+	list.items.clear();
+	for (size_t idx = 0; idx < items; ++idx) {
+		obs::ListProperty::Item entry;
+		entry.name    = (buf = obs_property_list_item_name(p, idx)) != nullptr ? buf : "";
+		entry.enabled = !obs_property_list_item_disabled(p, idx);
+		hash_bytes(hash, entry.name.data(), entry.name.size() + 1);
+		hash_bytes(hash, &entry.enabled, sizeof(entry.enabled));
+		switch (list.format) {
+		case obs::ListProperty::Format::Integer:
+			entry.value_int = obs_property_list_item_int(p, idx);
+			hash_bytes(hash, &entry.value_int, sizeof(entry.value_int));
+			break;
+		case obs::ListProperty::Format::Float:
+			entry.value_float = obs_property_list_item_float(p, idx);
+			hash_bytes(hash, &entry.value_float, sizeof(entry.value_float));
+			break;
+		case obs::ListProperty::Format::String:
+			entry.value_string = (buf = obs_property_list_item_string(p, idx)) != nullptr ? buf : "";
+			hash_bytes(hash, entry.value_string.data(), entry.value_string.size() + 1);
+			break;
+		}
+		list.items.push_back(std::move(entry));
+	}
+
+	list.item_count = items;
+	list.items_hash = hash;
+}
+
+void osn::Source::ProcessProperties(
+	obs_properties_t*                            prp,
+	obs_data*                                    settings,
+	bool&                                        updateSource,
+	std::vector<std::shared_ptr<obs::Property>>& props,
+	size_t                                       defer_items_above)
 {
 	const char* buf = nullptr;
 	for (obs_property_t* p = obs_properties_first(prp); (p != nullptr); obs_property_next(&p)) {
@@ -357,24 +442,7 @@ void osn::Source::ProcessProperties(
 			auto prop2        = std::make_shared<obs::ListProperty>();
 			prop2->field_type = obs::ListProperty::ListType(obs_property_list_type(p));
 			prop2->format     = obs::ListProperty::Format(obs_property_list_format(p));
-			size_t items      = obs_property_list_item_count(p);
-			for (size_t idx = 0; idx < items; ++idx) {
-				obs::ListProperty::Item entry;
-				entry.name    = (buf = obs_property_list_item_name(p, idx)) != nullptr ? buf : "";
-				entry.enabled = !obs_property_list_item_disabled(p, idx);
-				switch (prop2->format) {
-				case obs::ListProperty::Format::Integer:
-					entry.value_int = obs_property_list_item_int(p, idx);
-					break;
-				case obs::ListProperty::Format::Float:
-					entry.value_float = obs_property_list_item_float(p, idx);
-					break;
-				case obs::ListProperty::Format::String:
-					entry.value_string = (buf = obs_property_list_item_string(p, idx)) != nullptr ? buf : "";
-					break;
-				}
-				prop2->items.push_back(std::move(entry));
-			}
+			ReadListItems(p, *prop2);
 			switch (prop2->format) {
 			case obs::ListProperty::Format::Integer: {
 				prop2->current_value_int = (int)obs_data_get_int(settings, name);
@@ -394,6 +462,20 @@ void osn::Source::ProcessProperties(
 				break;
 			}
 			}
+			if (prop2->items.size() > defer_items_above) {
+				prop2->items.remove_if([&prop2](const obs::ListProperty::Item& item) {
+					switch (prop2->format) {
+					case obs::ListProperty::Format::Integer:
+						return item.value_int != prop2->current_value_int;
+					case obs::ListProperty::Format::Float:
+						return item.value_float != prop2->current_value_float;
+					case obs::ListProperty::Format::String:
+						return item.value_string != prop2->current_value_str;
+					}
+					return true;
+				});
+				prop2->items_deferred = true;
+			}
 			prop = prop2;
 			break;
 		}
@@ -482,7 +564,7 @@ void osn::Source::ProcessProperties(
 		}
 		case OBS_PROPERTY_GROUP: {
 			auto grp = obs_property_group_content(p);
-			ProcessProperties(grp, settings, updateSource, rval);
+			ProcessProperties(grp, settings, updateSource, props, defer_items_above);
 			prop = nullptr;
 			break;
 		}
@@ -498,10 +580,7 @@ void osn::Source::ProcessProperties(
 		prop->enabled          = obs_property_enabled(p);
 		prop->visible          = obs_property_visible(p);
 
-		std::vector<char> buf(prop->size());
-		if (prop->serialize(buf)) {
-			rval.push_back(ipc::value(buf));
-		}
+		props.push_back(prop);
 	}
 }
 
@@ -18,11 +18,18 @@
 
 #pragma once
 #include <ipc-server.hpp>
+#include <memory>
 #include <obs.h>
 #include "utility.hpp"
 #undef strtoll
 #include "nlohmann/json.hpp"
 
+namespace obs
+{
+	struct Property;
+	struct ListProperty;
+}
+
 namespace osn
 {
 	class Source
@@ -58,6 +65,11 @@ namespace osn
 		static void Register(ipc::server&);
 
 		// Type Info
+		static void GetTypes(
+		    void*                          data,
+		    const int64_t                  id,
+		    const std::vector<ipc::value>& args,
+		    std::vector<ipc::value>&       rval);
 		static void GetTypeDefaults(
 		    void*                          data,
 		    const int64_t                  id,
@@ -91,6 +103,17 @@ namespace osn
 		    obs_data*                      settings,
 		    bool&                          updateSource,
 		    std::vector<ipc::value>&       rval);
+		// Same walk as above, keeping the properties instead of serializing them.
+		// Lists with more than `defer_items_above` items only keep the selected
+		// one, see obs::ListProperty::items_deferred.
+		static void ProcessProperties(
+		    obs_properties_t*                            prp,
+		    obs_data*                                    settings,
+		    bool&                                        updateSource,
+		    std::vector<std::shared_ptr<obs::Property>>& props,
+		    size_t                                       defer_items_above = SIZE_MAX);
+		// Fills items, item_count and items_hash of `list` from a list property.
+		static void ReadListItems(obs_property_t* p, obs::ListProperty& list);
 		static void GetSettings(
 		    void*                          data,
 		    const int64_t                  id,
@@ -0,0 +1,309 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-spatial-index.hpp"
+#include <algorithm>
+#include <cmath>
+#include <map>
+#include <graphics/matrix4.h>
+
+// Cells per axis, the grid is sized so that a cell holds about one item.
+static const size_t max_cells = 64;
+
+static std::mutex                                                 registry_mtx;
+static std::map<obs_source_t*, std::shared_ptr<osn::SpatialIndex>> registry;
+
+static bool Overlaps(osn::SpatialIndex::Rect const& a, osn::SpatialIndex::Rect const& b)
+{
+	return a.left <= b.right && b.left <= a.right && a.top <= b.bottom && b.top <= a.bottom;
+}
+
+// Item boxes are parallelograms, checks their projections on both edge
+// normals once the bounding boxes are known to overlap.
+static bool Overlaps(const vec2 (&corners)[4], osn::SpatialIndex::Rect const& rect)
+{
+	const vec2 points[4] = {{rect.left, rect.top}, {rect.right, rect.top}, {rect.right, rect.bottom}, {rect.left, rect.bottom}};
+
+	for (size_t edge = 0; edge < 2; edge++) {
+		vec2 normal;
+		normal.x = corners[edge].y - corners[edge + 1].y;
+		normal.y = corners[edge + 1].x - corners[edge].x;
+
+		float box_min = INFINITY, box_max = -INFINITY, rect_min = INFINITY, rect_max = -INFINITY;
+		for (size_t idx = 0; idx < 4; idx++) {
+			float box_proj  = corners[idx].x * normal.x + corners[idx].y * normal.y;
+			float rect_proj = points[idx].x * normal.x + points[idx].y * normal.y;
+			box_min         = std::min(box_min, box_proj);
+			box_max         = std::max(box_max, box_proj);
+			rect_min        = std::min(rect_min, rect_proj);
+			rect_max        = std::max(rect_max, rect_proj);
+		}
+		if (box_max < rect_min || rect_max < box_min)
+			return false;
+	}
+	return true;
+}
+
+static bool Contains(const vec2 (&corners)[4], float x, float y)
+{
+	// Solves point = c0 + a * (c1 - c0) + b * (c3 - c0), the point is
+	// inside when both a and b are in [0, 1].
+	float ux = corners[1].x - corners[0].x, uy = corners[1].y - corners[0].y;
+	float vx = corners[3].x - corners[0].x, vy = corners[3].y - corners[0].y;
+	float px = x - corners[0].x, py = y - corners[0].y;
+
+	float det = ux * vy - uy * vx;
+	if (det == 0.0f)
+		return false;
+
+	float a = (px * vy - py * vx) / det;
+	float b = (ux * py - uy * px) / det;
+	return a >= 0.0f && a <= 1.0f && b >= 0.0f && b <= 1.0f;
+}
+
+std::shared_ptr<osn::SpatialIndex> osn::SpatialIndex::Get(obs_source_t* source)
+{
+	std::unique_lock<std::mutex> lock(registry_mtx);
+	auto                         found = registry.find(source);
+	if (found != registry.end())
+		return found->second;
+
+	std::shared_ptr<SpatialIndex> index(new SpatialIndex(source));
+	registry.emplace(source, index);
+	return index;
+}
+
+osn::SpatialIndex::SpatialIndex(obs_source_t* source) : source(source)
+{
+	// Everything that moves, hides or reorders an item invalidates the index.
+	// Transforms are signaled once the render thread applied them.
+	signal_handler_t* sh = obs_source_get_signal_handler(source);
+	for (const char* signal : {"item_add", "item_remove", "item_visible", "item_transform", "reorder", "refresh"})
+		signal_handler_connect(sh, signal, on_change, this);
+	signal_handler_connect(sh, "destroy", on_destroy, this);
+}
+
+void osn::SpatialIndex::on_change(void* data, calldata_t*)
+{
+	static_cast<SpatialIndex*>(data)->dirty = true;
+}
+
+void osn::SpatialIndex::on_destroy(void* data, calldata_t*)
+{
+	std::unique_lock<std::mutex> lock(registry_mtx);
+	registry.erase(static_cast<SpatialIndex*>(data)->source);
+}
+
+void osn::SpatialIndex::rebuild()
+{
+	// Cleared first, a change signaled while enumerating marks it again.
+	dirty = false;
+	entries.clear();
+
+	auto cb = [](obs_scene_t*, obs_sceneitem_t* item, void* data) {
+		if (!obs_sceneitem_visible(item))
+			return true;
+
+		matrix4 transform;
+		obs_sceneitem_get_box_transform(item, &transform);
+
+		Entry entry;
+		entry.item = item;
+		entry.box  = {INFINITY, INFINITY, -INFINITY, -INFINITY};
+
+		const float unit[4][2] = {{0.0f, 0.0f}, {1.0f, 0.0f}, {1.0f, 1.0f}, {0.0f, 1.0f}};
+		for (size_t idx = 0; idx < 4; idx++) {
+			vec3 pos;
+			vec3_set(&pos, unit[idx][0], unit[idx][1], 0.0f);
+			vec3_transform(&pos, &pos, &transform);
+			vec2_set(&entry.corners[idx], pos.x, pos.y);
+
+			entry.box.left   = std::min(entry.box.left, pos.x);
+			entry.box.top    = std::min(entry.box.top, pos.y);
+			entry.box.right  = std::max(entry.box.right, pos.x);
+			entry.box.bottom = std::max(entry.box.bottom, pos.y);
+		}
+
+		static_cast<std::vector<Entry>*>(data)->push_back(entry);
+		return true;
+	};
+	obs_scene_enum_items(obs_scene_from_source(source), cb, &entries);
+
+	bounds = {INFINITY, INFINITY, -INFINITY, -INFINITY};
+	for (auto& entry : entries) {
+		bounds.left   = std::min(bounds.left, entry.box.left);
+		bounds.top    = std::min(bounds.top, entry.box.top);
+		bounds.right  = std::max(bounds.right, entry.box.right);
+		bounds.bottom = std::max(bounds.bottom, entry.box.bottom);
+	}
+
+	size_t side = size_t(std::ceil(std::sqrt(double(entries.size()))));
+	columns     = rows = std::min(std::max(side, size_t(1)), max_cells);
+	cell_w      = entries.empty() ? 1.0f : std::max((bounds.right - bounds.left) / columns, 1.0f);
+	cell_h      = entries.empty() ? 1.0f : std::max((bounds.bottom - bounds.top) / rows, 1.0f);
+	cells.assign(columns * rows, {});
+
+	edges_x.clear();
+	edges_y.clear();
+	for (uint32_t idx = 0; idx < entries.size(); idx++) {
+		Rect const& box = entries[idx].box;
+
+		size_t x0, y0, x1, y1;
+		cell_range(box, x0, y0, x1, y1);
+		for (size_t y = y0; y <= y1; y++) {
+			for (size_t x = x0; x <= x1; x++)
+				cells[y * columns + x].push_back(idx);
+		}
+
+		edges_x.push_back({box.left, idx});
+		edges_x.push_back({box.right, idx});
+		edges_y.push_back({box.top, idx});
+		edges_y.push_back({box.bottom, idx});
+	}
+
+	auto by_position = [](Edge const& a, Edge const& b) { return a.position < b.position; };
+	std::sort(edges_x.begin(), edges_x.end(), by_position);
+	std::sort(edges_y.begin(), edges_y.end(), by_position);
+
+	marks.assign(entries.size(), 0);
+	query = 0;
+}
+
+void osn::SpatialIndex::cell_range(Rect const& rect, size_t& x0, size_t& y0, size_t& x1, size_t& y1) const
+{
+	auto clamp = [](float value, size_t count) {
+		return size_t(std::min(std::max(value, 0.0f), float(count - 1)));
+	};
+	x0 = clamp((rect.left - bounds.left) / cell_w, columns);
+	y0 = clamp((rect.top - bounds.top) / cell_h, rows);
+	x1 = clamp((rect.right - bounds.left) / cell_w, columns);
+	y1 = clamp((rect.bottom - bounds.top) / cell_h, rows);
+}
+
+template<typename F>
+void osn::SpatialIndex::visit(Rect const& rect, F&& callback)
+{
+	if (dirty)
+		rebuild();
+	if (entries.empty() || !Overlaps(rect, bounds))
+		return;
+
+	if (++query == 0) {
+		std::fill(marks.begin(), marks.end(), 0);
+		query = 1;
+	}
+
+	size_t x0, y0, x1, y1;
+	cell_range(rect, x0, y0, x1, y1);
+	for (size_t y = y0; y <= y1; y++) {
+		for (size_t x = x0; x <= x1; x++) {
+			for (uint32_t idx : cells[y * columns + x]) {
+				if (marks[idx] == query)
+					continue;
+				marks[idx] = query;
+				if (Overlaps(entries[idx].box, rect))
+					callback(idx);
+			}
+		}
+	}
+}
+
+obs_sceneitem_t* osn::SpatialIndex::HitTest(float x, float y)
+{
+	std::unique_lock<std::mutex> lock(mtx);
+
+	// Items are enumerated bottom to top, the highest index is on top.
+	int64_t top = -1;
+	visit(Rect{x, y, x, y}, [&](uint32_t idx) {
+		if (int64_t(idx) > top && Contains(entries[idx].corners, x, y))
+			top = idx;
+	});
+	return top < 0 ? nullptr : entries[top].item;
+}
+
+std::vector<obs_sceneitem_t*> osn::SpatialIndex::Select(Rect const& rect)
+{
+	std::unique_lock<std::mutex> lock(mtx);
+
+	std::vector<uint32_t> found;
+	visit(rect, [&](uint32_t idx) {
+		if (Overlaps(entries[idx].corners, rect))
+			found.push_back(idx);
+	});
+	std::sort(found.begin(), found.end());
+
+	std::vector<obs_sceneitem_t*> items;
+	items.reserve(found.size());
+	for (uint32_t idx : found)
+		items.push_back(entries[idx].item);
+	return items;
+}
+
+vec2 osn::SpatialIndex::Snap(Rect const& rect, obs_sceneitem_t* exclude, float threshold)
+{
+	std::unique_lock<std::mutex> lock(mtx);
+	if (dirty)
+		rebuild();
+
+	obs_video_info ovi = {};
+	obs_get_video_info(&ovi);
+
+	// Closest edge on each side of the position in a sorted list, skipping
+	// the edges of the excluded item.
+	auto nearest = [&](std::vector<Edge> const& edges, float position, float& best) {
+		auto start = std::lower_bound(
+		    edges.begin(), edges.end(), position, [](Edge const& edge, float value) { return edge.position < value; });
+		for (auto it = start; it != edges.end(); ++it) {
+			if (entries[it->entry].item == exclude)
+				continue;
+			if (it->position - position < std::fabs(best))
+				best = it->position - position;
+			break;
+		}
+		for (auto it = start; it != edges.begin();) {
+			--it;
+			if (entries[it->entry].item == exclude)
+				continue;
+			if (position - it->position < std::fabs(best))
+				best = it->position - position;
+			break;
+		}
+	};
+
+	auto snap_axis = [&](std::vector<Edge> const& edges, float low, float high, float canvas) {
+		float best = threshold + 1.0f;
+		for (float target : {0.0f, canvas}) {
+			for (float position : {low, high}) {
+				if (std::fabs(target - position) < std::fabs(best))
+					best = target - position;
+			}
+		}
+		float center = (canvas - (low + high)) / 2.0f;
+		if (std::fabs(center) < std::fabs(best))
+			best = center;
+
+		nearest(edges, low, best);
+		nearest(edges, high, best);
+		return std::fabs(best) <= threshold ? best : 0.0f;
+	};
+
+	vec2 offset;
+	offset.x = snap_axis(edges_x, rect.left, rect.right, float(ovi.base_width));
+	offset.y = snap_axis(edges_y, rect.top, rect.bottom, float(ovi.base_height));
+	return offset;
+}
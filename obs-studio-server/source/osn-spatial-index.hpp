@@ -0,0 +1,101 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <graphics/vec2.h>
+#include <obs.h>
+#include <vector>
+
+namespace osn
+{
+	// Bounding boxes of the items of one scene, so that hit tests, rubber
+	// band selection and snapping do not have to transform every item on
+	// each mouse event. Items are bucketed in a uniform grid and their edges
+	// are kept sorted for snapping. The index listens to the scene signals
+	// and is only rebuilt by the next query after an item changed.
+	class SpatialIndex
+	{
+		public:
+		struct Rect
+		{
+			float left   = 0;
+			float top    = 0;
+			float right  = 0;
+			float bottom = 0;
+		};
+
+		// Returns the index of a scene, creating it on first use. The index
+		// is dropped when the scene is destroyed.
+		static std::shared_ptr<SpatialIndex> Get(obs_source_t* source);
+
+		// Topmost visible item under the point, if any.
+		obs_sceneitem_t* HitTest(float x, float y);
+		// Visible items overlapping the rectangle, bottom to top.
+		std::vector<obs_sceneitem_t*> Select(Rect const& rect);
+		// Offset moving `rect` onto the nearest item or canvas edge within
+		// `threshold`, per axis. `exclude` is usually the dragged item.
+		vec2 Snap(Rect const& rect, obs_sceneitem_t* exclude, float threshold);
+
+		private:
+		struct Entry
+		{
+			obs_sceneitem_t* item = nullptr;
+			// Corners of the item box in canvas space, clockwise from the
+			// top left corner of the source.
+			vec2 corners[4];
+			Rect box;
+		};
+
+		struct Edge
+		{
+			float    position;
+			uint32_t entry;
+		};
+
+		SpatialIndex(obs_source_t* source);
+
+		void rebuild();
+		void cell_range(Rect const& rect, size_t& x0, size_t& y0, size_t& x1, size_t& y1) const;
+		template<typename F>
+		void visit(Rect const& rect, F&& callback);
+
+		static void on_change(void* data, calldata_t* cd);
+		static void on_destroy(void* data, calldata_t* cd);
+
+		obs_source_t*     source;
+		std::atomic<bool> dirty{true};
+		std::mutex        mtx;
+
+		std::vector<Entry>                 entries;
+		Rect                               bounds;
+		size_t                             columns = 0;
+		size_t                             rows    = 0;
+		float                              cell_w  = 1;
+		float                              cell_h  = 1;
+		std::vector<std::vector<uint32_t>> cells;
+		std::vector<Edge>                  edges_x;
+		std::vector<Edge>                  edges_y;
+
+		// Entries spanning several cells are reported once per query.
+		std::vector<uint32_t> marks;
+		uint32_t              query = 0;
+	};
+} // namespace osn
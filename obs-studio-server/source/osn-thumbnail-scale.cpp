@@ -0,0 +1,203 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-thumbnail-scale.hpp"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OSN_THUMBNAIL_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define OSN_THUMBNAIL_NEON
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+	// Adds the pixels [begin, end) of a row to the four channel sums of one
+	// destination pixel.
+	inline void accumulate(const uint8_t* row, uint32_t begin, uint32_t end, uint32_t* sum)
+	{
+#if defined(OSN_THUMBNAIL_SSE2)
+		const __m128i zero  = _mm_setzero_si128();
+		__m128i       total = _mm_loadu_si128(reinterpret_cast<const __m128i*>(sum));
+		__m128i       pairs = _mm_setzero_si128();
+		uint32_t      x     = begin;
+		// Two pixels per step, summed in 16 bit lanes which are widened
+		// every 128 steps, before they could overflow.
+		while (x + 2 <= end) {
+			uint32_t stop = std::min(end - (end - x) % 2, x + 2 * 128);
+			for (; x < stop; x += 2) {
+				__m128i px = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(row + size_t(x) * 4));
+				pairs      = _mm_add_epi16(pairs, _mm_unpacklo_epi8(px, zero));
+			}
+			pairs = _mm_add_epi16(pairs, _mm_srli_si128(pairs, 8));
+			total = _mm_add_epi32(total, _mm_unpacklo_epi16(pairs, zero));
+			pairs = _mm_setzero_si128();
+		}
+		if (x < end) {
+			int32_t value;
+			std::memcpy(&value, row + size_t(x) * 4, 4);
+			__m128i px = _mm_cvtsi32_si128(value);
+			total      = _mm_add_epi32(total, _mm_unpacklo_epi16(_mm_unpacklo_epi8(px, zero), zero));
+		}
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(sum), total);
+#elif defined(OSN_THUMBNAIL_NEON)
+		uint32x4_t total = vld1q_u32(sum);
+		uint32_t   x     = begin;
+		while (x + 2 <= end) {
+			uint16x8_t pairs = vdupq_n_u16(0);
+			uint32_t   stop  = std::min(end - (end - x) % 2, x + 2 * 128);
+			for (; x < stop; x += 2)
+				pairs = vaddw_u8(pairs, vld1_u8(row + size_t(x) * 4));
+			total = vaddq_u32(total, vaddl_u16(vget_low_u16(pairs), vget_high_u16(pairs)));
+		}
+		if (x < end) {
+			const uint8_t* px       = row + size_t(x) * 4;
+			uint32_t       value[4] = {px[0], px[1], px[2], px[3]};
+			total = vaddq_u32(total, vld1q_u32(value));
+		}
+		vst1q_u32(sum, total);
+#else
+		for (uint32_t x = begin; x < end; x++) {
+			const uint8_t* px = row + size_t(x) * 4;
+			sum[0] += px[0];
+			sum[1] += px[1];
+			sum[2] += px[2];
+			sum[3] += px[3];
+		}
+#endif
+	}
+
+	// Writes the rounded average of one destination pixel.
+	inline void average(const uint32_t* sum, uint32_t count, uint8_t* out)
+	{
+#if defined(OSN_THUMBNAIL_SSE2)
+		__m128 scaled = _mm_mul_ps(
+		    _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(sum))), _mm_set1_ps(1.0f / count));
+		__m128i value = _mm_cvtps_epi32(scaled);
+		value         = _mm_packs_epi32(value, value);
+		value         = _mm_packus_epi16(value, value);
+		int32_t packed = _mm_cvtsi128_si32(value);
+		std::memcpy(out, &packed, 4);
+#elif defined(OSN_THUMBNAIL_NEON) && defined(__aarch64__)
+		float32x4_t scaled = vmulq_n_f32(vcvtq_f32_u32(vld1q_u32(sum)), 1.0f / count);
+		uint16x4_t  value  = vqmovn_u32(vcvtnq_u32_f32(scaled));
+		uint8x8_t   bytes  = vqmovn_u16(vcombine_u16(value, value));
+		vst1_lane_u32(reinterpret_cast<uint32_t*>(out), vreinterpret_u32_u8(bytes), 0);
+#else
+		for (size_t ch = 0; ch < 4; ch++)
+			out[ch] = uint8_t((sum[ch] + count / 2) / count);
+#endif
+	}
+} // namespace
+
+void osn::ThumbnailScaler::FitSize(
+    uint32_t  width,
+    uint32_t  height,
+    uint32_t  max_width,
+    uint32_t  max_height,
+    uint32_t& out_width,
+    uint32_t& out_height)
+{
+	out_width  = width;
+	out_height = height;
+	if (!width || !height)
+		return;
+
+	if (max_width && out_width > max_width) {
+		out_height = std::max<uint32_t>(1, uint32_t(uint64_t(out_height) * max_width / out_width));
+		out_width  = max_width;
+	}
+	if (max_height && out_height > max_height) {
+		out_width  = std::max<uint32_t>(1, uint32_t(uint64_t(out_width) * max_height / out_height));
+		out_height = max_height;
+	}
+}
+
+void osn::ThumbnailScaler::Downscale(
+    const uint8_t* src,
+    uint32_t       src_width,
+    uint32_t       src_height,
+    uint32_t       src_stride,
+    uint8_t*       dst,
+    uint32_t       dst_width,
+    uint32_t       dst_height,
+    uint32_t       dst_stride,
+    uint32_t       row_begin,
+    uint32_t       row_end)
+{
+	if (!dst_width || !dst_height || dst_width > src_width || dst_height > src_height)
+		return;
+
+	// Source column span of every destination column.
+	std::vector<uint32_t> columns(dst_width + 1);
+	for (uint32_t x = 0; x <= dst_width; x++)
+		columns[x] = uint32_t(uint64_t(x) * src_width / dst_width);
+
+	std::vector<uint32_t> sums(size_t(dst_width) * 4);
+	row_end = std::min(row_end, dst_height);
+	for (uint32_t y = row_begin; y < row_end; y++) {
+		uint32_t top    = uint32_t(uint64_t(y) * src_height / dst_height);
+		uint32_t bottom = uint32_t(uint64_t(y + 1) * src_height / dst_height);
+
+		std::fill(sums.begin(), sums.end(), 0);
+		for (uint32_t row = top; row < bottom; row++) {
+			const uint8_t* line = src + size_t(row) * src_stride;
+			for (uint32_t x = 0; x < dst_width; x++)
+				accumulate(line, columns[x], columns[x + 1], &sums[size_t(x) * 4]);
+		}
+
+		uint8_t* out = dst + size_t(y) * dst_stride;
+		for (uint32_t x = 0; x < dst_width; x++) {
+			uint32_t count = (columns[x + 1] - columns[x]) * (bottom - top);
+			average(&sums[size_t(x) * 4], count, out + size_t(x) * 4);
+		}
+	}
+}
+
+void osn::ThumbnailScaler::Downscale(const ThumbnailImage& src, ThumbnailImage& dst, uint32_t width, uint32_t height)
+{
+	dst.width  = width;
+	dst.height = height;
+	dst.stride = width * 4;
+	dst.pixels.resize(size_t(dst.stride) * height);
+	Downscale(
+	    src.pixels.data(),
+	    src.width,
+	    src.height,
+	    src.stride,
+	    dst.pixels.data(),
+	    dst.width,
+	    dst.height,
+	    dst.stride,
+	    0,
+	    dst.height);
+}
+
+const char* osn::ThumbnailScaler::Kernel()
+{
+#if defined(OSN_THUMBNAIL_SSE2)
+	return "sse2";
+#elif defined(OSN_THUMBNAIL_NEON) && defined(__aarch64__)
+	return "neon";
+#else
+	return "scalar";
+#endif
+}
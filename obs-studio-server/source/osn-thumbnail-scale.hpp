@@ -0,0 +1,67 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <inttypes.h>
+#include <vector>
+
+namespace osn
+{
+	// A BGRA image, 4 bytes per pixel, rows `stride` bytes apart.
+	struct ThumbnailImage
+	{
+		uint32_t             width  = 0;
+		uint32_t             height = 0;
+		uint32_t             stride = 0;
+		std::vector<uint8_t> pixels;
+	};
+
+	// Box filter downscaling of BGRA images for window thumbnails. Every
+	// destination pixel is the rounded average of the source pixels it
+	// covers. Uses SSE2 or NEON when the target has them, plain C++
+	// otherwise. Has no libobs dependency so it can be benchmarked alone.
+	class ThumbnailScaler
+	{
+		public:
+		// Size that fits `width`x`height` into `max_width`x`max_height`
+		// keeping the aspect ratio, never upscaling. A zero limit leaves that
+		// side unconstrained.
+		static void
+		    FitSize(uint32_t width, uint32_t height, uint32_t max_width, uint32_t max_height, uint32_t& out_width, uint32_t& out_height);
+
+		// Scales `src` down into `dst`, which must not be larger than `src`
+		// on either side. Rows [row_begin, row_end) of `dst` are written, so
+		// bands of one image can be scaled on separate threads.
+		static void Downscale(
+		    const uint8_t* src,
+		    uint32_t       src_width,
+		    uint32_t       src_height,
+		    uint32_t       src_stride,
+		    uint8_t*       dst,
+		    uint32_t       dst_width,
+		    uint32_t       dst_height,
+		    uint32_t       dst_stride,
+		    uint32_t       row_begin,
+		    uint32_t       row_end);
+
+		static void Downscale(const ThumbnailImage& src, ThumbnailImage& dst, uint32_t width, uint32_t height);
+
+		// Name of the vector path compiled in, "sse2", "neon" or "scalar".
+		static const char* Kernel();
+	};
+} // namespace osn
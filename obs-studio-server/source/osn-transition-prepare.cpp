@@ -0,0 +1,237 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-transition-prepare.hpp"
+#include <atomic>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <util/platform.h>
+#include "osn-source.hpp"
+
+namespace
+{
+	// A prepared target that is not started within this time after being
+	// reported stops being shown again.
+	const uint64_t hold_ns = 10000000000;
+
+	// A source shown by a preparation, and whether it has a frame yet.
+	struct Watch
+	{
+		obs_source_t* source = nullptr;
+		bool          async  = false;
+		// Set by the first asynchronous frame, or right away for sources
+		// that were already showing a frame before the preparation.
+		std::atomic<bool> framed{false};
+		// Frames rendered before the source was shown.
+		uint64_t shown_at = 0;
+	};
+
+	struct Preparation
+	{
+		uint64_t                            transition_uid = UINT64_MAX;
+		uint64_t                            target_uid     = UINT64_MAX;
+		obs_weak_source_t*                  weak           = nullptr;
+		std::vector<std::unique_ptr<Watch>> shown;
+		uint64_t                            deadline    = 0;
+		uint64_t                            resolved_at = 0;
+	};
+
+	std::mutex                            prepared_mtx;
+	std::map<obs_source_t*, Preparation>  prepared;
+	std::vector<obs::TransitionReadiness> cancelled;
+	// Whether on_render is registered, only while something is prepared.
+	bool                                  render_hooked = false;
+	std::atomic<uint64_t>                 rendered_frames{0};
+
+	void on_render(void*, uint32_t, uint32_t)
+	{
+		rendered_frames++;
+	}
+
+	void on_frame(void* param, obs_source_t*, const obs_source_frame*)
+	{
+		static_cast<Watch*>(param)->framed = true;
+	}
+
+	void collect_source(obs_source_t*, obs_source_t* child, void* param)
+	{
+		static_cast<std::vector<obs_source_t*>*>(param)->push_back(child);
+	}
+
+	// Scenes only compose their children and audio sources have nothing to
+	// render, everything else has to produce a frame.
+	bool needs_frame(obs_source_t* source)
+	{
+		return obs_source_get_type(source) != OBS_SOURCE_TYPE_SCENE
+		       && (obs_source_get_output_flags(source) & OBS_SOURCE_VIDEO) != 0;
+	}
+
+	// Synchronous sources render on demand, they have a frame once a frame
+	// was rendered after they were shown. The frame in flight when they were
+	// shown may have been composed without them, hence the second one.
+	bool has_frame(Watch const& watch)
+	{
+		return watch.framed || (!watch.async && rendered_frames >= watch.shown_at + 2);
+	}
+
+	void unshow(Preparation& preparation)
+	{
+		for (auto& watch : preparation.shown) {
+			// Once removed, the callback is not running and the watch can go.
+			if (watch->async)
+				obs_source_remove_frame_callback(watch->source, on_frame, watch.get());
+			obs_source_dec_showing(watch->source);
+			obs_source_release(watch->source);
+		}
+		preparation.shown.clear();
+		obs_weak_source_release(preparation.weak);
+		preparation.weak = nullptr;
+	}
+
+	obs::TransitionReadiness cancellation(const Preparation& preparation)
+	{
+		obs::TransitionReadiness readiness;
+		readiness.transition = preparation.transition_uid;
+		readiness.target     = preparation.target_uid;
+		readiness.state      = obs::TransitionReadiness::Cancelled;
+		return readiness;
+	}
+} // namespace
+
+void osn::TransitionPrepare::Prepare(obs_source_t* transition, obs_source_t* target, uint32_t timeout_ms)
+{
+	Preparation preparation;
+	preparation.transition_uid = osn::Source::Manager::GetInstance().find(transition);
+	preparation.target_uid     = osn::Source::Manager::GetInstance().find(target);
+	preparation.weak           = obs_source_get_weak_source(transition);
+	preparation.deadline       = os_gettime_ns() + uint64_t(timeout_ms) * 1000000;
+
+	std::vector<obs_source_t*> sources{target};
+	obs_source_enum_active_tree(target, collect_source, &sources);
+	for (obs_source_t* source : sources) {
+		std::unique_ptr<Watch> watch(new Watch);
+		watch->source = source;
+		watch->async  = (obs_source_get_output_flags(source) & OBS_SOURCE_ASYNC) != 0;
+		watch->framed = obs_source_showing(source) && obs_source_get_width(source) > 0;
+
+		obs_source_addref(source);
+		if (watch->async)
+			obs_source_add_frame_callback(source, on_frame, watch.get());
+		obs_source_inc_showing(source);
+		watch->shown_at = rendered_frames;
+		preparation.shown.push_back(std::move(watch));
+	}
+
+	Preparation previous;
+	{
+		std::unique_lock<std::mutex> ulock(prepared_mtx);
+		if (!render_hooked) {
+			obs_add_main_render_callback(on_render, nullptr);
+			render_hooked = true;
+		}
+		Preparation& slot = prepared[transition];
+		if (slot.weak) {
+			// Preparing the same target again only restarts the wait.
+			previous = std::move(slot);
+			if (!previous.resolved_at && previous.target_uid != preparation.target_uid)
+				cancelled.push_back(cancellation(previous));
+		}
+		slot = std::move(preparation);
+	}
+
+	// Only after the new target is shown, sources both targets have in
+	// common stay visible throughout.
+	unshow(previous);
+}
+
+void osn::TransitionPrepare::Release(obs_source_t* transition)
+{
+	Preparation preparation;
+	{
+		std::unique_lock<std::mutex> ulock(prepared_mtx);
+		auto                         found = prepared.find(transition);
+		if (found == prepared.end())
+			return;
+		preparation = std::move(found->second);
+		prepared.erase(found);
+
+		// The client still waits for an outcome.
+		if (!preparation.resolved_at)
+			cancelled.push_back(cancellation(preparation));
+	}
+	unshow(preparation);
+}
+
+std::vector<obs::TransitionReadiness> osn::TransitionPrepare::Collect()
+{
+	std::vector<obs::TransitionReadiness> events;
+	std::vector<Preparation>              expired;
+	uint64_t                              now = os_gettime_ns();
+
+	std::unique_lock<std::mutex> ulock(prepared_mtx);
+	events.swap(cancelled);
+	for (auto iter = prepared.begin(); iter != prepared.end();) {
+		Preparation& preparation = iter->second;
+
+		obs_source_t* transition = obs_weak_source_get_source(preparation.weak);
+		obs_source_release(transition);
+		bool held = preparation.resolved_at && now - preparation.resolved_at >= hold_ns;
+		if (!transition || held) {
+			if (!preparation.resolved_at)
+				events.push_back(cancellation(preparation));
+			expired.push_back(std::move(preparation));
+			iter = prepared.erase(iter);
+			continue;
+		}
+
+		if (!preparation.resolved_at) {
+			obs::TransitionReadiness readiness;
+			readiness.transition = preparation.transition_uid;
+			readiness.target     = preparation.target_uid;
+			for (auto& watch : preparation.shown) {
+				if (!needs_frame(watch->source))
+					continue;
+				readiness.total++;
+				if (has_frame(*watch))
+					readiness.ready++;
+			}
+
+			if (readiness.ready == readiness.total)
+				readiness.state = obs::TransitionReadiness::Ready;
+			else if (now >= preparation.deadline)
+				readiness.state = obs::TransitionReadiness::TimedOut;
+
+			if (readiness.state) {
+				preparation.resolved_at = now;
+				events.push_back(readiness);
+			}
+		}
+		++iter;
+	}
+	if (prepared.empty() && render_hooked) {
+		obs_remove_main_render_callback(on_render, nullptr);
+		render_hooked = false;
+	}
+	ulock.unlock();
+
+	for (auto& preparation : expired)
+		unshow(preparation);
+
+	return events;
+}
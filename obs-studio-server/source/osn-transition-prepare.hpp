@@ -0,0 +1,47 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <obs.h>
+#include <vector>
+#include "obs-transition.hpp"
+
+namespace osn
+{
+	// Warms up the sources of a transition's next target before the switch.
+	// Every source below the target is shown in the background, so media,
+	// browser and capture sources have their first frame ready by the time
+	// Transition.Start makes them visible. The outcome is published through
+	// the callback poll.
+	class TransitionPrepare
+	{
+		public:
+		// Replaces an earlier preparation of the same transition, which is
+		// reported as cancelled if it was still waiting for another target.
+		static void Prepare(obs_source_t* transition, obs_source_t* target, uint32_t timeout_ms);
+
+		// Stops showing the prepared sources, a preparation still waiting is
+		// reported as cancelled. Transition.Start calls this after the
+		// transition holds on to the target itself.
+		static void Release(obs_source_t* transition);
+
+		// Preparations that became ready or timed out since the last call.
+		// Also drops resolved preparations that were never started.
+		static std::vector<obs::TransitionReadiness> Collect();
+	};
+} // namespace osn
@@ -21,7 +21,10 @@
 #include <memory>
 #include <obs.h>
 #include "error.hpp"
+#include "osn-dispatch.hpp"
+#include "osn-source-types.hpp"
 #include "osn-source.hpp"
+#include "osn-transition-prepare.hpp"
 #include "shared.hpp"
 
 void osn::Transition::Register(ipc::server& srv)
@@ -49,9 +52,11 @@ void osn::Transition::Register(ipc::server& srv)
 	cls->register_function(std::make_shared<ipc::function>("Clear", std::vector<ipc::type>{ipc::type::UInt64}, Clear));
 	cls->register_function(
 	    std::make_shared<ipc::function>("Set", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64}, Set));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "Prepare", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt64, ipc::type::UInt32}, Prepare));
 	cls->register_function(std::make_shared<ipc::function>(
 	    "Start", std::vector<ipc::type>{ipc::type::UInt64, ipc::type::UInt32, ipc::type::UInt64}, Start));
-	srv.register_collection(cls);
+	osn::Dispatch::Register(srv, cls);
 }
 
 void osn::Transition::Types(
@@ -60,11 +65,11 @@ void osn::Transition::Types(
     const std::vector<ipc::value>& args,
     std::vector<ipc::value>&       rval)
 {
+	auto catalog = osn::SourceTypes::Get();
+
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
-	const char* typeId = nullptr;
-	for (size_t idx = 0; obs_enum_transition_types(idx, &typeId); idx++) {
-		rval.push_back(ipc::value(typeId ? typeId : ""));
-	}
+	for (auto& type : catalog->ids[obs::SourceTypeEntry::Transition])
+		rval.push_back(ipc::value(type));
 	AUTO_DEBUG;
 }
 
@@ -237,6 +242,29 @@ void osn::Transition::Set(
 	AUTO_DEBUG;
 }
 
+void osn::Transition::Prepare(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	// Attempt to find the source asked to load.
+	obs_source_t* transition = osn::Source::Manager::GetInstance().find(args[0].value_union.ui64);
+	if (!transition) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Transition reference is not valid.");
+	}
+
+	obs_source_t* source = osn::Source::Manager::GetInstance().find(args[1].value_union.ui64);
+	if (!source) {
+		PRETTY_ERROR_RETURN(ErrorCode::InvalidReference, "Source reference is not valid.");
+	}
+
+	osn::TransitionPrepare::Prepare(transition, source, args[2].value_union.ui32);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	AUTO_DEBUG;
+}
+
 void osn::Transition::Start(
     void*                          data,
     const int64_t                  id,
@@ -258,6 +286,9 @@ void osn::Transition::Start(
 
 	bool result = obs_transition_start(transition, OBS_TRANSITION_MODE_AUTO, ms, source);
 
+	// The transition shows the target by now, a prepared one can let go.
+	osn::TransitionPrepare::Release(transition);
+
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(result));
 	AUTO_DEBUG;
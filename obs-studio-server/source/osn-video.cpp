@@ -20,6 +20,11 @@
 #include <ipc-server.hpp>
 #include <obs.h>
 #include "error.hpp"
+#include "obs-frame-stats.hpp"
+#include "obs-render-timing.hpp"
+#include "osn-dispatch.hpp"
+#include "osn-frame-stats.hpp"
+#include "osn-render-timing.hpp"
 #include "shared.hpp"
 
 void osn::Video::Register(ipc::server& srv)
@@ -29,7 +34,11 @@ void osn::Video::Register(ipc::server& srv)
 	    "GetSkippedFrames", std::vector<ipc::type>{}, GetSkippedFrames));
 	cls->register_function(
 	    std::make_shared<ipc::function>("GetTotalFrames", std::vector<ipc::type>{}, GetTotalFrames));
-	srv.register_collection(cls);
+	cls->register_function(
+	    std::make_shared<ipc::function>("GetStatsPage", std::vector<ipc::type>{}, GetStatsPage));
+	cls->register_function(std::make_shared<ipc::function>(
+	    "GetRenderTiming", std::vector<ipc::type>{ipc::type::UInt32, ipc::type::UInt32}, GetRenderTiming));
+	osn::Dispatch::Register(srv, cls);
 }
 
 void osn::Video::GetSkippedFrames(
@@ -52,4 +61,39 @@ void osn::Video::GetTotalFrames(
 	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
 	rval.push_back(ipc::value(video_output_get_total_frames(obs_get_video())));
 	AUTO_DEBUG;
-}
\ No newline at end of file
+}
+
+void osn::Video::GetStatsPage(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	std::string name = osn::FrameStats::PageName();
+	if (name.empty()) {
+		PRETTY_ERROR_RETURN(ErrorCode::Error, "Frame stats are not published.");
+	}
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(name));
+	rval.push_back(ipc::value((uint32_t)sizeof(obs::FrameStatsPage)));
+	AUTO_DEBUG;
+}
+
+void osn::Video::GetRenderTiming(
+    void*                          data,
+    const int64_t                  id,
+    const std::vector<ipc::value>& args,
+    std::vector<ipc::value>&       rval)
+{
+	uint32_t seconds = args[0].value_union.ui32;
+	bool     reset   = args[1].value_union.ui32 != 0;
+
+	// A window answers for the last seconds and leaves the reset period alone.
+	obs::RenderTiming timing =
+	    seconds ? osn::RenderTiming::CollectWindow(seconds) : osn::RenderTiming::Collect(reset);
+
+	rval.push_back(ipc::value((uint64_t)ErrorCode::Ok));
+	rval.push_back(ipc::value(timing.serialize()));
+	AUTO_DEBUG;
+}
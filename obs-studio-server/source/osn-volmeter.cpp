@@ -19,6 +19,7 @@
 #include "osn-volmeter.hpp"
 #include "error.hpp"
 #include "obs.h"
+#include "osn-dispatch.hpp"
 #include "osn-source.hpp"
 #include "shared.hpp"
 #include "utility.hpp"
@@ -59,7 +60,7 @@ void osn::Volmeter::Register(ipc::server& srv)
 	cls->register_function(
 	    std::make_shared<ipc::function>("RemoveCallback", std::vector<ipc::type>{ipc::type::UInt64}, RemoveCallback));
 	cls->register_function(std::make_shared<ipc::function>("Query", std::vector<ipc::type>{ipc::type::UInt64}, Query));
-	srv.register_collection(cls);
+	osn::Dispatch::Register(srv, cls);
 }
 
 void osn::Volmeter::ClearVolmeters()
@@ -0,0 +1,164 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-window-list.hpp"
+#include <cmath>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "obs-string-table.hpp"
+extern "C" {
+#include "window-utils.h"
+}
+
+namespace
+{
+	// Enough for a handful of pickers polling at their own pace.
+	const size_t kept_revisions = 8;
+
+	struct Window
+	{
+		int64_t     owner_pid = 0;
+		int32_t     x         = 0;
+		int32_t     y         = 0;
+		int32_t     width     = 0;
+		int32_t     height    = 0;
+		std::string window_name;
+		std::string owner_name;
+
+		bool same_frame(const Window& other) const
+		{
+			return x == other.x && y == other.y && width == other.width && height == other.height;
+		}
+
+		bool same_names(const Window& other) const
+		{
+			return window_name == other.window_name && owner_name == other.owner_name;
+		}
+
+		bool operator==(const Window& other) const
+		{
+			return owner_pid == other.owner_pid && same_frame(other) && same_names(other);
+		}
+	};
+
+	typedef std::map<int64_t, Window> Snapshot;
+
+	typedef std::pair<uint64_t, std::shared_ptr<const Snapshot>> Revision;
+
+	std::mutex           mtx;
+	uint64_t             revision = 0;
+	std::deque<Revision> history;
+
+	Snapshot enumerate()
+	{
+		Snapshot                 snapshot;
+		longisland_cocoa_window* windows = enumerate_windows_json();
+		for (longisland_cocoa_window* window = windows; window; window = window->next) {
+			Window& entry     = snapshot[window->window_id];
+			entry.owner_pid   = window->owner_pid;
+			entry.x           = int32_t(std::lround(window->window_frame.x));
+			entry.y           = int32_t(std::lround(window->window_frame.y));
+			entry.width       = int32_t(std::lround(window->window_frame.width));
+			entry.height      = int32_t(std::lround(window->window_frame.height));
+			entry.window_name = window->window_name ? window->window_name : "";
+			entry.owner_name  = window->owner_name ? window->owner_name : "";
+		}
+		longisland_cocoa_window_free(windows);
+		return snapshot;
+	}
+
+	obs::WindowEntry make_entry(int64_t id, const Window& window, obs::StringTable& strings, uint32_t change)
+	{
+		obs::WindowEntry entry;
+		entry.window_id   = id;
+		entry.owner_pid   = window.owner_pid;
+		entry.x           = window.x;
+		entry.y           = window.y;
+		entry.width       = window.width;
+		entry.height      = window.height;
+		entry.window_name = strings.intern(window.window_name);
+		entry.owner_name  = strings.intern(window.owner_name);
+		entry.change      = change;
+		return entry;
+	}
+} // namespace
+
+osn::WindowList::Answer osn::WindowList::Query(uint64_t known_revision)
+{
+	// The window server is slow, enumerate before taking the lock.
+	auto current = std::make_shared<const Snapshot>(enumerate());
+
+	std::shared_ptr<const Snapshot> known;
+	Answer                          answer;
+	{
+		std::unique_lock<std::mutex> ulock(mtx);
+		if (history.empty() || !(*history.back().second == *current)) {
+			history.emplace_back(++revision, current);
+			if (history.size() > kept_revisions)
+				history.pop_front();
+		}
+		answer.revision = revision;
+		current         = history.back().second;
+
+		if (known_revision != 0) {
+			for (auto& kept : history) {
+				if (kept.first == known_revision)
+					known = kept.second;
+			}
+		}
+	}
+
+	obs::StringTable strings;
+	answer.full = !known;
+	if (answer.full) {
+		answer.entries.reserve(current->size());
+		for (auto& window : *current)
+			answer.entries.push_back(make_entry(window.first, window.second, strings, 0));
+	} else {
+		for (auto& window : *current) {
+			auto before = known->find(window.first);
+			if (before == known->end()) {
+				answer.entries.push_back(
+				    make_entry(window.first, window.second, strings, obs::WindowEntry::Opened));
+				continue;
+			}
+
+			uint32_t change = 0;
+			if (!before->second.same_frame(window.second))
+				change |= obs::WindowEntry::Moved;
+			if (!before->second.same_names(window.second))
+				change |= obs::WindowEntry::Renamed;
+			if (change)
+				answer.entries.push_back(make_entry(window.first, window.second, strings, change));
+		}
+		for (auto& window : *known) {
+			if (current->find(window.first) != current->end())
+				continue;
+
+			obs::WindowEntry entry;
+			entry.window_id = window.first;
+			entry.change    = obs::WindowEntry::Closed;
+			answer.entries.push_back(entry);
+		}
+	}
+	answer.strings = std::move(strings.data);
+	return answer;
+}
@@ -0,0 +1,45 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <inttypes.h>
+#include <vector>
+#include "obs-window.hpp"
+
+namespace osn
+{
+	// Window list behind LONGISLAND_settings_getWindowLists. Every query
+	// enumerates the windows again; whenever the result differs from the
+	// last one it becomes a new revision. The last few revisions are kept so
+	// a client that still knows one of them only gets what changed since.
+	class WindowList
+	{
+		public:
+		struct Answer
+		{
+			uint64_t                      revision = 0;
+			bool                          full     = true;
+			std::vector<obs::WindowEntry> entries;
+			std::vector<char>             strings;
+		};
+
+		// A `known_revision` of 0, or one that is no longer kept, answers
+		// with the full list.
+		static Answer Query(uint64_t known_revision);
+	};
+} // namespace osn
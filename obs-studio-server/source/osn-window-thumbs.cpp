@@ -0,0 +1,324 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "osn-window-thumbs.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <thread>
+#include "shared.hpp"
+extern "C" {
+#include "window-utils.h"
+}
+
+namespace
+{
+	const uint8_t invalid = 0xFF;
+	const uint8_t padding = 0xFE;
+	const uint8_t space   = 0xFD;
+
+	std::array<uint8_t, 256> build_table()
+	{
+		const char*              alphabet = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+		std::array<uint8_t, 256> table;
+		table.fill(invalid);
+		for (uint8_t idx = 0; idx < 64; idx++)
+			table[uint8_t(alphabet[idx])] = idx;
+		table['=']  = padding;
+		table[' ']  = space;
+		table['\t'] = space;
+		table['\r'] = space;
+		table['\n'] = space;
+		return table;
+	}
+
+	const std::array<uint8_t, 256> decode_table = build_table();
+
+	// More threads than this only queue up on the window server.
+	const size_t max_capture_threads = 8;
+
+	class RawEncoder : public osn::ThumbnailEncoder
+	{
+		public:
+		bool Encode(const osn::ThumbnailImage& image, std::vector<char>& bytes) override
+		{
+			size_t row = size_t(image.width) * 4;
+			bytes.resize(row * image.height);
+			for (uint32_t y = 0; y < image.height; y++)
+				std::memcpy(bytes.data() + row * y, image.pixels.data() + size_t(image.stride) * y, row);
+			return true;
+		}
+	};
+
+#ifdef __APPLE__
+	class ImageIOEncoder : public osn::ThumbnailEncoder
+	{
+		bool  png;
+		float quality;
+
+		public:
+		ImageIOEncoder(bool png, float quality) : png(png), quality(quality) {}
+
+		bool Encode(const osn::ThumbnailImage& image, std::vector<char>& bytes) override
+		{
+			return g_util_osx->encodeImage(
+			    image.pixels.data(), image.width, image.height, image.stride, png, quality, bytes);
+		}
+	};
+#endif
+
+	struct Codecs
+	{
+		std::mutex                                                         mtx;
+		std::map<obs::ThumbFormat, std::shared_ptr<osn::ThumbnailEncoder>> encoders;
+		osn::WindowThumbs::Decoder                                         decoder;
+
+		Codecs()
+		{
+			encoders[obs::ThumbFormat::BGRA] = std::make_shared<RawEncoder>();
+#ifdef __APPLE__
+			encoders[obs::ThumbFormat::PNG]  = std::make_shared<ImageIOEncoder>(true, 1.0f);
+			encoders[obs::ThumbFormat::JPEG] = std::make_shared<ImageIOEncoder>(false, 0.8f);
+			decoder = [](const std::vector<char>& bytes, osn::ThumbnailImage& image) {
+				image.pixels.clear();
+				bool ok      = g_util_osx->decodeImage(bytes.data(), bytes.size(), image.pixels, image.width, image.height);
+				image.stride = image.width * 4;
+				return ok;
+			};
+#endif
+		}
+	};
+
+	Codecs& codecs()
+	{
+		static Codecs instance;
+		return instance;
+	}
+
+	std::vector<std::string> split_ids(const std::string& window_ids)
+	{
+		std::vector<std::string> ids;
+		size_t                   begin = 0;
+		while (begin <= window_ids.size()) {
+			size_t end = window_ids.find(',', begin);
+			if (end == std::string::npos)
+				end = window_ids.size();
+
+			size_t first = window_ids.find_first_not_of(" \t", begin);
+			size_t last  = window_ids.find_last_not_of(" \t", end == 0 ? 0 : end - 1);
+			if (first < end && last != std::string::npos && last >= first)
+				ids.push_back(window_ids.substr(first, last - first + 1));
+			begin = end + 1;
+		}
+		return ids;
+	}
+
+	// Decodes, scales and encodes one captured thumbnail. Returns false if
+	// the window has to be left out.
+	bool process(
+	    const longisland_window_thumb*     thumb,
+	    const std::map<int64_t, uint64_t>& known,
+	    const osn::WindowThumbs::Options&  options,
+	    osn::WindowThumbs::Result&         result)
+	{
+		size_t   size        = strlen(thumb->image_base64);
+		uint32_t settings[3] = {options.max_width, options.max_height, uint32_t(options.format)};
+
+		obs::WindowThumb& header = result.header;
+		header.window_id         = thumb->window_id;
+		header.width             = thumb->width;
+		header.height            = thumb->height;
+		header.hash = osn::WindowThumbs::Hash(
+		    thumb->image_base64,
+		    size,
+		    osn::WindowThumbs::Hash(reinterpret_cast<const char*>(settings), sizeof(settings)));
+
+		// The client keeps what it already has, skip decoding it again.
+		auto found = known.find(header.window_id);
+		if (found != known.end() && found->second == header.hash)
+			return true;
+
+		if (!osn::WindowThumbs::Decode(thumb->image_base64, size, result.bytes) || result.bytes.empty())
+			return false;
+		header.changed = 1;
+
+		uint32_t width, height;
+		osn::ThumbnailScaler::FitSize(header.width, header.height, options.max_width, options.max_height, width, height);
+		if (options.format == obs::ThumbFormat::Source && width == header.width && height == header.height)
+			return true;
+
+		// Scaled plugin images are encoded again the way the plugin does.
+		obs::ThumbFormat format = options.format == obs::ThumbFormat::Source ? obs::ThumbFormat::JPEG : options.format;
+
+		Codecs&                                registry = codecs();
+		osn::WindowThumbs::Decoder             decoder;
+		std::shared_ptr<osn::ThumbnailEncoder> encoder;
+		{
+			std::unique_lock<std::mutex> ulock(registry.mtx);
+			decoder    = registry.decoder;
+			auto entry = registry.encoders.find(format);
+			if (entry == registry.encoders.end()) {
+				format = obs::ThumbFormat::BGRA;
+				entry  = registry.encoders.find(format);
+			}
+			encoder = entry->second;
+		}
+
+		// Without a decoder the plugin's image is all there is.
+		osn::ThumbnailImage image;
+		if (!decoder || !decoder(result.bytes, image) || !image.width || !image.height)
+			return true;
+
+		osn::ThumbnailScaler::FitSize(image.width, image.height, options.max_width, options.max_height, width, height);
+		if (width != image.width || height != image.height) {
+			osn::ThumbnailImage scaled;
+			osn::ThumbnailScaler::Downscale(image, scaled, width, height);
+			image = std::move(scaled);
+		}
+
+		std::vector<char> encoded;
+		if (!encoder->Encode(image, encoded))
+			return true;
+
+		result.bytes  = std::move(encoded);
+		header.width  = image.width;
+		header.height = image.height;
+		header.format = uint32_t(format);
+		return true;
+	}
+
+	void capture_batch(
+	    const std::string&                      window_ids,
+	    const std::map<int64_t, uint64_t>&      known,
+	    const osn::WindowThumbs::Options&       options,
+	    std::vector<osn::WindowThumbs::Result>& results)
+	{
+		longisland_window_thumb* thumbs = enumerate_windows_images_json(window_ids.c_str());
+		for (longisland_window_thumb* thumb = thumbs; thumb; thumb = thumb->next) {
+			if (!thumb->image_base64)
+				continue;
+
+			osn::WindowThumbs::Result result;
+			if (process(thumb, known, options, result))
+				results.push_back(std::move(result));
+		}
+		longisland_window_thumb_free(thumbs);
+	}
+} // namespace
+
+void osn::WindowThumbs::RegisterEncoder(obs::ThumbFormat format, std::shared_ptr<ThumbnailEncoder> encoder)
+{
+	Codecs&                      registry = codecs();
+	std::unique_lock<std::mutex> ulock(registry.mtx);
+	if (encoder)
+		registry.encoders[format] = encoder;
+	else if (format != obs::ThumbFormat::BGRA)
+		registry.encoders.erase(format);
+}
+
+void osn::WindowThumbs::RegisterDecoder(Decoder decoder)
+{
+	Codecs&                      registry = codecs();
+	std::unique_lock<std::mutex> ulock(registry.mtx);
+	registry.decoder = decoder;
+}
+
+std::vector<osn::WindowThumbs::Result> osn::WindowThumbs::Capture(
+    const std::string&                 window_ids,
+    const std::map<int64_t, uint64_t>& known,
+    const Options&                     options)
+{
+	std::vector<Result>      results;
+	std::vector<std::string> ids = split_ids(window_ids);
+	if (ids.size() <= 1) {
+		capture_batch(window_ids, known, options, results);
+		return results;
+	}
+
+	// One plugin call per window, spread over a few threads. Results keep
+	// the order of the ids.
+	std::vector<std::vector<Result>> batches(ids.size());
+	std::atomic<size_t>              next(0);
+	auto work = [&]() {
+		for (size_t idx = next++; idx < ids.size(); idx = next++)
+			capture_batch(ids[idx], known, options, batches[idx]);
+	};
+
+	size_t threads = std::min(ids.size(), std::min<size_t>(std::thread::hardware_concurrency(), max_capture_threads));
+	std::vector<std::thread> workers;
+	for (size_t idx = 1; idx < threads; idx++)
+		workers.emplace_back(work);
+	work();
+	for (auto& worker : workers)
+		worker.join();
+
+	for (auto& batch : batches) {
+		for (auto& result : batch)
+			results.push_back(std::move(result));
+	}
+	return results;
+}
+
+uint64_t osn::WindowThumbs::Hash(const char* data, size_t size, uint64_t seed)
+{
+	uint64_t hash = seed;
+	for (size_t idx = 0; idx < size; idx++) {
+		hash ^= uint8_t(data[idx]);
+		hash *= 0x100000001b3ull;
+	}
+	return hash;
+}
+
+bool osn::WindowThumbs::Decode(const char* base64, size_t size, std::vector<char>& bytes)
+{
+	bytes.clear();
+	bytes.reserve(size / 4 * 3);
+
+	uint32_t group  = 0;
+	size_t   count  = 0;
+	size_t   padded = 0;
+	for (size_t idx = 0; idx < size; idx++) {
+		uint8_t value = decode_table[uint8_t(base64[idx])];
+		if (value == space)
+			continue;
+		if (value == invalid)
+			return false;
+		if (value == padding) {
+			padded++;
+			value = 0;
+		} else if (padded) {
+			// Data after padding.
+			return false;
+		}
+
+		group = (group << 6) | value;
+		if (++count == 4) {
+			bytes.push_back(char(group >> 16));
+			if (padded < 2)
+				bytes.push_back(char(group >> 8));
+			if (padded < 1)
+				bytes.push_back(char(group));
+			group = 0;
+			count = 0;
+		}
+	}
+
+	return count == 0 && padded <= 2;
+}
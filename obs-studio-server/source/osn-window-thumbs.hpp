@@ -0,0 +1,81 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <functional>
+#include <inttypes.h>
+#include <map>
+#include <memory>
+#include <stddef.h>
+#include <string>
+#include <vector>
+#include "obs-window.hpp"
+#include "osn-thumbnail-scale.hpp"
+
+namespace osn
+{
+	// Turns a BGRA thumbnail into the bytes sent to the client.
+	class ThumbnailEncoder
+	{
+		public:
+		virtual ~ThumbnailEncoder() {}
+		virtual bool Encode(const ThumbnailImage& image, std::vector<char>& bytes) = 0;
+	};
+
+	// Window thumbnail pipeline behind LONGISLAND_content_getWindowThumbs.
+	// Windows are captured in parallel, one plugin call per window. The
+	// plugin hands images out base64 encoded; they are decoded once and, if
+	// a smaller size or another format is asked for, scaled down and
+	// encoded again.
+	class WindowThumbs
+	{
+		public:
+		struct Options
+		{
+			uint32_t         max_width  = 0;
+			uint32_t         max_height = 0;
+			obs::ThumbFormat format     = obs::ThumbFormat::Source;
+		};
+
+		struct Result
+		{
+			obs::WindowThumb  header;
+			std::vector<char> bytes;
+		};
+
+		// Decodes the plugin's image bytes into BGRA.
+		typedef std::function<bool(const std::vector<char>& bytes, ThumbnailImage& image)> Decoder;
+
+		// Raw BGRA is always available, the platform registers what else it
+		// can encode and decode. Registering again replaces the previous one.
+		static void RegisterEncoder(obs::ThumbFormat format, std::shared_ptr<ThumbnailEncoder> encoder);
+		static void RegisterDecoder(Decoder decoder);
+
+		// Captures the comma separated `window_ids`. Windows whose hash is in
+		// `known` come back unchanged and without bytes.
+		static std::vector<Result>
+		    Capture(const std::string& window_ids, const std::map<int64_t, uint64_t>& known, const Options& options);
+
+		// 64 bit FNV-1a, identifies the content of a thumbnail.
+		static uint64_t Hash(const char* data, size_t size, uint64_t seed = 0xcbf29ce484222325ull);
+
+		// Decodes standard base64, skipping whitespace. Returns false on
+		// malformed input.
+		static bool Decode(const char* base64, size_t size, std::vector<char>& bytes);
+	};
+} // namespace osn
@@ -23,6 +23,8 @@
 #include <sys/sysctl.h>
 
 #import <mach/mach.h>
+#import <ImageIO/ImageIO.h>
+#import <CoreServices/CoreServices.h>
 #include <unistd.h>
 #include <sys/types.h>
 #include <sys/stat.h>
@@ -182,4 +184,77 @@ std::string UtilObjCInt::getWorkingDirectory(void)
     NSString* workindDirPath = [[NSProcessInfo processInfo] environment][@"PWD"];
     return std::string([workindDirPath UTF8String]);
 }
+
+// Decodes an encoded image into BGRA, as laid out by libobs (8 bit per
+// channel, blue first).
+bool UtilObjCInt::decodeImage(const char* data, size_t size, std::vector<uint8_t>& pixels, uint32_t& width, uint32_t& height)
+{
+    @autoreleasepool {
+        CFDataRef cfdata = CFDataCreateWithBytesNoCopy(kCFAllocatorDefault, (const UInt8*)data, size, kCFAllocatorNull);
+        if (!cfdata)
+            return false;
+        CGImageSourceRef source = CGImageSourceCreateWithData(cfdata, NULL);
+        CFRelease(cfdata);
+        if (!source)
+            return false;
+        CGImageRef image = CGImageSourceCreateImageAtIndex(source, 0, NULL);
+        CFRelease(source);
+        if (!image)
+            return false;
+
+        width = (uint32_t)CGImageGetWidth(image);
+        height = (uint32_t)CGImageGetHeight(image);
+        pixels.resize(size_t(width) * height * 4);
+
+        CGColorSpaceRef space = CGColorSpaceCreateDeviceRGB();
+        CGContextRef context = CGBitmapContextCreate(pixels.data(), width, height, 8, width * 4, space,
+            kCGImageAlphaPremultipliedFirst | kCGBitmapByteOrder32Little);
+        CGColorSpaceRelease(space);
+        if (!context) {
+            CGImageRelease(image);
+            return false;
+        }
+
+        CGContextDrawImage(context, CGRectMake(0, 0, width, height), image);
+        CGContextRelease(context);
+        CGImageRelease(image);
+        return true;
+    }
+}
+
+bool UtilObjCInt::encodeImage(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t stride, bool png, float quality, std::vector<char>& bytes)
+{
+    @autoreleasepool {
+        CGColorSpaceRef space = CGColorSpaceCreateDeviceRGB();
+        CGContextRef context = CGBitmapContextCreate((void*)pixels, width, height, 8, stride, space,
+            kCGImageAlphaPremultipliedFirst | kCGBitmapByteOrder32Little);
+        CGColorSpaceRelease(space);
+        if (!context)
+            return false;
+        CGImageRef image = CGBitmapContextCreateImage(context);
+        CGContextRelease(context);
+        if (!image)
+            return false;
+
+        bool ok = false;
+        CFMutableDataRef data = CFDataCreateMutable(kCFAllocatorDefault, 0);
+        CGImageDestinationRef destination =
+            CGImageDestinationCreateWithData(data, png ? kUTTypePNG : kUTTypeJPEG, 1, NULL);
+        if (destination) {
+            NSDictionary* properties = png ? nil :
+                @{(NSString*)kCGImageDestinationLossyCompressionQuality: @(quality)};
+            CGImageDestinationAddImage(destination, image, (CFDictionaryRef)properties);
+            ok = CGImageDestinationFinalize(destination);
+            CFRelease(destination);
+        }
+        CGImageRelease(image);
+
+        if (ok) {
+            const char* begin = (const char*)CFDataGetBytePtr(data);
+            bytes.assign(begin, begin + CFDataGetLength(data));
+        }
+        CFRelease(data);
+        return ok;
+    }
+}
 @end
@@ -72,4 +72,14 @@ std::string UtilInt::getUserDataPath(void)
 std::string UtilInt::getWorkingDirectory(void)
 {
     return _impl->getWorkingDirectory();
-}
\ No newline at end of file
+}
+
+bool UtilInt::decodeImage(const char* data, size_t size, std::vector<uint8_t>& pixels, uint32_t& width, uint32_t& height)
+{
+    return _impl->decodeImage(data, size, pixels, width, height);
+}
+
+bool UtilInt::encodeImage(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t stride, bool png, float quality, std::vector<char>& bytes)
+{
+    return _impl->encodeImage(pixels, width, height, stride, png, quality, bytes);
+}
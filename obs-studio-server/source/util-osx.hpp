@@ -39,6 +39,8 @@ public:
     std::vector<std::pair<uint32_t, uint32_t>> getAvailableScreenResolutions(void);
     std::string getUserDataPath(void);
     std::string getWorkingDirectory(void);
+    bool decodeImage(const char* data, size_t size, std::vector<uint8_t>& pixels, uint32_t& width, uint32_t& height);
+    bool encodeImage(const uint8_t* pixels, uint32_t width, uint32_t height, uint32_t stride, bool png, float quality, std::vector<char>& bytes);
 
 private:
     UtilObjCInt * _impl;
@@ -0,0 +1,112 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <inttypes.h>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace obs
+{
+	// Append-only writer for the packed binary payloads exchanged over IPC.
+	// Scalars are written in host byte order, strings are length prefixed.
+	class BufferWriter
+	{
+		std::vector<char> buf;
+
+		public:
+		template<typename T>
+		void write(T const& value)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be written.");
+			size_t offset = buf.size();
+			buf.resize(offset + sizeof(T));
+			std::memcpy(&buf[offset], &value, sizeof(T));
+		}
+
+		void write(std::string const& value)
+		{
+			write<uint32_t>(uint32_t(value.size()));
+			buf.insert(buf.end(), value.begin(), value.end());
+		}
+
+		size_t size() const
+		{
+			return buf.size();
+		}
+
+		std::vector<char>& data()
+		{
+			return buf;
+		}
+	};
+
+	// Bounds checked counterpart of BufferWriter. Once a read runs past the
+	// end of the buffer every further read fails and ok() returns false.
+	class BufferReader
+	{
+		const char* buf;
+		size_t      length;
+		size_t      offset = 0;
+		bool        valid  = true;
+
+		public:
+		BufferReader(const char* buf, size_t length) : buf(buf), length(length) {}
+		BufferReader(std::vector<char> const& buf) : buf(buf.data()), length(buf.size()) {}
+
+		template<typename T>
+		bool read(T& value)
+		{
+			static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable types can be read.");
+			if (!valid || length - offset < sizeof(T))
+				return valid = false;
+			std::memcpy(&value, buf + offset, sizeof(T));
+			offset += sizeof(T);
+			return true;
+		}
+
+		bool read(std::string& value)
+		{
+			uint32_t size = 0;
+			if (!read(size))
+				return false;
+			if (length - offset < size)
+				return valid = false;
+			value.assign(buf + offset, size);
+			offset += size;
+			return true;
+		}
+
+		bool ok() const
+		{
+			return valid;
+		}
+
+		bool eof() const
+		{
+			return offset == length;
+		}
+
+		size_t remaining() const
+		{
+			return valid ? length - offset : 0;
+		}
+	};
+} // namespace obs
@@ -0,0 +1,109 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <atomic>
+#include <cstring>
+#include <inttypes.h>
+
+namespace obs
+{
+	// Video and output counters the server publishes into a shared memory
+	// page, so clients read them without an IPC round trip.
+	struct FrameStats
+	{
+		uint64_t render_total       = 0; // obs_get_total_frames
+		uint64_t render_lagged      = 0; // obs_get_lagged_frames
+		uint64_t video_total        = 0; // video_output_get_total_frames
+		uint64_t video_skipped      = 0; // video_output_get_skipped_frames
+		uint64_t output_total       = 0; // frames of the streaming output
+		uint64_t output_dropped     = 0;
+		double   output_congestion  = 0; // 0 to 1
+		double   active_fps         = 0;
+		uint64_t average_frame_time = 0; // ns
+		uint64_t updated            = 0; // os_gettime_ns of the last write
+	};
+
+	// Layout of the shared page. A single writer bumps `sequence` to an odd
+	// value, stores the counters and bumps it to even again; readers retry
+	// while the sequence is odd or changed under them. Counters are atomics
+	// themselves so a torn read is never undefined behavior, only retried.
+	struct FrameStatsPage
+	{
+		static const uint32_t magic_value   = 0x5374734f; // "OsSt"
+		static const uint32_t version_value = 1;
+		static const size_t   field_count   = sizeof(FrameStats) / sizeof(uint64_t);
+
+		uint32_t              magic   = magic_value;
+		uint32_t              version = version_value;
+		std::atomic<uint32_t> sequence{0};
+		uint32_t              reserved = 0;
+		std::atomic<uint64_t> fields[field_count];
+
+		static_assert(sizeof(FrameStats) % sizeof(uint64_t) == 0, "FrameStats must be made of 64 bit fields");
+		static_assert(sizeof(double) == sizeof(uint64_t), "FrameStats stores doubles as 64 bit fields");
+
+		FrameStatsPage()
+		{
+			for (auto& field : fields)
+				field.store(0, std::memory_order_relaxed);
+		}
+
+		bool valid() const
+		{
+			return magic == magic_value && version == version_value;
+		}
+
+		// Only ever called from one thread.
+		void write(const FrameStats& stats)
+		{
+			uint64_t values[field_count];
+			std::memcpy(values, &stats, sizeof(values));
+
+			uint32_t seq = sequence.load(std::memory_order_relaxed);
+			sequence.store(seq + 1, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			for (size_t idx = 0; idx < field_count; idx++)
+				fields[idx].store(values[idx], std::memory_order_relaxed);
+			sequence.store(seq + 2, std::memory_order_release);
+		}
+
+		// Returns false if the writer kept the page busy for `attempts` tries.
+		bool read(FrameStats& stats, size_t attempts = 64) const
+		{
+			uint64_t values[field_count];
+			for (size_t attempt = 0; attempt < attempts; attempt++) {
+				uint32_t before = sequence.load(std::memory_order_acquire);
+				if (before & 1)
+					continue;
+
+				for (size_t idx = 0; idx < field_count; idx++)
+					values[idx] = fields[idx].load(std::memory_order_relaxed);
+
+				std::atomic_thread_fence(std::memory_order_acquire);
+				if (sequence.load(std::memory_order_relaxed) == before) {
+					std::memcpy(&stats, values, sizeof(values));
+					return true;
+				}
+			}
+			return false;
+		}
+	};
+
+	static_assert(std::atomic<uint64_t>::is_always_lock_free, "The frame stats page needs lock free 64 bit atomics");
+} // namespace obs
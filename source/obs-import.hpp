@@ -0,0 +1,198 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <string>
+#include <vector>
+#include "obs-buffer.hpp"
+#include "obs-transform.hpp"
+
+namespace obs
+{
+	// Wire layout of an Input.CreateBulk request: every input is created with
+	// its filters attached and is then added to each of its placements.
+	struct FilterDefinition
+	{
+		std::string type;
+		std::string name;
+		std::string settings;
+		bool        enabled = true;
+	};
+
+	struct PlacementDefinition
+	{
+		uint64_t  scene   = 0;
+		bool      visible = true;
+		Transform transform;
+	};
+
+	struct InputDefinition
+	{
+		std::string                      type;
+		std::string                      name;
+		std::string                      settings;
+		std::string                      hotkeys;
+		std::vector<FilterDefinition>    filters;
+		std::vector<PlacementDefinition> placements;
+	};
+
+	// Per input answer of Input.CreateBulk. `uid` is UINT64_MAX if the input
+	// could not be created, in which case filters and items are left empty.
+	struct InputImportResult
+	{
+		struct Item
+		{
+			uint64_t uid;
+			int64_t  obs_id;
+		};
+
+		uint64_t              uid          = UINT64_MAX;
+		uint32_t              audio_mixers = 0;
+		std::vector<uint64_t> filters;
+		std::vector<Item>     items;
+	};
+
+	// Smallest encoded size of one entry, used to check counts read from
+	// the wire against the bytes left before reserving for them.
+	static const size_t min_definition_size = sizeof(uint32_t) * 6;
+	static const size_t min_result_size     = sizeof(uint64_t) + sizeof(uint32_t) * 3;
+
+	inline std::vector<char> serialize_definitions(std::vector<InputDefinition> const& list)
+	{
+		BufferWriter out;
+		out.write<uint32_t>(uint32_t(list.size()));
+		for (auto& input : list) {
+			out.write(input.type);
+			out.write(input.name);
+			out.write(input.settings);
+			out.write(input.hotkeys);
+			out.write<uint32_t>(uint32_t(input.filters.size()));
+			for (auto& filter : input.filters) {
+				out.write(filter.type);
+				out.write(filter.name);
+				out.write(filter.settings);
+				out.write<uint8_t>(filter.enabled);
+			}
+			out.write<uint32_t>(uint32_t(input.placements.size()));
+			for (auto& placement : input.placements) {
+				out.write(placement.scene);
+				out.write<uint8_t>(placement.visible);
+				out.write(placement.transform);
+			}
+		}
+		return std::move(out.data());
+	}
+
+	inline bool read_definitions(std::vector<char> const& buf, std::vector<InputDefinition>& list)
+	{
+		BufferReader in(buf);
+		uint32_t     count = 0;
+		if (!in.read(count) || count > in.remaining() / min_definition_size)
+			return false;
+
+		list.clear();
+		list.reserve(count);
+		for (uint32_t idx = 0; idx < count && in.ok(); idx++) {
+			InputDefinition input;
+			in.read(input.type);
+			in.read(input.name);
+			in.read(input.settings);
+			in.read(input.hotkeys);
+
+			uint32_t filters = 0;
+			in.read(filters);
+			for (uint32_t fdx = 0; fdx < filters && in.ok(); fdx++) {
+				FilterDefinition filter;
+				uint8_t          enabled = 1;
+				in.read(filter.type);
+				in.read(filter.name);
+				in.read(filter.settings);
+				in.read(enabled);
+				filter.enabled = !!enabled;
+				input.filters.push_back(std::move(filter));
+			}
+
+			uint32_t placements = 0;
+			in.read(placements);
+			for (uint32_t pdx = 0; pdx < placements && in.ok(); pdx++) {
+				PlacementDefinition placement;
+				uint8_t             visible = 1;
+				in.read(placement.scene);
+				in.read(visible);
+				in.read(placement.transform);
+				placement.visible = !!visible;
+				input.placements.push_back(placement);
+			}
+
+			list.push_back(std::move(input));
+		}
+		return in.ok() && in.eof();
+	}
+
+	inline std::vector<char> serialize_results(std::vector<InputImportResult> const& list)
+	{
+		BufferWriter out;
+		out.write<uint32_t>(uint32_t(list.size()));
+		for (auto& result : list) {
+			out.write(result.uid);
+			out.write(result.audio_mixers);
+			out.write<uint32_t>(uint32_t(result.filters.size()));
+			for (auto filter : result.filters)
+				out.write(filter);
+			out.write<uint32_t>(uint32_t(result.items.size()));
+			for (auto& item : result.items)
+				out.write(item);
+		}
+		return std::move(out.data());
+	}
+
+	inline bool read_results(std::vector<char> const& buf, std::vector<InputImportResult>& list)
+	{
+		BufferReader in(buf);
+		uint32_t     count = 0;
+		if (!in.read(count) || count > in.remaining() / min_result_size)
+			return false;
+
+		list.clear();
+		list.reserve(count);
+		for (uint32_t idx = 0; idx < count && in.ok(); idx++) {
+			InputImportResult result;
+			in.read(result.uid);
+			in.read(result.audio_mixers);
+
+			uint32_t filters = 0;
+			in.read(filters);
+			for (uint32_t fdx = 0; fdx < filters && in.ok(); fdx++) {
+				uint64_t filter = UINT64_MAX;
+				in.read(filter);
+				result.filters.push_back(filter);
+			}
+
+			uint32_t items = 0;
+			in.read(items);
+			for (uint32_t tdx = 0; tdx < items && in.ok(); tdx++) {
+				InputImportResult::Item item = {UINT64_MAX, 0};
+				in.read(item);
+				result.items.push_back(item);
+			}
+
+			list.push_back(std::move(result));
+		}
+		return in.ok() && in.eof();
+	}
+} // namespace obs
@@ -0,0 +1,37 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include "obs-transform.hpp"
+
+namespace obs
+{
+	// Playback clock of a media input, published through the callback poll
+	// when its state changes and about once a second while it plays. Times
+	// are in milliseconds; between samples the client advances `time` itself
+	// for as long as `state` is playing.
+#pragma pack(push, 1)
+	struct MediaClock
+	{
+		uint64_t uid      = UINT64_MAX;
+		int32_t  state    = 0;
+		int64_t  time     = 0;
+		int64_t  duration = 0;
+	};
+#pragma pack(pop)
+} // namespace obs
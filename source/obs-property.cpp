@@ -559,6 +559,10 @@ size_t obs::ListProperty::size()
 		break;
 	}
 
+	total += sizeof(uint64_t);
+	total += sizeof(uint8_t);
+	total += sizeof(uint64_t);
+
 	return total;
 }
 
@@ -587,7 +591,7 @@ bool obs::ListProperty::serialize(std::vector<char>& buf)
 			memcpy(&buf[offset], entry.name.data(), entry.name.size());
 			offset += entry.name.size();
 		}
-		buf[offset] = enabled;
+		buf[offset] = entry.enabled;
 		offset += sizeof(uint8_t);
 		switch (format) {
 		case Format::Integer:
@@ -628,6 +632,13 @@ bool obs::ListProperty::serialize(std::vector<char>& buf)
 		break;
 	}
 
+	reinterpret_cast<uint64_t&>(buf[offset]) = item_count;
+	offset += sizeof(uint64_t);
+	buf[offset] = items_deferred;
+	offset += sizeof(uint8_t);
+	reinterpret_cast<uint64_t&>(buf[offset]) = items_hash;
+	offset += sizeof(uint64_t);
+
 	return true;
 }
 
@@ -702,6 +713,13 @@ bool obs::ListProperty::read(std::vector<char> const& buf)
 		break;
 	}
 
+	item_count = reinterpret_cast<const uint64_t&>(buf[offset]);
+	offset += sizeof(uint64_t);
+	items_deferred = !!buf[offset];
+	offset += sizeof(uint8_t);
+	items_hash = reinterpret_cast<const uint64_t&>(buf[offset]);
+	offset += sizeof(uint64_t);
+
 	return true;
 }
 
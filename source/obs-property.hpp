@@ -206,6 +206,13 @@ namespace obs
 		double_t        current_value_float;
 		std::string     current_value_str;
 
+		// Number of items in the list. Deferred lists only carry the selected
+		// item in `items`, the rest is fetched in pages through the property
+		// session. `items_hash` changes whenever any item does.
+		uint64_t item_count     = 0;
+		bool     items_deferred = false;
+		uint64_t items_hash     = 0;
+
 		virtual ~ListProperty(){};
 
 		virtual obs::Property::Type type() override;
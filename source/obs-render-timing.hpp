@@ -0,0 +1,177 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <inttypes.h>
+#include <array>
+#include <cstring>
+#include <vector>
+
+namespace obs
+{
+	// Render time distribution answered by Video.GetRenderTiming. Times are
+	// in nanoseconds, percentiles are the upper bound of the histogram
+	// bucket they fall in, so at most ~3% above the real value.
+#pragma pack(push, 1)
+	struct RenderTiming
+	{
+		uint64_t frames            = 0;
+		uint64_t over_budget       = 0;
+		uint64_t over_twice_budget = 0;
+		uint64_t budget            = 0;
+		uint64_t mean              = 0;
+		uint64_t p50               = 0;
+		uint64_t p95               = 0;
+		uint64_t p99               = 0;
+		uint64_t max               = 0;
+		uint64_t duration          = 0;
+
+		std::vector<char> serialize() const
+		{
+			std::vector<char> buf(sizeof(RenderTiming));
+			std::memcpy(buf.data(), this, sizeof(RenderTiming));
+			return buf;
+		}
+
+		bool read(std::vector<char> const& buf)
+		{
+			if (buf.size() != sizeof(RenderTiming))
+				return false;
+			std::memcpy(this, buf.data(), sizeof(RenderTiming));
+			return true;
+		}
+	};
+#pragma pack(pop)
+
+	// Log-linear histogram of frame times in microseconds, the resolution of
+	// the libobs profiler. Values below 32 us get a bucket each, above that
+	// every power of two is split into 32 buckets.
+	class TimingHistogram
+	{
+		public:
+		static const uint32_t sub_bits     = 5;
+		static const uint32_t sub_count    = 1 << sub_bits;
+		static const uint32_t max_msb      = 26;
+		static const size_t   bucket_count = (max_msb - sub_bits + 2) * sub_count;
+
+		static size_t index(uint64_t usec)
+		{
+			if (usec < sub_count)
+				return size_t(usec);
+
+			uint32_t msb = 0;
+			for (uint64_t v = usec; v > 1; v >>= 1)
+				msb++;
+			if (msb > max_msb) {
+				msb  = max_msb;
+				usec = (uint64_t(1) << (max_msb + 1)) - 1;
+			}
+
+			uint32_t shift = msb - sub_bits;
+			return size_t(shift + 1) * sub_count + size_t((usec >> shift) - sub_count);
+		}
+
+		// Largest value that still lands in bucket `idx`.
+		static uint64_t upper_bound(size_t idx)
+		{
+			if (idx < sub_count)
+				return idx;
+
+			uint32_t shift = uint32_t(idx / sub_count) - 1;
+			uint64_t lower = uint64_t(sub_count + idx % sub_count) << shift;
+			return lower + (uint64_t(1) << shift) - 1;
+		}
+
+		void add(uint64_t usec, uint64_t count, uint64_t budget_usec)
+		{
+			if (!count)
+				return;
+
+			buckets[index(usec)] += count;
+			total += count;
+			sum += usec * count;
+			if (usec > max)
+				max = usec;
+			if (budget_usec && usec > budget_usec) {
+				over_budget += count;
+				if (usec > budget_usec * 2)
+					over_twice_budget += count;
+			}
+		}
+
+		void merge(TimingHistogram const& other)
+		{
+			for (size_t idx = 0; idx < bucket_count; idx++)
+				buckets[idx] += other.buckets[idx];
+			total += other.total;
+			sum += other.sum;
+			over_budget += other.over_budget;
+			over_twice_budget += other.over_twice_budget;
+			if (other.max > max)
+				max = other.max;
+		}
+
+		void clear()
+		{
+			*this = TimingHistogram();
+		}
+
+		// Smallest bucket bound covering the fraction `p` of all values,
+		// capped at the exact maximum.
+		uint64_t percentile(double p) const
+		{
+			if (!total)
+				return 0;
+
+			uint64_t target = uint64_t(p * double(total) + 0.999999);
+			if (target < 1)
+				target = 1;
+
+			uint64_t seen = 0;
+			for (size_t idx = 0; idx < bucket_count; idx++) {
+				seen += buckets[idx];
+				if (seen >= target)
+					return upper_bound(idx) < max ? upper_bound(idx) : max;
+			}
+			return max;
+		}
+
+		RenderTiming summary(uint64_t budget_ns, uint64_t duration_ns) const
+		{
+			RenderTiming timing;
+			timing.frames            = total;
+			timing.over_budget       = over_budget;
+			timing.over_twice_budget = over_twice_budget;
+			timing.budget            = budget_ns;
+			timing.mean              = total ? sum * 1000 / total : 0;
+			timing.p50               = percentile(0.50) * 1000;
+			timing.p95               = percentile(0.95) * 1000;
+			timing.p99               = percentile(0.99) * 1000;
+			timing.max               = max * 1000;
+			timing.duration          = duration_ns;
+			return timing;
+		}
+
+		std::array<uint64_t, bucket_count> buckets{};
+		uint64_t                           total             = 0;
+		uint64_t                           sum               = 0;
+		uint64_t                           max               = 0;
+		uint64_t                           over_budget       = 0;
+		uint64_t                           over_twice_budget = 0;
+	};
+} // namespace obs
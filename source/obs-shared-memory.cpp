@@ -0,0 +1,116 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#include "obs-shared-memory.hpp"
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+obs::SharedMemory::~SharedMemory()
+{
+	close();
+}
+
+bool obs::SharedMemory::create(const std::string& region, size_t bytes)
+{
+	close();
+
+#ifdef WIN32
+	HANDLE handle = CreateFileMappingA(
+	    INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, DWORD(bytes), ("Local\\" + region).c_str());
+	if (!handle)
+		return false;
+	mapping = handle;
+	view    = MapViewOfFile(handle, FILE_MAP_ALL_ACCESS, 0, 0, bytes);
+#else
+	std::string path = "/" + region;
+	int         fd   = shm_open(path.c_str(), O_CREAT | O_RDWR, 0600);
+	if (fd < 0)
+		return false;
+	if (ftruncate(fd, off_t(bytes)) == 0) {
+		void* addr = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+		if (addr != MAP_FAILED)
+			view = addr;
+	}
+	::close(fd);
+	name  = path;
+	owner = true;
+#endif
+	size = bytes;
+	if (!view) {
+		close();
+		return false;
+	}
+	return true;
+}
+
+bool obs::SharedMemory::open(const std::string& region, size_t bytes)
+{
+	close();
+
+#ifdef WIN32
+	HANDLE handle = OpenFileMappingA(FILE_MAP_READ, FALSE, ("Local\\" + region).c_str());
+	if (!handle)
+		return false;
+	mapping = handle;
+	view    = MapViewOfFile(handle, FILE_MAP_READ, 0, 0, bytes);
+#else
+	std::string path = "/" + region;
+	int         fd   = shm_open(path.c_str(), O_RDONLY, 0);
+	if (fd < 0)
+		return false;
+	struct stat st;
+	if (fstat(fd, &st) == 0 && size_t(st.st_size) >= bytes) {
+		void* addr = mmap(nullptr, bytes, PROT_READ, MAP_SHARED, fd, 0);
+		if (addr != MAP_FAILED)
+			view = addr;
+	}
+	::close(fd);
+#endif
+	size = bytes;
+	if (!view) {
+		close();
+		return false;
+	}
+	return true;
+}
+
+void obs::SharedMemory::close()
+{
+#ifdef WIN32
+	if (view)
+		UnmapViewOfFile(view);
+	if (mapping)
+		CloseHandle(mapping);
+#else
+	if (view)
+		munmap(view, size);
+	if (owner)
+		shm_unlink(name.c_str());
+#endif
+	view    = nullptr;
+	mapping = nullptr;
+	size    = 0;
+	owner   = false;
+	name.clear();
+}
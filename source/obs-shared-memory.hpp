@@ -0,0 +1,54 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <stddef.h>
+#include <string>
+
+namespace obs
+{
+	// A named shared memory region. The server creates it writable, clients
+	// open it read only by the name the server hands out.
+	class SharedMemory
+	{
+		public:
+		SharedMemory() = default;
+		~SharedMemory();
+
+		SharedMemory(const SharedMemory&) = delete;
+		SharedMemory& operator=(const SharedMemory&) = delete;
+
+		// `name` is plain ASCII without slashes, at most 30 characters so it
+		// also fits the limit of macOS.
+		bool create(const std::string& name, size_t size);
+		bool open(const std::string& name, size_t size);
+		void close();
+
+		void* data() const
+		{
+			return view;
+		}
+
+		private:
+		void*       view    = nullptr;
+		void*       mapping = nullptr;
+		size_t      size    = 0;
+		bool        owner   = false;
+		std::string name;
+	};
+} // namespace obs
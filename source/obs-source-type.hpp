@@ -0,0 +1,44 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include "obs-transform.hpp"
+
+namespace obs
+{
+	// One registered source type of the catalogue returned by
+	// Source.GetTypes. `id` and `display_name` are offsets into the
+	// obs::StringTable sent next to the list.
+#pragma pack(push, 1)
+	struct SourceTypeEntry
+	{
+		enum Kind : uint32_t
+		{
+			Input      = 0,
+			Filter     = 1,
+			Transition = 2,
+		};
+
+		uint32_t kind         = Input;
+		uint32_t id           = 0;
+		uint32_t display_name = 0;
+		uint32_t output_flags = 0;
+		int32_t  icon_type    = 0;
+	};
+#pragma pack(pop)
+} // namespace obs
@@ -0,0 +1,67 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <cstring>
+#include <inttypes.h>
+#include <map>
+#include <string>
+#include <vector>
+
+namespace obs
+{
+	// Strings sent next to a packed list, referenced by byte offset. Every
+	// distinct string is stored once, NUL terminated, and offset 0 is always
+	// the empty string.
+	class StringTable
+	{
+		public:
+		StringTable() : data(1, '\0')
+		{
+			offsets.emplace(std::string(), 0);
+		}
+
+		uint32_t intern(const std::string& value)
+		{
+			auto found = offsets.find(value);
+			if (found != offsets.end())
+				return found->second;
+
+			uint32_t offset = uint32_t(data.size());
+			data.insert(data.end(), value.begin(), value.end());
+			data.push_back('\0');
+			offsets.emplace(value, offset);
+			return offset;
+		}
+
+		// Reads the string at `offset` of a received table, an offset out of
+		// range reads as the empty string.
+		static std::string read(const std::vector<char>& table, uint32_t offset)
+		{
+			if (offset >= table.size())
+				return std::string();
+			const char* begin = table.data() + offset;
+			return std::string(begin, strnlen(begin, table.size() - offset));
+		}
+
+		std::vector<char> data;
+
+		private:
+		std::map<std::string, uint32_t> offsets;
+	};
+} // namespace obs
@@ -0,0 +1,144 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include <inttypes.h>
+#include <cstring>
+#include <vector>
+
+namespace obs
+{
+	// Wire layout of a scene item transform, shared by client and server.
+	// Only the fields flagged in `mask` are applied by SceneItem.SetTransform,
+	// the server always answers with every field filled in.
+#pragma pack(push, 1)
+	struct Transform
+	{
+		enum Field : uint32_t
+		{
+			Position        = 1 << 0,
+			Rotation        = 1 << 1,
+			Scale           = 1 << 2,
+			Alignment       = 1 << 3,
+			Bounds          = 1 << 4,
+			BoundsType      = 1 << 5,
+			BoundsAlignment = 1 << 6,
+			Crop            = 1 << 7,
+			ScaleFilter     = 1 << 8,
+
+			All = 0x1FF,
+		};
+
+		uint32_t mask = 0;
+
+		float    position_x       = 0;
+		float    position_y       = 0;
+		float    rotation         = 0;
+		float    scale_x          = 1;
+		float    scale_y          = 1;
+		uint32_t alignment        = 0;
+		float    bounds_x         = 0;
+		float    bounds_y         = 0;
+		int32_t  bounds_type      = 0;
+		uint32_t bounds_alignment = 0;
+		int32_t  crop_left        = 0;
+		int32_t  crop_top         = 0;
+		int32_t  crop_right       = 0;
+		int32_t  crop_bottom      = 0;
+		int32_t  scale_filter     = 0;
+
+		bool has(Field field) const
+		{
+			return (mask & field) != 0;
+		}
+
+		std::vector<char> serialize() const
+		{
+			std::vector<char> buf(sizeof(Transform));
+			std::memcpy(buf.data(), this, sizeof(Transform));
+			return buf;
+		}
+
+		bool read(std::vector<char> const& buf)
+		{
+			if (buf.size() != sizeof(Transform))
+				return false;
+			std::memcpy(this, buf.data(), sizeof(Transform));
+			return true;
+		}
+	};
+
+	// One entry of a Scene.CommitEdit batch. Transform fields follow the
+	// transform mask, visibility and order follow `flags`.
+	struct SceneItemEdit
+	{
+		enum Flag : uint32_t
+		{
+			Visible = 1 << 0,
+			Order   = 1 << 1,
+		};
+
+		uint64_t  item_id        = 0;
+		uint32_t  flags          = 0;
+		int32_t   visible        = 1;
+		int32_t   order_position = 0;
+		Transform transform;
+
+		bool has(Flag flag) const
+		{
+			return (flags & flag) != 0;
+		}
+	};
+
+	// One entry of the item list returned by Scene.GetItems and
+	// Scene.GetItemsInRange, in scene order.
+	struct SceneItemRef
+	{
+		uint64_t uid     = UINT64_MAX;
+		int64_t  item_id = 0;
+	};
+
+	// One entry of an Input.SetFilterChain request, in filter order. The
+	// server answers with the resulting order as a plain list of uids.
+	struct FilterChainEntry
+	{
+		uint64_t uid     = UINT64_MAX;
+		int32_t  enabled = 1;
+	};
+#pragma pack(pop)
+
+	template<typename T>
+	std::vector<char> serialize_list(std::vector<T> const& list)
+	{
+		std::vector<char> buf(list.size() * sizeof(T));
+		if (!list.empty())
+			std::memcpy(buf.data(), list.data(), buf.size());
+		return buf;
+	}
+
+	template<typename T>
+	bool read_list(std::vector<char> const& buf, std::vector<T>& list)
+	{
+		if (buf.size() % sizeof(T) != 0)
+			return false;
+		list.resize(buf.size() / sizeof(T));
+		if (!list.empty())
+			std::memcpy(list.data(), buf.data(), buf.size());
+		return true;
+	}
+} // namespace obs
@@ -0,0 +1,44 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include "obs-transform.hpp"
+
+namespace obs
+{
+	// Outcome of a Transition.Prepare, published once through the callback
+	// poll. `ready` of `total` video sources of the target had produced a
+	// frame when the preparation ended.
+#pragma pack(push, 1)
+	struct TransitionReadiness
+	{
+		enum State : uint32_t
+		{
+			Ready     = 1,
+			TimedOut  = 2,
+			Cancelled = 3,
+		};
+
+		uint64_t transition = UINT64_MAX;
+		uint64_t target     = UINT64_MAX;
+		uint32_t state      = 0;
+		uint32_t ready      = 0;
+		uint32_t total      = 0;
+	};
+#pragma pack(pop)
+} // namespace obs
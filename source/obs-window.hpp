@@ -0,0 +1,83 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+#pragma once
+#include "obs-transform.hpp"
+
+namespace obs
+{
+	// Encoding of the image bytes of a window thumbnail. `Source` keeps what
+	// the capture plugin produced as long as no scaling is needed.
+	enum class ThumbFormat : uint32_t
+	{
+		Source = 0,
+		BGRA   = 1,
+		PNG    = 2,
+		JPEG   = 3,
+	};
+
+#pragma pack(push, 1)
+	// A thumbnail the client already holds, sent along with
+	// LONGISLAND_content_getWindowThumbs so unchanged windows are skipped.
+	struct WindowThumbKnown
+	{
+		int64_t  window_id = 0;
+		uint64_t hash      = 0;
+	};
+
+	// Per window answer of LONGISLAND_content_getWindowThumbs. Every changed
+	// thumbnail is followed by one Binary value with its image bytes, in the
+	// order of this list; unchanged ones carry no image, and their size and
+	// format are not those of the image the client holds. BGRA images are
+	// tightly packed, `width` * 4 bytes per row.
+	struct WindowThumb
+	{
+		int64_t  window_id = 0;
+		uint32_t width     = 0;
+		uint32_t height    = 0;
+		uint64_t hash      = 0;
+		uint32_t changed   = 0;
+		uint32_t format    = uint32_t(ThumbFormat::Source);
+	};
+
+	// One window of LONGISLAND_settings_getWindowLists. Names are offsets
+	// into the obs::StringTable sent next to the list. In a partial answer
+	// `change` tells what happened to the window since the revision the
+	// client asked with, closed windows only carry their id.
+	struct WindowEntry
+	{
+		enum Change : uint32_t
+		{
+			Opened  = 1 << 0,
+			Closed  = 1 << 1,
+			Moved   = 1 << 2,
+			Renamed = 1 << 3,
+		};
+
+		int64_t  window_id   = 0;
+		int64_t  owner_pid   = 0;
+		int32_t  x           = 0;
+		int32_t  y           = 0;
+		int32_t  width       = 0;
+		int32_t  height      = 0;
+		uint32_t window_name = 0;
+		uint32_t owner_name  = 0;
+		uint32_t change      = 0;
+	};
+#pragma pack(pop)
+} // namespace obs
@@ -0,0 +1,135 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+// Checks that every subscriber of an osn::EventLog sees every event once,
+// in order, while events are pushed and read from several threads.
+
+#include <atomic>
+#include <cstdio>
+#include <thread>
+#include <vector>
+#include "osn-event-log.hpp"
+
+namespace
+{
+	int failures = 0;
+
+	void check(bool condition, const char* what)
+	{
+		if (!condition) {
+			std::fprintf(stderr, "failed: %s\n", what);
+			failures++;
+		}
+	}
+} // namespace
+
+int main()
+{
+	{
+		osn::EventLog<int> log(8);
+		log.Push(1);
+		check(log.Read(1).empty(), "events without subscribers are dropped");
+
+		uint64_t ui = osn::EventSubscribers::Subscribe();
+		log.Push(2);
+		uint64_t monitor = osn::EventSubscribers::Subscribe();
+		log.Push(3);
+
+		std::vector<int> seen = log.Read(ui);
+		check(seen == std::vector<int>({2, 3}), "first subscriber sees everything since it subscribed");
+		seen = log.Read(monitor);
+		check(seen == std::vector<int>({3}), "second subscriber starts where it subscribed");
+		check(log.Read(ui).empty() && log.Read(monitor).empty(), "read events are not returned again");
+
+		log.Push(std::vector<int>({4, 5, 6}));
+		check(log.Read(ui, 2) == std::vector<int>({4, 5}), "limit");
+		check(log.Read(ui) == std::vector<int>({6}), "rest after limit");
+		check(log.Read(monitor) == std::vector<int>({4, 5, 6}), "reading does not steal from others");
+
+		// A stalled subscriber loses the oldest events past the capacity.
+		for (int i = 0; i < 20; i++) {
+			log.Push(100 + i);
+			log.Read(ui);
+		}
+		seen = log.Read(monitor);
+		check(seen.size() == 8 && seen.front() == 112 && seen.back() == 119, "capacity bounds a stalled subscriber");
+
+		osn::EventSubscribers::Unsubscribe(monitor);
+		log.Push(7);
+		check(log.Read(monitor).empty(), "unsubscribed");
+		check(log.Read(ui) == std::vector<int>({7}), "remaining subscriber unaffected");
+		osn::EventSubscribers::Unsubscribe(ui);
+	}
+
+	// Several producers and subscribers at once: each subscriber must see
+	// every producer's events exactly once and in order.
+	{
+		const int          producers    = 3;
+		const int          per_producer = 20000;
+		osn::EventLog<int> log(1 << 20);
+
+		std::vector<uint64_t> subscribers;
+		for (int i = 0; i < 3; i++)
+			subscribers.push_back(osn::EventSubscribers::Subscribe());
+
+		std::atomic<int>         finished{0};
+		std::vector<std::thread> threads;
+		for (int p = 0; p < producers; p++) {
+			threads.emplace_back([&, p] {
+				for (int i = 0; i < per_producer; i++)
+					log.Push(p * per_producer + i);
+				finished++;
+			});
+		}
+
+		std::atomic<int> broken{0};
+		for (uint64_t subscriber : subscribers) {
+			threads.emplace_back([&, subscriber] {
+				std::vector<int> last(producers, -1);
+				int              count = 0;
+				while (true) {
+					bool             done   = finished == producers;
+					std::vector<int> events = log.Read(subscriber);
+					for (int event : events) {
+						int p = event / per_producer;
+						if (event <= last[p])
+							broken++;
+						last[p] = event;
+						count++;
+					}
+					if (done && events.empty())
+						break;
+				}
+				if (count != producers * per_producer)
+					broken++;
+			});
+		}
+
+		for (auto& thread : threads)
+			thread.join();
+		check(broken == 0, "concurrent subscribers see every event once and in order");
+
+		for (uint64_t subscriber : subscribers)
+			osn::EventSubscribers::Unsubscribe(subscriber);
+	}
+
+	if (failures)
+		return 1;
+	std::printf("event log ok\n");
+	return 0;
+}
@@ -0,0 +1,156 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+// Checks that readers of the frame stats page never see a mix of two
+// writes while a writer publishes as fast as it can. Standalone, needs
+// neither libobs nor the IPC library:
+//
+//   cmake -S tests/native -B build-native-tests
+//   cmake --build build-native-tests && ctest --test-dir build-native-tests
+
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <new>
+#include <string>
+#include <thread>
+#include <vector>
+#include "obs-frame-stats.hpp"
+#include "obs-shared-memory.hpp"
+#ifdef WIN32
+#include <windows.h>
+#else
+#include <unistd.h>
+#endif
+
+namespace
+{
+	// Every field of write `k` is derived from `k`, a torn read shows up as
+	// fields that disagree.
+	obs::FrameStats make_stats(uint64_t k)
+	{
+		obs::FrameStats stats;
+		stats.render_total       = k;
+		stats.render_lagged      = k * 3;
+		stats.video_total        = k * 5;
+		stats.video_skipped      = k * 7;
+		stats.output_total       = k * 11;
+		stats.output_dropped     = k * 13;
+		stats.output_congestion  = double(k) / 2;
+		stats.active_fps         = double(k) * 4;
+		stats.average_frame_time = k * 17;
+		stats.updated            = ~k;
+		return stats;
+	}
+
+	bool consistent(const obs::FrameStats& stats)
+	{
+		const uint64_t  k        = stats.render_total;
+		obs::FrameStats expected = make_stats(k);
+		return stats.render_lagged == expected.render_lagged && stats.video_total == expected.video_total
+		       && stats.video_skipped == expected.video_skipped && stats.output_total == expected.output_total
+		       && stats.output_dropped == expected.output_dropped
+		       && stats.output_congestion == expected.output_congestion
+		       && stats.active_fps == expected.active_fps
+		       && stats.average_frame_time == expected.average_frame_time && stats.updated == expected.updated;
+	}
+} // namespace
+
+int main()
+{
+#ifdef WIN32
+	std::string name = "osn-stats-test-" + std::to_string(GetCurrentProcessId());
+#else
+	std::string name = "osn-stats-test-" + std::to_string(getpid());
+#endif
+
+	obs::SharedMemory writer_memory;
+	if (!writer_memory.create(name, sizeof(obs::FrameStatsPage))) {
+		std::fprintf(stderr, "failed to create the shared page\n");
+		return 1;
+	}
+	obs::FrameStatsPage* page = new (writer_memory.data()) obs::FrameStatsPage();
+
+	obs::SharedMemory reader_memory;
+	if (!reader_memory.open(name, sizeof(obs::FrameStatsPage))) {
+		std::fprintf(stderr, "failed to open the shared page\n");
+		return 1;
+	}
+	const obs::FrameStatsPage* view = static_cast<const obs::FrameStatsPage*>(reader_memory.data());
+	if (!view->valid()) {
+		std::fprintf(stderr, "shared page has no valid header\n");
+		return 1;
+	}
+
+	const auto            duration = std::chrono::milliseconds(1500);
+	std::atomic<bool>     running{true};
+	std::atomic<uint64_t> torn{0};
+	std::atomic<uint64_t> backwards{0};
+	std::atomic<uint64_t> reads{0};
+	std::atomic<uint64_t> busy{0};
+
+	std::thread writer([&] {
+		for (uint64_t k = 1; running.load(std::memory_order_relaxed); k++)
+			page->write(make_stats(k));
+	});
+
+	size_t                   reader_count = std::max(2u, std::thread::hardware_concurrency() - 1);
+	std::vector<std::thread> readers;
+	for (size_t idx = 0; idx < reader_count; idx++) {
+		readers.emplace_back([&] {
+			uint64_t last = 0;
+			while (running.load(std::memory_order_relaxed)) {
+				obs::FrameStats stats;
+				if (!view->read(stats)) {
+					busy++;
+					continue;
+				}
+				reads++;
+				if (!consistent(stats))
+					torn++;
+				if (stats.render_total < last)
+					backwards++;
+				last = stats.render_total;
+			}
+		});
+	}
+
+	std::this_thread::sleep_for(duration);
+	running = false;
+	writer.join();
+	for (auto& reader : readers)
+		reader.join();
+
+	obs::FrameStats final_stats;
+	bool            final_read = view->read(final_stats) && consistent(final_stats);
+
+	std::printf(
+	    "%zu readers, %llu reads, %llu busy, %llu torn, %llu out of order\n",
+	    reader_count,
+	    (unsigned long long)reads.load(),
+	    (unsigned long long)busy.load(),
+	    (unsigned long long)torn.load(),
+	    (unsigned long long)backwards.load());
+
+	page->~FrameStatsPage();
+	if (torn || backwards || !reads || !final_read) {
+		std::fprintf(stderr, "frame stats page is not consistent under concurrent writes\n");
+		return 1;
+	}
+	return 0;
+}
@@ -0,0 +1,99 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+
+// Checks that Input.CreateBulk requests and answers survive a round trip and
+// that truncated or inflated buffers are rejected before anything is
+// reserved for them.
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+#include "obs-import.hpp"
+
+namespace
+{
+	int failures = 0;
+
+	void check(bool condition, const char* what)
+	{
+		if (!condition) {
+			std::fprintf(stderr, "failed: %s\n", what);
+			failures++;
+		}
+	}
+
+	void set_count(std::vector<char>& buf, uint32_t count)
+	{
+		std::memcpy(buf.data(), &count, sizeof(count));
+	}
+} // namespace
+
+int main()
+{
+	std::vector<obs::InputDefinition> definitions(3);
+	for (size_t idx = 0; idx < definitions.size(); idx++) {
+		definitions[idx].type     = "image_source";
+		definitions[idx].name     = "input" + std::to_string(idx);
+		definitions[idx].settings = "{}";
+		definitions[idx].filters.push_back({"crop_filter", "crop", "{}", true});
+		definitions[idx].placements.push_back({7, false, obs::Transform()});
+	}
+
+	std::vector<char>                 buf = obs::serialize_definitions(definitions);
+	std::vector<obs::InputDefinition> decoded;
+	check(obs::read_definitions(buf, decoded), "definitions round trip");
+	check(decoded.size() == 3 && decoded[2].name == "input2", "definitions keep their names");
+	check(decoded.size() == 3 && decoded[1].filters.size() == 1 && decoded[1].placements.size() == 1
+	          && decoded[1].placements[0].scene == 7 && !decoded[1].placements[0].visible,
+	      "definitions keep filters and placements");
+
+	std::vector<char> truncated(buf.begin(), buf.end() - 1);
+	check(!obs::read_definitions(truncated, decoded), "truncated definitions are rejected");
+
+	std::vector<char> inflated = buf;
+	set_count(inflated, UINT32_MAX);
+	check(!obs::read_definitions(inflated, decoded), "inflated definition count is rejected");
+	check(decoded.capacity() < 1024, "nothing is reserved for an inflated definition count");
+
+	std::vector<char> empty_count(sizeof(uint32_t) - 1);
+	check(!obs::read_definitions(empty_count, decoded), "definitions without a count are rejected");
+
+	std::vector<obs::InputImportResult> results(2);
+	results[0].uid = 11;
+	results[0].filters.push_back(12);
+	results[0].items.push_back({13, 14});
+
+	buf = obs::serialize_results(results);
+	std::vector<obs::InputImportResult> decoded_results;
+	check(obs::read_results(buf, decoded_results), "results round trip");
+	check(decoded_results.size() == 2 && decoded_results[0].uid == 11 && decoded_results[0].items.size() == 1
+	          && decoded_results[0].items[0].obs_id == 14 && decoded_results[1].uid == UINT64_MAX,
+	      "results keep their content");
+
+	inflated = buf;
+	set_count(inflated, 1u << 30);
+	std::vector<obs::InputImportResult> inflated_results;
+	check(!obs::read_results(inflated, inflated_results), "inflated result count is rejected");
+	check(inflated_results.capacity() == 0, "nothing is reserved for an inflated result count");
+
+	if (failures)
+		return 1;
+	std::printf("import codec ok\n");
+	return 0;
+}
@@ -0,0 +1,116 @@
+/******************************************************************************
+    Copyright (C) 2016-2019 by Streamlabs (General Workings Inc)
+
+    This program is free software: you can redistribute it and/or modify
+    it under the terms of the GNU General Public License as published by
+    the Free Software Foundation, either version 2 of the License, or
+    (at your option) any later version.
+
+    This program is distributed in the hope that it will be useful,
+    but WITHOUT ANY WARRANTY; without even the implied warranty of
+    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+    GNU General Public License for more details.
+
+    You should have received a copy of the GNU General Public License
+    along with this program.  If not, see <http://www.gnu.org/licenses/>.
+
+******************************************************************************/
+
+// Checks the bucket layout and percentiles of obs::TimingHistogram against
+// exact values computed from the same frame times.
+
+#include <algorithm>
+#include <cstdio>
+#include <random>
+#include <vector>
+#include "obs-render-timing.hpp"
+
+namespace
+{
+	int failures = 0;
+
+	void check(bool condition, const char* what)
+	{
+		if (!condition) {
+			std::fprintf(stderr, "failed: %s\n", what);
+			failures++;
+		}
+	}
+
+	// A percentile may only be rounded up, by less than one bucket width.
+	bool close_above(uint64_t value, uint64_t exact)
+	{
+		return value >= exact && value <= exact + exact / obs::TimingHistogram::sub_count + 1;
+	}
+} // namespace
+
+int main()
+{
+	using obs::TimingHistogram;
+
+	// Every value lands in a bucket whose bounds contain it.
+	for (uint64_t usec = 0; usec < 5000000; usec += (usec < 4096 ? 1 : 997)) {
+		size_t idx = TimingHistogram::index(usec);
+		if (idx >= TimingHistogram::bucket_count || TimingHistogram::upper_bound(idx) < usec
+		    || (idx > 0 && TimingHistogram::upper_bound(idx - 1) >= usec)) {
+			std::fprintf(stderr, "bad bucket %zu for %llu us\n", idx, (unsigned long long)usec);
+			failures++;
+			break;
+		}
+	}
+	check(TimingHistogram::index(UINT64_MAX) == TimingHistogram::bucket_count - 1, "huge values are clamped");
+
+	// Mostly 4-8 ms frames with a tail of stutters past a 16.6 ms budget.
+	std::mt19937                            rng(42);
+	std::uniform_int_distribution<uint64_t> normal(4000, 8000);
+	std::uniform_int_distribution<uint64_t> stutter(17000, 50000);
+
+	std::vector<uint64_t> values;
+	for (int i = 0; i < 20000; i++)
+		values.push_back((i % 50 == 0) ? stutter(rng) : normal(rng));
+
+	const uint64_t  budget = 16667;
+	TimingHistogram histogram;
+	TimingHistogram first_half;
+	TimingHistogram second_half;
+	for (size_t i = 0; i < values.size(); i++) {
+		histogram.add(values[i], 1, budget);
+		(i < values.size() / 2 ? first_half : second_half).add(values[i], 1, budget);
+	}
+	std::sort(values.begin(), values.end());
+
+	auto exact = [&values](double p) { return values[size_t(p * values.size() + 0.999999) - 1]; };
+	check(close_above(histogram.percentile(0.50), exact(0.50)), "p50");
+	check(close_above(histogram.percentile(0.95), exact(0.95)), "p95");
+	check(close_above(histogram.percentile(0.99), exact(0.99)), "p99");
+	check(histogram.percentile(1.0) == values.back(), "p100 is the exact maximum");
+
+	uint64_t over  = std::count_if(values.begin(), values.end(), [&](uint64_t v) { return v > budget; });
+	uint64_t over2 = std::count_if(values.begin(), values.end(), [&](uint64_t v) { return v > budget * 2; });
+	obs::RenderTiming timing = histogram.summary(budget * 1000, 1000000000);
+	check(timing.frames == values.size(), "frame count");
+	check(timing.over_budget == over, "over budget count");
+	check(timing.over_twice_budget == over2, "over twice budget count");
+	check(timing.max == values.back() * 1000, "max in nanoseconds");
+	check(timing.p50 <= timing.p95 && timing.p95 <= timing.p99 && timing.p99 <= timing.max, "ordered percentiles");
+
+	// Merging the two halves gives the same histogram.
+	TimingHistogram merged = first_half;
+	merged.merge(second_half);
+	check(merged.buckets == histogram.buckets && merged.total == histogram.total, "merge");
+
+	obs::RenderTiming copy;
+	check(copy.read(timing.serialize()) && copy.p99 == timing.p99, "wire round trip");
+
+	histogram.clear();
+	check(histogram.summary(budget * 1000, 0).frames == 0 && histogram.percentile(0.5) == 0, "clear");
+
+	if (failures)
+		return 1;
+	std::printf("histogram ok, p50 %llu p95 %llu p99 %llu max %llu us\n",
+	    (unsigned long long)timing.p50 / 1000,
+	    (unsigned long long)timing.p95 / 1000,
+	    (unsigned long long)timing.p99 / 1000,
+	    (unsigned long long)timing.max / 1000);
+	return 0;
+}
@@ -153,6 +153,36 @@ describe(testName, function() {
         scene.release();
     });
 
+    it('Set shutdown grace period', function() {
+        expect(function() {
+            osn.NodeObs.SetShutdownGracePeriod(1000);
+        }).to.not.throw();
+
+        expect(function() {
+            osn.NodeObs.SetShutdownGracePeriod('1000');
+        }).to.throw();
+    });
+
+    it('Benchmark callback payloads', function() {
+        // Only exported by test builds, configured with OSN_CLIENT_BENCHMARKS
+        if (osn.NodeObs.BenchmarkCallbackPayloads === undefined) {
+            logInfo(testName, 'Payload benchmarks are not built, skip test case');
+            this.skip();
+        }
+
+        let results: any;
+
+        expect(function() {
+            results = osn.NodeObs.BenchmarkCallbackPayloads(2000);
+        }).to.not.throw();
+
+        for (const payload of ['sources', 'volmeter']) {
+            logInfo(testName, payload + ' payload: ' + Math.round(results[payload].current) + ' objects/s, ' +
+                Math.round(results[payload].baseline) + ' objects/s before');
+            expect(results[payload].current).to.be.above(0, GetErrorMessage(ETestErrorMsg.CallbackPayloads, payload));
+        }
+    });
+
     it('Stop crash handler', function() {
         // Stopping crash handler as a last test case
         expect(function() {
@@ -0,0 +1,183 @@
+import 'mocha';
+import { expect } from 'chai';
+import * as fs from 'fs';
+import * as os from 'os';
+import * as path from 'path';
+import * as osn from '../osn';
+import { logInfo, logEmptyLine } from '../util/logger';
+import { ETestErrorMsg, GetErrorMessage } from '../util/error_messages';
+import { EOBSInputTypes, EOBSFilterTypes } from '../util/obs_enums';
+import { OBSHandler } from '../util/obs_handler';
+import { deleteConfigFiles, sleep } from '../util/general';
+
+const testName = 'osn-collection';
+
+describe(testName, () => {
+    let obs: OBSHandler;
+    let hasTestFailed: boolean = false;
+    const collectionPath = path.join(os.tmpdir(), 'osn-collection-test.json');
+    const snapshotPath = path.join(os.tmpdir(), 'osn-collection-test.snap');
+
+    // Initialize OBS process
+    before(function() {
+        logInfo(testName, 'Starting ' + testName + ' tests');
+        deleteConfigFiles();
+        obs = new OBSHandler(testName);
+    });
+
+    // Shutdown OBS process
+    after(async function() {
+        obs.shutdown();
+
+        if (hasTestFailed === true) {
+            logInfo(testName, 'One or more test cases failed. Uploading cache');
+            await obs.uploadTestCache();
+        }
+
+        [collectionPath, collectionPath + '.bak', snapshotPath, snapshotPath + '.bak'].forEach(function(file) {
+            if (fs.existsSync(file)) {
+                fs.unlinkSync(file);
+            }
+        });
+
+        obs = null;
+        deleteConfigFiles();
+        logInfo(testName, 'Finished ' + testName + ' tests');
+        logEmptyLine();
+    });
+
+    afterEach(function() {
+        if (this.currentTest.state == 'failed') {
+            hasTestFailed = true;
+        }
+    });
+
+    it('Save a scene collection and load it back', () => {
+        const inputCount = 100;
+        const sceneName = 'collection_test_scene';
+
+        // Creating the collection
+        const scene = osn.SceneFactory.create(sceneName);
+        expect(scene).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateScene, sceneName));
+
+        for (let i = 0; i < inputCount; i++) {
+            const input = osn.InputFactory.create(EOBSInputTypes.ImageSource, 'collection_input' + i);
+            expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.ImageSource));
+
+            const filter = osn.FilterFactory.create(EOBSFilterTypes.Crop, 'collection_filter' + i);
+            input.addFilter(filter);
+            filter.release();
+
+            scene.add(input).position = {x: i, y: i};
+        }
+
+        // Saving it
+        osn.Collection.save(collectionPath);
+        osn.Collection.flush();
+        expect(fs.existsSync(collectionPath)).to.equal(true);
+
+        // Removing the collection
+        scene.getItems().forEach(function(sceneItem) {
+            const input = sceneItem.source;
+            sceneItem.remove();
+            input.remove();
+            input.release();
+        });
+        scene.release();
+
+        // Loading it back
+        const content = osn.Collection.load(collectionPath);
+
+        // Checking if every source was restored
+        expect(content.inputs.length).to.equal(inputCount);
+        expect(content.scenes.length).to.equal(1);
+        expect(content.scenes[0].name).to.equal(sceneName, GetErrorMessage(ETestErrorMsg.SceneName, sceneName));
+
+        const loadedScene = content.scenes[0];
+        const sceneItems = loadedScene.getItems();
+        expect(sceneItems.length).to.equal(inputCount, GetErrorMessage(ETestErrorMsg.GetSceneItems, sceneName));
+
+        sceneItems.forEach(function(sceneItem) {
+            const input = sceneItem.source as osn.IInput;
+            const index = Number(input.name.replace('collection_input', ''));
+            expect(input.id).to.equal(EOBSInputTypes.ImageSource, GetErrorMessage(ETestErrorMsg.InputId, EOBSInputTypes.ImageSource));
+            expect(sceneItem.position.x).to.equal(index, GetErrorMessage(ETestErrorMsg.PositionX));
+            expect(input.filters.length).to.equal(1, GetErrorMessage(ETestErrorMsg.FindFilter, EOBSFilterTypes.Crop, input.name));
+            expect(input.filters[0].name).to.equal('collection_filter' + index, GetErrorMessage(ETestErrorMsg.FindFilter, EOBSFilterTypes.Crop, input.name));
+        });
+
+        sceneItems.forEach(function(sceneItem) {
+            sceneItem.remove();
+        });
+        content.inputs.forEach(function(input) {
+            input.remove();
+            input.release();
+        });
+        loadedScene.release();
+    });
+
+    it('Restore sources from a snapshot', async () => {
+        const inputCount = 100;
+        const sceneName = 'snapshot_test_scene';
+
+        const scene = osn.SceneFactory.create(sceneName);
+        expect(scene).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateScene, sceneName));
+
+        for (let i = 0; i < inputCount; i++) {
+            const input = osn.InputFactory.create(EOBSInputTypes.ImageSource, 'snapshot_input' + i);
+            expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.ImageSource));
+            scene.add(input).position = {x: i, y: i};
+        }
+
+        // Waiting for at least one snapshot to be written
+        osn.Collection.setSnapshot(snapshotPath, 100);
+        await sleep(500);
+        osn.Collection.setSnapshot('', 0);
+        osn.Collection.flush();
+        expect(fs.existsSync(snapshotPath)).to.equal(true);
+
+        // Removing the sources
+        scene.getItems().forEach(function(sceneItem) {
+            const input = sceneItem.source;
+            sceneItem.remove();
+            input.remove();
+            input.release();
+        });
+        scene.release();
+
+        // Restoring them
+        const content = osn.Collection.restoreSnapshot(snapshotPath);
+
+        expect(content.inputs.length).to.equal(inputCount);
+        expect(content.scenes.length).to.equal(1);
+        expect(content.scenes[0].name).to.equal(sceneName, GetErrorMessage(ETestErrorMsg.SceneName, sceneName));
+
+        const restoredScene = content.scenes[0];
+        const sceneItems = restoredScene.getItems();
+        expect(sceneItems.length).to.equal(inputCount, GetErrorMessage(ETestErrorMsg.GetSceneItems, sceneName));
+
+        sceneItems.forEach(function(sceneItem) {
+            const input = sceneItem.source as osn.IInput;
+            const index = Number(input.name.replace('snapshot_input', ''));
+            expect(sceneItem.position.x).to.equal(index, GetErrorMessage(ETestErrorMsg.PositionX));
+            sceneItem.remove();
+        });
+        content.inputs.forEach(function(input) {
+            input.remove();
+            input.release();
+        });
+        restoredScene.release();
+    });
+
+    it('Fail test - Restore a snapshot that does not exist', () => {
+        expect(function () {
+            osn.Collection.restoreSnapshot(path.join(os.tmpdir(), 'osn-collection-does-not-exist.snap'));
+        }).to.throw();
+    });
+
+    it('Fail test - Load a collection that does not exist', () => {
+        expect(function () {
+            osn.Collection.load(path.join(os.tmpdir(), 'osn-collection-does-not-exist.json'));
+        }).to.throw();
+    });
+});
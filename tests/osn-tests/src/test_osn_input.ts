@@ -56,6 +56,16 @@ describe(testName, () => {
         });
     });
 
+    it('Get input type catalog', () => {
+        const catalog = osn.InputFactory.typeCatalog();
+        expect(catalog.map(type => type.id)).to.eql(osn.InputFactory.types(), GetErrorMessage(ETestErrorMsg.InputTypeCatalog, 'ids'));
+
+        catalog.forEach(function(type) {
+            expect(type.name).to.be.a('string', GetErrorMessage(ETestErrorMsg.InputTypeCatalog, type.id));
+            expect(type.outputFlags).to.equal(osn.Global.getOutputFlagsFromId(type.id), GetErrorMessage(ETestErrorMsg.InputTypeCatalog, type.id));
+        });
+    });
+
     it('Create all types of input with settings parameter', () => {
         // Create all input sources available
         obs.inputTypes.forEach(function(inputType) {
@@ -616,6 +626,95 @@ describe(testName, () => {
         input.release();
     });
 
+    it('Replace the filter chain in a single call', () => {
+        const input = osn.InputFactory.create(EOBSInputTypes.ImageSource, 'test_source');
+        expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.ImageSource));
+
+        const filter1 = osn.FilterFactory.create(EOBSFilterTypes.Color, 'filter1');
+        const filter2 = osn.FilterFactory.create(EOBSFilterTypes.Crop, 'filter2');
+        const filter3 = osn.FilterFactory.create(EOBSFilterTypes.GPUDelay, 'filter3');
+        const filter4 = osn.FilterFactory.create(EOBSFilterTypes.Sharpness, 'filter4');
+
+        input.addFilter(filter1);
+        input.addFilter(filter2);
+        input.addFilter(filter3);
+
+        // Drops filter2, adds filter4, reorders and disables filter1
+        const order = input.setFilterChain([
+            { filter: filter3 },
+            { filter: filter4 },
+            { filter: filter1, enabled: false },
+        ]);
+
+        expect(order.map(filter => filter.name)).to.eql(['filter3', 'filter4', 'filter1']);
+        expect(input.filters.map(filter => filter.name)).to.eql(['filter3', 'filter4', 'filter1']);
+        expect(filter1.enabled).to.equal(false);
+        expect(filter3.enabled).to.equal(true);
+
+        // An empty chain detaches everything
+        expect(input.setFilterChain([]).length).to.equal(0);
+        expect(input.filters.length).to.equal(0);
+
+        filter1.release();
+        filter2.release();
+        filter3.release();
+        filter4.release();
+        input.release();
+    });
+
+    it('Create inputs with filters and scene items in a single call', () => {
+        const inputCount = 50;
+        const scene = osn.SceneFactory.create('createBulk_test_scene');
+
+        // Checking if scene was created correctly
+        expect(scene).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateScene, 'createBulk_test_scene'));
+
+        // Importing the collection in a single call
+        const definitions: osn.IInputDefinition[] = [];
+        for (let i = 0; i < inputCount; i++) {
+            definitions.push({
+                id: EOBSInputTypes.ImageSource,
+                name: 'bulk_input' + i,
+                settings: {unload: true},
+                filters: [{id: EOBSFilterTypes.Crop, name: 'bulk_filter' + i, enabled: i % 2 == 0}],
+                placements: [{scene: scene, position: {x: i, y: i * 2}, visible: false}],
+            });
+        }
+
+        const results = osn.InputFactory.createBulk(definitions);
+
+        // Checking if every input was created with its filter and scene item
+        expect(results.length).to.equal(inputCount);
+        results.forEach(function(result, i) {
+            expect(result.input).to.not.equal(null, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.ImageSource));
+            expect(result.input.id).to.equal(EOBSInputTypes.ImageSource, GetErrorMessage(ETestErrorMsg.InputId, EOBSInputTypes.ImageSource));
+            expect(result.input.name).to.equal('bulk_input' + i, GetErrorMessage(ETestErrorMsg.InputName, EOBSInputTypes.ImageSource));
+            expect(result.input.settings['unload']).to.equal(true, GetErrorMessage(ETestErrorMsg.InputSetting, EOBSInputTypes.ImageSource));
+
+            expect(result.filters.length).to.equal(1, GetErrorMessage(ETestErrorMsg.CreateFilter, EOBSFilterTypes.Crop));
+            expect(result.input.filters[0].name).to.equal('bulk_filter' + i, GetErrorMessage(ETestErrorMsg.FindFilter, EOBSFilterTypes.Crop, 'bulk_input' + i));
+            expect(result.filters[0].enabled).to.equal(i % 2 == 0);
+
+            expect(result.items.length).to.equal(1, GetErrorMessage(ETestErrorMsg.AddSourceToScene, 'bulk_input' + i, 'createBulk_test_scene'));
+            expect(result.items[0].source.name).to.equal('bulk_input' + i, GetErrorMessage(ETestErrorMsg.SceneItemInputName, 'bulk_input' + i));
+            expect(result.items[0].position.x).to.equal(i, GetErrorMessage(ETestErrorMsg.PositionX));
+            expect(result.items[0].position.y).to.equal(i * 2, GetErrorMessage(ETestErrorMsg.PositionY));
+            expect(result.items[0].visible).to.equal(false, GetErrorMessage(ETestErrorMsg.Visible));
+        });
+        expect(scene.getItems().length).to.equal(inputCount, GetErrorMessage(ETestErrorMsg.GetSceneItems, 'createBulk_test_scene'));
+
+        scene.getItems().forEach(function(sceneItem) {
+            const input = sceneItem.source as osn.IInput;
+            input.filters.forEach(function(filter) {
+                input.removeFilter(filter);
+                filter.release();
+            });
+            sceneItem.source.release();
+            sceneItem.remove();
+        });
+        scene.release();
+    });
+
     it('Fail test - Try to find an input that does not exist', () => {
         let inputFromName: IInput;
 
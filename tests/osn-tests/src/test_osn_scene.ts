@@ -3,7 +3,7 @@ import { expect } from 'chai'
 import * as osn from '../osn';
 import { logInfo, logEmptyLine } from '../util/logger';
 import { OBSHandler } from '../util/obs_handler';
-import { deleteConfigFiles } from '../util/general';
+import { deleteConfigFiles, sleep } from '../util/general';
 import { EOBSInputTypes } from '../util/obs_enums';
 import { ETestErrorMsg, GetErrorMessage } from '../util/error_messages';
 
@@ -278,6 +278,11 @@ describe(testName, () => {
         expect(orderedSceneItems[0].source.name).to.equal(firstInputName, ETestErrorMsg.SceneItemPositionAfterMove);
         expect(orderedSceneItems[1].source.name).to.equal(secondInputName, ETestErrorMsg.SceneItemPositionAfterMove);
 
+        // Getting the ids of all scene items
+        const itemIds = scene.getItemIds();
+        expect(itemIds).to.be.an.instanceof(Float64Array);
+        expect(Array.from(itemIds)).to.eql(orderedSceneItems.map(sceneItem => sceneItem.id), GetErrorMessage(ETestErrorMsg.GetSceneItems, sceneName));
+
         firstSceneItem.source.release();
         firstSceneItem.remove();
         secondSceneItem.source.release();
@@ -329,4 +334,114 @@ describe(testName, () => {
 
         scene.release();
     });
+
+    it('Apply a 100 item layout in a single scene edit', () => {
+        const sceneName = 'commitEdit_test_scene';
+        const itemCount = 100;
+
+        // Creating scene
+        const scene = osn.SceneFactory.create(sceneName);
+
+        // Checking if scene was created correctly
+        expect(scene).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateScene, sceneName));
+
+        // Creating the items of the layout
+        const sceneItems: osn.ISceneItem[] = [];
+        for (let i = 0; i < itemCount; i++) {
+            const input = osn.InputFactory.create(EOBSInputTypes.ImageSource, 'commitEdit_input' + i);
+            expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.ImageSource));
+            sceneItems.push(scene.add(input));
+        }
+
+        // Applying the layout in a single scene edit
+        scene.beginEdit();
+        sceneItems.forEach(function(sceneItem, i) {
+            scene.editItem(sceneItem, {position: {x: i * 10, y: i * 5}, scale: {x: 0.25, y: 0.25}, rotation: 90, visible: true});
+        });
+        scene.commitEdit();
+
+        // Checking if the layout was applied to every item
+        sceneItems.forEach(function(sceneItem, i) {
+            expect(sceneItem.position.x).to.equal(i * 10, GetErrorMessage(ETestErrorMsg.PositionX));
+            expect(sceneItem.position.y).to.equal(i * 5, GetErrorMessage(ETestErrorMsg.PositionY));
+            expect(sceneItem.scale.x).to.equal(0.25, GetErrorMessage(ETestErrorMsg.ScaleX));
+            expect(sceneItem.rotation).to.equal(90, GetErrorMessage(ETestErrorMsg.Rotation));
+        });
+
+        sceneItems.forEach(function(sceneItem) {
+            sceneItem.source.release();
+            sceneItem.remove();
+        });
+
+        scene.release();
+    });
+
+    it('Hit test, select and snap items of a 200 item scene', async () => {
+        const sceneName = 'spatial_test_scene';
+        const itemCount = 200;
+
+        const scene = osn.SceneFactory.create(sceneName);
+        expect(scene).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateScene, sceneName));
+
+        // A 20 x 10 grid of 80 x 40 boxes with a 20 pixel gap
+        const sceneItems: osn.ISceneItem[] = [];
+        for (let i = 0; i < itemCount; i++) {
+            const input = osn.InputFactory.create(EOBSInputTypes.ColorSource, 'spatial_input' + i, {width: 80, height: 40});
+            expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.ColorSource));
+            const sceneItem = scene.add(input);
+            sceneItem.position = {x: (i % 20) * 100, y: Math.floor(i / 20) * 60};
+            sceneItems.push(sceneItem);
+        }
+
+        // Transforms are applied by the render thread
+        await sleep(200);
+
+        const hit = scene.hitTest(250, 70);
+        expect(hit).to.not.equal(undefined);
+        expect(hit.source.name).to.equal('spatial_input22');
+        expect(scene.hitTest(290, 70)).to.equal(undefined);
+
+        const selected = scene.selectItems({x: 50, y: 10, width: 100, height: 60});
+        expect(selected.length).to.equal(4);
+        expect(selected.map(item => item.source.name)).to.have.members(['spatial_input0', 'spatial_input1', 'spatial_input20', 'spatial_input21']);
+
+        // Dragging item 0 close to the left edge of item 1
+        const offset = scene.snap({x: 13, y: 300, width: 80, height: 40}, 10, sceneItems[0]);
+        expect(offset.x).to.equal(7);
+
+        sceneItems.forEach(function(sceneItem) {
+            sceneItem.source.release();
+            sceneItem.remove();
+        });
+
+        scene.release();
+    });
+
+    it('Report the duplication time of a 200 item scene', () => {
+        const sceneName = 'dupTime_test_scene';
+        const itemCount = 200;
+
+        const scene = osn.SceneFactory.create(sceneName);
+        expect(scene).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateScene, sceneName));
+        expect(scene.duplicationTime).to.equal(0);
+
+        const sceneItems: osn.ISceneItem[] = [];
+        for (let i = 0; i < itemCount; i++) {
+            const input = osn.InputFactory.create(EOBSInputTypes.ImageSource, 'dupTime_input' + i);
+            expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.ImageSource));
+            sceneItems.push(scene.add(input));
+        }
+
+        const copy = scene.duplicate('dupTime_copy', osn.ESceneDupType.Refs);
+        expect(copy).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.DuplicateScene, sceneName));
+        expect(copy.duplicationTime).to.be.above(0);
+        expect(copy.getItems().length).to.equal(itemCount, GetErrorMessage(ETestErrorMsg.GetSceneItems, 'dupTime_copy'));
+
+        copy.release();
+        sceneItems.forEach(function(sceneItem) {
+            sceneItem.source.release();
+            sceneItem.remove();
+        });
+        scene.release();
+    });
 });
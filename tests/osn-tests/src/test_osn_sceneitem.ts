@@ -359,4 +359,46 @@ describe(testName, () => {
         sceneItem.source.release();
         sceneItem.remove();
     });
+
+    it('Set scene item transform in a single call and get it', () => {
+        let position: IVec2 = {x: 10, y: 20};
+        let scale: IVec2 = {x: 2, y: 3};
+        let rotation: number = 90;
+        let crop: ICrop = {top: 4, bottom: 6, left: 2, right: 8};
+
+        // Getting scene
+        const scene = osn.SceneFactory.fromName(sceneName);
+
+        // Getting source
+        const source = osn.InputFactory.fromName(sourceName);
+
+        // Adding input source to scene to create scene item
+        const sceneItem = scene.add(source);
+
+        // Checking if input source was added to the scene correctly
+        expect(sceneItem).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.AddSourceToScene, EOBSInputTypes.ImageSource, sceneName));
+
+        // Setting the whole transform at once
+        sceneItem.setTransform({position: position, scale: scale, rotation: rotation, crop: crop});
+
+        // Checking if every field was applied
+        expect(sceneItem.position.x).to.equal(position.x, GetErrorMessage(ETestErrorMsg.PositionX));
+        expect(sceneItem.position.y).to.equal(position.y, GetErrorMessage(ETestErrorMsg.PositionY));
+        expect(sceneItem.scale.x).to.equal(scale.x, GetErrorMessage(ETestErrorMsg.ScaleX));
+        expect(sceneItem.scale.y).to.equal(scale.y, GetErrorMessage(ETestErrorMsg.ScaleY));
+        expect(sceneItem.rotation).to.equal(rotation, GetErrorMessage(ETestErrorMsg.Rotation));
+        expect(sceneItem.crop.top).to.equal(crop.top, GetErrorMessage(ETestErrorMsg.CropTop));
+        expect(sceneItem.crop.bottom).to.equal(crop.bottom, GetErrorMessage(ETestErrorMsg.CropBottom));
+        expect(sceneItem.crop.left).to.equal(crop.left, GetErrorMessage(ETestErrorMsg.CropLeft));
+        expect(sceneItem.crop.right).to.equal(crop.right, GetErrorMessage(ETestErrorMsg.CropRight));
+
+        // Checking the server side values match the cached ones
+        const transformInfo = sceneItem.transformInfo;
+        expect(transformInfo.pos.x).to.equal(position.x, GetErrorMessage(ETestErrorMsg.PositionX));
+        expect(transformInfo.pos.y).to.equal(position.y, GetErrorMessage(ETestErrorMsg.PositionY));
+        expect(transformInfo.rot).to.equal(rotation, GetErrorMessage(ETestErrorMsg.Rotation));
+
+        sceneItem.source.release();
+        sceneItem.remove();
+    });
 });
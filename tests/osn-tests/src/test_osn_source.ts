@@ -587,6 +587,94 @@ describe(testName, () => {
         });
     });
 
+    it('Modify a property and get refreshed properties', () => {
+        const inputType = EOBSInputTypes.ColorSource;
+        const input = osn.InputFactory.create(inputType, 'input');
+
+        // Checking if input source was created correctly
+        expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, inputType));
+
+        // Updating a setting and notifying its property
+        let settings: ISettings = input.settings;
+        settings['width'] = 400;
+        input.update(settings);
+
+        const width = input.properties.get('width');
+        expect(width).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.Properties, inputType));
+
+        let refresh = undefined;
+        refresh = width.modified(settings);
+        expect(refresh).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.PropertyModified, 'width', inputType));
+
+        // Updating again, the properties now come from the property session
+        settings['width'] = 500;
+        input.update(settings);
+
+        expect(input.properties.get('width').value).to.equal(500, GetErrorMessage(ETestErrorMsg.PropertyValue, 'width', inputType));
+
+        input.release();
+    });
+
+    it('Iterate over the properties of a source', () => {
+        const inputType = EOBSInputTypes.ColorSource;
+        const input = osn.InputFactory.create(inputType, 'input');
+
+        // Checking if input source was created correctly
+        expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, inputType));
+
+        const properties = input.properties;
+        expect(properties).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.Properties, inputType));
+
+        // Walking the properties, each one is also reachable by name
+        let visited = 0;
+        for (let property = properties.first(); property; property = property.next()) {
+            expect(properties.get(property.name)).to.equal(property, GetErrorMessage(ETestErrorMsg.PropertyIteration, inputType));
+            visited++;
+        }
+        expect(visited).to.equal(properties.count(), GetErrorMessage(ETestErrorMsg.PropertyIteration, inputType));
+
+        input.release();
+    });
+
+    it('Page through the items of a list property', () => {
+        const filterType = EOBSFilterTypes.Scale;
+        const filter = osn.FilterFactory.create(filterType, 'filter');
+
+        // Checking if filter source was created correctly
+        expect(filter).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateFilter, filterType));
+
+        // Lists longer than two items are sent without them in this session
+        filter.openPropertySession(2);
+
+        const sampling = filter.properties.get('sampling') as osn.IListProperty;
+        expect(sampling).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.Properties, filterType));
+
+        const itemCount = sampling.details.itemCount;
+        expect(itemCount).to.be.above(2, GetErrorMessage(ETestErrorMsg.ListItems, 'sampling', filterType));
+
+        // Getting the first two items
+        const page = sampling.listItems(0, 2);
+        expect(page.total).to.equal(itemCount, GetErrorMessage(ETestErrorMsg.ListItems, 'sampling', filterType));
+        expect(page.items.length).to.equal(Math.min(2, itemCount), GetErrorMessage(ETestErrorMsg.ListItems, 'sampling', filterType));
+
+        // Filtering items by name
+        const filtered = sampling.listItems(0, itemCount, 'bi');
+        filtered.items.forEach(function(item) {
+            expect(item.name.toLowerCase()).to.include('bi', GetErrorMessage(ETestErrorMsg.ListItems, 'sampling', filterType));
+        });
+
+        // Loading the deferred items
+        expect(sampling.details.items.length).to.equal(itemCount, GetErrorMessage(ETestErrorMsg.ListItems, 'sampling', filterType));
+
+        // Details are shared between reads and can't be edited
+        expect(Object.isFrozen(sampling.details)).to.equal(true, GetErrorMessage(ETestErrorMsg.ListItems, 'sampling', filterType));
+        expect(Object.isFrozen(sampling.details.items[0])).to.equal(true, GetErrorMessage(ETestErrorMsg.ListItems, 'sampling', filterType));
+
+        filter.closePropertySession();
+
+        filter.release();
+    });
+
     it('Set enabled and get it for all filter types', () => {
         obs.filterTypes.forEach(function(filterType) {
             // Creating filter
@@ -6,7 +6,7 @@ import { IScene, ITransition, ISettings, ISource } from '../osn';
 import { OBSHandler } from '../util/obs_handler';
 import { deleteConfigFiles } from '../util/general';
 import * as transitionSettings from '../util/transition_settings';
-import { EOBSTransitionTypes } from '../util/obs_enums';
+import { EOBSInputTypes, EOBSTransitionTypes } from '../util/obs_enums';
 import { ETestErrorMsg, GetErrorMessage } from '../util/error_messages';
 
 const testName = 'osn-transition';
@@ -133,6 +133,71 @@ describe(testName, () => {
         scene.release();         
     });
 
+    it('Prepare scene and start transition to it', async () => {
+        let transition: ITransition;
+        let scene: IScene;
+        let source: ISource;
+        let sceneName: string = 'test_osn_scene';
+
+        transition = osn.TransitionFactory.create(EOBSTransitionTypes.Cut, 'transition');
+
+        scene = osn.SceneFactory.create(sceneName);
+
+        const input = osn.InputFactory.create(EOBSInputTypes.ColorSource, 'prepare_color', {width: 100, height: 100});
+        expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.ColorSource));
+        const sceneItem = scene.add(input);
+
+        // Readiness arrives through the global callback poll
+        osn.NodeObs.RegisterSourceCallback(() => {});
+
+        const readiness = await new Promise<osn.ITransitionReadiness>(resolve => {
+            transition.prepare(scene, 1000, resolve);
+        });
+        expect(readiness.state).to.equal(osn.ETransitionReadiness.Ready, GetErrorMessage(ETestErrorMsg.TransitionReadiness, EOBSTransitionTypes.Cut));
+        expect(readiness.total).to.equal(1, GetErrorMessage(ETestErrorMsg.TransitionReadiness, EOBSTransitionTypes.Cut));
+        expect(readiness.ready).to.equal(readiness.total, GetErrorMessage(ETestErrorMsg.TransitionReadiness, EOBSTransitionTypes.Cut));
+
+        osn.NodeObs.RemoveSourceCallback();
+
+        transition.start(0,scene);
+        source = transition.getActiveSource();
+        expect(source).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.GetActiveSource, EOBSTransitionTypes.Cut));
+        expect(source.name).to.equal(sceneName, GetErrorMessage(ETestErrorMsg.SceneName, sceneName));
+
+        transition.release();
+        sceneItem.remove();
+        input.release();
+        scene.release();
+    });
+
+    it('Start a transition before its preparation resolved', async () => {
+        const sceneName = 'test_osn_prepare_start';
+        const transition = osn.TransitionFactory.create(EOBSTransitionTypes.Cut, 'transition');
+        const scene = osn.SceneFactory.create(sceneName);
+
+        const input = osn.InputFactory.create(EOBSInputTypes.ColorSource, 'prepare_start_color', {width: 100, height: 100});
+        expect(input).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.CreateInput, EOBSInputTypes.ColorSource));
+        const sceneItem = scene.add(input);
+
+        osn.NodeObs.RegisterSourceCallback(() => {});
+
+        // Starting right away ends the preparation, the callback still fires once
+        const outcome = new Promise<osn.ITransitionReadiness>(resolve => {
+            transition.prepare(scene, 10000, resolve);
+        });
+        transition.start(0, scene);
+
+        const readiness = await outcome;
+        expect(readiness.state).to.be.oneOf([osn.ETransitionReadiness.Cancelled, osn.ETransitionReadiness.Ready], GetErrorMessage(ETestErrorMsg.TransitionReadiness, EOBSTransitionTypes.Cut));
+
+        osn.NodeObs.RemoveSourceCallback();
+
+        transition.release();
+        sceneItem.remove();
+        input.release();
+        scene.release();
+    });
+
     it('Fail test - Try to get source from transition without setting in to transition', () => {
         let source: ISource;
         let transition: ITransition;
@@ -57,4 +57,31 @@ describe(testName, () => {
         expect(totalFrames).to.not.equal(undefined,  GetErrorMessage(ETestErrorMsg.VideoTotalFrames));
         expect(totalFrames).to.equal(0,  GetErrorMessage(ETestErrorMsg.VideoTotalFramesWrongValue));
     });
+
+    it('Get frame stats', () => {
+        // Getting frame statistics from the shared stats page
+        const frameStats = osn.Video.frameStats;
+
+        // Checking if frame stats were returned and agree with the single counters
+        expect(frameStats).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.VideoFrameStats));
+        expect(frameStats.encodedFrames).to.equal(osn.Video.encodedFrames, GetErrorMessage(ETestErrorMsg.VideoFrameStatsWrongValue));
+        expect(frameStats.skippedFrames).to.equal(osn.Video.skippedFrames, GetErrorMessage(ETestErrorMsg.VideoFrameStatsWrongValue));
+    });
+
+    it('Get render timing', () => {
+        // Getting render timing since startup, starting a new period
+        const timing = osn.Video.getRenderTiming(true);
+
+        // Checking if the distribution was returned and is ordered
+        expect(timing).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.VideoRenderTiming));
+        expect(timing.p50).to.be.at.most(timing.p95, GetErrorMessage(ETestErrorMsg.VideoRenderTimingWrongValue));
+        expect(timing.p95).to.be.at.most(timing.p99, GetErrorMessage(ETestErrorMsg.VideoRenderTimingWrongValue));
+        expect(timing.p99).to.be.at.most(timing.max, GetErrorMessage(ETestErrorMsg.VideoRenderTimingWrongValue));
+        expect(timing.overBudgetFrames).to.be.at.most(timing.frames, GetErrorMessage(ETestErrorMsg.VideoRenderTimingWrongValue));
+
+        // Getting render timing of the last ten seconds
+        const window = osn.Video.getRenderTimingWindow(10);
+        expect(window).to.not.equal(undefined, GetErrorMessage(ETestErrorMsg.VideoRenderTiming));
+        expect(window.duration).to.be.at.most(10000, GetErrorMessage(ETestErrorMsg.VideoRenderTimingWrongValue));
+    });
 });
@@ -78,6 +78,7 @@ export const enum ETestErrorMsg {
     InputName = 'Input %VALUE1% name value is wrong',
     InputSetting = 'Failed to update one or more settings of input %VALUE1%',
     InputFromName = 'Failed to get input from name %VALUE1%',
+    InputTypeCatalog = 'Input type catalog entry %VALUE1% does not match the registered type',
     FromNameInputName = 'Input returned from name %VALUE% has wrong name',
     FromNameInputId = 'Input returned from name %VALUE1% has wrong id',
     Volume = 'Failed to update volume of input %VALUE1%',
@@ -138,6 +139,11 @@ export const enum ETestErrorMsg {
     SourceName = 'Failed to get name of source %VALUE1%',
     Configurable = 'Failed to get configurable value of source %VALUE1%',
     Properties = 'Failed to get properties values of source %VALUE1%',
+    PropertyModified = 'Failed to notify property %VALUE1% of source %VALUE2% as modified',
+    PropertyValue = 'Property %VALUE1% of source %VALUE2% has wrong value after modification',
+    ListItems = 'Failed to page through items of list property %VALUE1% of source %VALUE2%',
+    PropertyIteration = 'Failed to iterate over properties of source %VALUE1%',
+    CallbackPayloads = 'Failed to convert %VALUE1% callback payloads',
     Settings = 'Failed to get settings of source %VALUE1%',
     OutputFlags = 'Failed to get output flags of source %VALUE1%',
     SaveSettings = 'Failed to save settings of source %VALUE1%',
@@ -154,11 +160,16 @@ export const enum ETestErrorMsg {
     TransitionName = 'Transition %VALUE1% name value is wrong',
     TransitionSetting = 'Transition %VALUE1% setting is wrong',
     GetActiveSource = 'Failed to get active source from transition %VALUE1%',
+    TransitionReadiness = 'Transition %VALUE1% did not report the prepared scene as ready',
     // osn-video
     VideoSkippedFrames = 'Failed to get video skipped frames',
     VideoSkippedFramesWrongValue = 'Returned video skipped frames value is wrong',
     VideoTotalFrames = 'Failed to get video total frames',
     VideoTotalFramesWrongValue = 'Returned video totral frames value is wrong',
+    VideoFrameStats = 'Failed to get video frame stats',
+    VideoFrameStatsWrongValue = 'Returned video frame stats do not match the frame counters',
+    VideoRenderTiming = 'Failed to get video render timing',
+    VideoRenderTimingWrongValue = 'Returned video render timing is not consistent',
     // osn-volmeter
     CreateVolmeter = 'Failed to create volmeter',
     VolmeterCallback = 'Failed to add callback to volmeter',